@@ -6,11 +6,36 @@ uniform float time; // Used for texture animation
 
 varying VTYPE VNAME ;
 
+// Extra arguments after the coordinate, like the period and rotation
+// of psrdnoise, starting with a comma
+#ifndef NOISEARGS
+#define NOISEARGS
+#endif
+
+// Sum of all components of a noise function's result, so that none of
+// them can be optimised away, whatever the return type
+float consume(float n) { return n; }
+float consume(vec2 n) { return n.x + n.y; }
+float consume(vec3 n) { return n.x + n.y + n.z; }
+float consume(vec4 n) { return n.x + n.y + n.z + n.w; }
+
 //
 // main()
 //
 void main( void )
 {
-  float n = NOISEFUN(VNAME);
+#ifdef GRADTYPE
+  // Functions with an "out" gradient argument, like noise3Dgrad.glsl
+  GRADTYPE gradient;
+  float n = consume(NOISEFUN(VNAME NOISEARGS, gradient)) + consume(gradient);
+#elif defined(PACKED4)
+  // Functions of four points in the components of vec4s, like snoise4x()
+  // in noise2D.glsl, at four taps 1/64 apart around the coordinate
+  const vec4 dx = vec4(0.0, 0.015625, 0.0, 0.015625);
+  const vec4 dy = vec4(0.0, 0.0, 0.015625, 0.015625);
+  float n = consume(NOISEFUN(VNAME.xxxx + dx, VNAME.yyyy + dy NOISEARGS));
+#else
+  float n = consume(NOISEFUN(VNAME NOISEARGS));
+#endif
   gl_FragColor = vec4(vec3(n * 0.5 + 0.5), 1.0);
 }
@@ -1,5 +1,17 @@
+// Build with -DHEADLESS for an offscreen context from EGL (Mesa's
+// surfaceless platform, e.g. llvmpipe), rendering into a framebuffer
+// object instead of a window. No GLUT, GLEW or X server is needed then.
+#ifdef HEADLESS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <time.h>
+#else
 #include <GL/glew.h>
 #include <GL/freeglut.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,16 +25,150 @@
 #define FRAGSHADERFILE_C2D "classicnoise2D.frag"
 #define FRAGSHADERFILE_C3D "classicnoise3D.frag"
 #define FRAGSHADERFILE_C4D "classicnoise4D.frag"
+#define FRAGSHADERFILE_S3DG "simplexnoise3Dgrad.frag"
+#define FRAGSHADERFILE_W2D "cellular2D.frag"
+#define FRAGSHADERFILE_W2X2 "cellular2x2.frag"
+#define FRAGSHADERFILE_W3D "cellular3D.frag"
+#define FRAGSHADERFILE_W2X2X2 "cellular2x2x2.frag"
+#define FRAGSHADERFILE_PSRD "psrdnoise2D.frag"
+#define FRAGSHADERFILE_PSD "psdnoise2D.frag"
+#define FRAGSHADERFILE_PSR "psrnoise2D.frag"
+#define FRAGSHADERFILE_PS "psnoise2D.frag"
+#define FRAGSHADERFILE_SRD "srdnoise2D.frag"
+#define FRAGSHADERFILE_SD "sdnoise2D.frag"
+#define FRAGSHADERFILE_SR "srnoise2D.frag"
+#define FRAGSHADERFILE_S "snoise2D.frag"
+#define FRAGSHADERFILE_FBM "fbm3D.frag"
+#define FRAGSHADERFILE_PS3D "psnoise3D.frag"
+#define FRAGSHADERFILE_PS4D "psnoise4D.frag"
+#define FRAGSHADERFILE_PSRD3D "psrdnoise3D.frag"
+#define FRAGSHADERFILE_PSR3D "psrnoise3D.frag"
+#define FRAGSHADERFILE_C2DG "classicnoise2Dgrad.frag"
+#define FRAGSHADERFILE_C3DG "classicnoise3Dgrad.frag"
+#define FRAGSHADERFILE_C4DG "classicnoise4Dgrad.frag"
+#define FRAGSHADERFILE_S4DG "simplexnoise4Dgrad.frag"
+#define FRAGSHADERFILE_CURL3D "curlnoise3D.frag"
+#define FRAGSHADERFILE_S3DV "simplexnoise3Dv.frag"
+#define FRAGSHADERFILE_S4DV "simplexnoise4Dv.frag"
+#define FRAGSHADERFILE_S2DX4 "simplexnoise2Dx4.frag"
+#define FRAGSHADERFILE_S2DU "simplexnoise2Duint.frag"
+#define FRAGSHADERFILE_S3DU "simplexnoise3Duint.frag"
+#define FRAGSHADERFILE_S4DU "simplexnoise4Duint.frag"
+#define FRAGSHADERFILE_C2DU "classicnoise2Duint.frag"
+#define FRAGSHADERFILE_C3DU "classicnoise3Duint.frag"
+#define FRAGSHADERFILE_C4DU "classicnoise4Duint.frag"
+#define FRAGSHADERFILE_W2DU "cellular2Duint.frag"
+#define FRAGSHADERFILE_W2X2U "cellular2x2uint.frag"
+#define FRAGSHADERFILE_W3DU "cellular3Duint.frag"
+#define FRAGSHADERFILE_W2X2X2U "cellular2x2x2uint.frag"
+#define FRAGSHADERFILE_M3D "multinoise3D.frag"
+#define FRAGSHADERFILE_V2D "cellularvoronoi2D.frag"
+#define FRAGSHADERFILE_V3D "cellularvoronoi3D.frag"
+#define FRAGSHADERFILE_V2DU "cellularvoronoi2Duint.frag"
+#define FRAGSHADERFILE_V3DU "cellularvoronoi3Duint.frag"
+#define FRAGSHADERFILE_FBMLOOP "fbm3Dloop.frag"
+#define FRAGSHADERFILE_FBMSEP "fbm3Dseparate.frag"
 #define FRAGSHADERFILE_CONST "constant.frag"
 #define LOGFILENAME "ashimanoise.log"
+#define CSVFILENAME "ashimanoise.csv"
+#define JSONFILENAME "ashimanoise.json"
+
+// A shader and the number of noise samples it evaluates per pixel
+typedef struct {
+    const char *file;
+    int samples;
+} Shader;
+
+// The shaders in the order they are benchmarked. fbm3D.frag and its
+// variants count as one sample per pixel, although they evaluate 6
+// octaves of noise, as the sample is the fbm() sum.
+const Shader shaders[] = {
+    { FRAGSHADERFILE_CONST, 1 },
+    { FRAGSHADERFILE_S2D, 1 },
+    { FRAGSHADERFILE_S3D, 1 },
+    { FRAGSHADERFILE_S4D, 1 },
+    { FRAGSHADERFILE_C2D, 1 },
+    { FRAGSHADERFILE_C3D, 1 },
+    { FRAGSHADERFILE_C4D, 1 },
+    { FRAGSHADERFILE_S3DG, 1 },
+    { FRAGSHADERFILE_W2D, 1 },
+    { FRAGSHADERFILE_W2X2, 1 },
+    { FRAGSHADERFILE_W3D, 1 },
+    { FRAGSHADERFILE_W2X2X2, 1 },
+    { FRAGSHADERFILE_PSRD, 1 },
+    { FRAGSHADERFILE_PSD, 1 },
+    { FRAGSHADERFILE_PSR, 1 },
+    { FRAGSHADERFILE_PS, 1 },
+    { FRAGSHADERFILE_SRD, 1 },
+    { FRAGSHADERFILE_SD, 1 },
+    { FRAGSHADERFILE_SR, 1 },
+    { FRAGSHADERFILE_S, 1 },
+    { FRAGSHADERFILE_FBM, 1 },
+    { FRAGSHADERFILE_PS3D, 1 },
+    { FRAGSHADERFILE_PS4D, 1 },
+    { FRAGSHADERFILE_PSRD3D, 1 },
+    { FRAGSHADERFILE_PSR3D, 1 },
+    { FRAGSHADERFILE_C2DG, 1 },
+    { FRAGSHADERFILE_C3DG, 1 },
+    { FRAGSHADERFILE_C4DG, 1 },
+    { FRAGSHADERFILE_S4DG, 1 },
+    { FRAGSHADERFILE_CURL3D, 1 },
+    { FRAGSHADERFILE_S3DV, 1 },
+    { FRAGSHADERFILE_S4DV, 1 },
+    { FRAGSHADERFILE_S2DX4, 4 },
+    { FRAGSHADERFILE_S2DU, 1 },
+    { FRAGSHADERFILE_S3DU, 1 },
+    { FRAGSHADERFILE_S4DU, 1 },
+    { FRAGSHADERFILE_C2DU, 1 },
+    { FRAGSHADERFILE_C3DU, 1 },
+    { FRAGSHADERFILE_C4DU, 1 },
+    { FRAGSHADERFILE_W2DU, 1 },
+    { FRAGSHADERFILE_W2X2U, 1 },
+    { FRAGSHADERFILE_W3DU, 1 },
+    { FRAGSHADERFILE_W2X2X2U, 1 },
+    { FRAGSHADERFILE_M3D, 1 },
+    { FRAGSHADERFILE_V2D, 1 },
+    { FRAGSHADERFILE_V3D, 1 },
+    { FRAGSHADERFILE_V2DU, 1 },
+    { FRAGSHADERFILE_V3DU, 1 },
+    { FRAGSHADERFILE_FBMLOOP, 1 },
+    { FRAGSHADERFILE_FBMSEP, 1 }
+};
+#define NUMSHADERS (int)(sizeof(shaders) / sizeof(shaders[0]))
+
+// Measurements for one shader. Frame times are in seconds.
+typedef struct {
+    int failed;        // The shader did not compile or link, and was skipped
+    int frames;        // Frames rendered after the warm-up
+    double seconds;    // Time taken by those frames
+    double median;     // Median frame time
+    double p95;        // 95th percentile frame time
+} Result;
 
 GLuint displayList;
 GLuint programObject;
 int windowWidth = 800, windowHeight = 600;
 int activeshader = 0;
-FILE *logfile = nullptr;
+FILE *logfile = NULL;
 double benchmarkStartTime = 0.0;
 double benchmarkDuration = 3.0;
+double warmupDuration = 0.5; // Not measured: shader compilation, caches, clocks
+
+Result results[NUMSHADERS];
+double *frameTimes = NULL; // Of the active shader
+int frames = 0, maxFrames = 0;
+double lastFrameTime = 0.0;
+
+// Time in seconds
+double getTime() {
+#ifdef HEADLESS
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return glutGet(GLUT_ELAPSED_TIME) / 1000.0;
+#endif
+}
 
 // Function to print errors
 void printError(const char *errtype, const char *errmsg) {
@@ -34,7 +180,7 @@ unsigned char *readShaderFile(const char *filename) {
     FILE *file = fopen(filename, "r");
     if (!file) {
         printError("ERROR", "Cannot open shader file!");
-        return nullptr;
+        return NULL;
     }
 
     fseek(file, 0, SEEK_END);
@@ -49,40 +195,49 @@ unsigned char *readShaderFile(const char *filename) {
     return buffer;
 }
 
-// Create shaders
-void createShader(GLuint *programObject, const char *vertexshaderfile, const char *fragmentshaderfile) {
+// Create shaders. Returns 0 if they do not compile or link, and then
+// leaves *programObject at 0.
+int createShader(GLuint *programObject, const char *vertexshaderfile, const char *fragmentshaderfile) {
     GLuint vertexShader, fragmentShader;
     GLint compiled, linked;
     char log[4096];
 
+    *programObject = 0;
+
     // Vertex shader
-    vertexShader = glCreateShader(GL_VERTEX_SHADER);
     unsigned char *vertexSource = readShaderFile(vertexshaderfile);
-    if (!vertexSource) return;
-    glShaderSource(vertexShader, 1, (const char **)&vertexSource, nullptr);
+    if (!vertexSource) return 0;
+    vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, (const char **)&vertexSource, NULL);
     glCompileShader(vertexShader);
     free(vertexSource);
 
     glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &compiled);
     if (!compiled) {
-        glGetShaderInfoLog(vertexShader, sizeof(log), nullptr, log);
+        glGetShaderInfoLog(vertexShader, sizeof(log), NULL, log);
         printError("Vertex Shader Error", log);
-        return;
+        glDeleteShader(vertexShader);
+        return 0;
     }
 
     // Fragment shader
-    fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
     unsigned char *fragmentSource = readShaderFile(fragmentshaderfile);
-    if (!fragmentSource) return;
-    glShaderSource(fragmentShader, 1, (const char **)&fragmentSource, nullptr);
+    if (!fragmentSource) {
+        glDeleteShader(vertexShader);
+        return 0;
+    }
+    fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, (const char **)&fragmentSource, NULL);
     glCompileShader(fragmentShader);
     free(fragmentSource);
 
     glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &compiled);
     if (!compiled) {
-        glGetShaderInfoLog(fragmentShader, sizeof(log), nullptr, log);
+        glGetShaderInfoLog(fragmentShader, sizeof(log), NULL, log);
         printError("Fragment Shader Error", log);
-        return;
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
     }
 
     // Program object
@@ -93,12 +248,15 @@ void createShader(GLuint *programObject, const char *vertexshaderfile, const cha
 
     glGetProgramiv(*programObject, GL_LINK_STATUS, &linked);
     if (!linked) {
-        glGetProgramInfoLog(*programObject, sizeof(log), nullptr, log);
+        glGetProgramInfoLog(*programObject, sizeof(log), NULL, log);
         printError("Program Linking Error", log);
+        glDeleteProgram(*programObject);
+        *programObject = 0;
     }
 
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
+    return linked;
 }
 
 // Display list for rendering
@@ -114,43 +272,194 @@ void initDisplayList() {
     glEndList();
 }
 
+int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+// Write a string to a JSON file, in quotes, escaping what needs it
+void writeJsonString(FILE *json, const char *s) {
+    fputc('"', json);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fprintf(json, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20)
+            fprintf(json, "\\u%04x", (unsigned char)*s);
+        else
+            fputc(*s, json);
+    }
+    fputc('"', json);
+}
+
+// Pixels per frame. Multiply by the samples per pixel of a shader to get
+// its number of noise samples per frame.
+double pixelsPerFrame() {
+    return (double)windowWidth * windowHeight;
+}
+
+// Write the results of all shaders: a table to the log file, which is
+// also printed, and the raw numbers as CSV and JSON. Noise shaders are
+// compared to the first one, constant.frag, which does everything
+// except evaluating noise, to get the cost per noise sample. Shaders
+// that failed to build are listed with the status "failed" and no
+// numbers, and so are all the numbers per sample if constant.frag failed.
+void writeResults() {
+    const char *renderer = (const char *)glGetString(GL_RENDERER);
+    const char *version = (const char *)glGetString(GL_VERSION);
+    double pixels = pixelsPerFrame();
+    FILE *csv = fopen(CSVFILENAME, "w");
+    FILE *json = fopen(JSONFILENAME, "w");
+    logfile = fopen(LOGFILENAME, "w");
+    if (!logfile || !csv || !json) {
+        printError("ERROR", "Cannot write the benchmark results!");
+        exit(1);
+    }
+
+    fprintf(logfile, "GL_RENDERER: %s\nGL_VERSION: %s\n", renderer, version);
+    fprintf(logfile, "%d x %d pixels, %.1f s per shader after %.1f s warm-up\n\n",
+            windowWidth, windowHeight, benchmarkDuration, warmupDuration);
+    fprintf(logfile, "%-22s %7s %9s %9s %9s %11s %11s\n", "shader", "frames",
+            "median ms", "p95 ms", "Mpix/s", "Msamples/s", "ns/sample");
+    fprintf(csv, "shader,status,samples_per_pixel,frames,seconds,median_ms,p95_ms,"
+                 "mpixels_per_s,msamples_per_s,noise_ns_per_sample\n");
+    fprintf(json, "{\n  \"renderer\": ");
+    writeJsonString(json, renderer);
+    fprintf(json, ",\n  \"version\": ");
+    writeJsonString(json, version);
+    fprintf(json, ",\n");
+    fprintf(json, "  \"width\": %d,\n  \"height\": %d,\n", windowWidth, windowHeight);
+    fprintf(json, "  \"warmup_s\": %g,\n  \"duration_s\": %g,\n  \"shaders\": [\n",
+            warmupDuration, benchmarkDuration);
+
+    for (int i = 0; i < NUMSHADERS; i++) {
+        Result *r = &results[i];
+        const char *comma = i + 1 < NUMSHADERS ? "," : "";
+        if (r->failed) {
+            fprintf(logfile, "%-22s FAILED\n", shaders[i].file);
+            fprintf(csv, "%s,failed,%d,,,,,,,\n", shaders[i].file, shaders[i].samples);
+            fprintf(json, "    { \"shader\": ");
+            writeJsonString(json, shaders[i].file);
+            fprintf(json, ", \"status\": \"failed\", \"samples_per_pixel\": %d }%s\n",
+                    shaders[i].samples, comma);
+            continue;
+        }
+        double mpix = r->frames * pixels / r->seconds * 1e-6;
+        // Time spent on noise per sample, over that of constant.frag,
+        // and the rate of noise samples that gives
+        double noise = (r->median - results[0].median) / (pixels * shaders[i].samples) * 1e9;
+        double msamples = noise > 0.0 ? 1e3 / noise : 0.0;
+        fprintf(logfile, "%-22s %7d %9.3f %9.3f %9.2f", shaders[i].file, r->frames,
+                r->median * 1e3, r->p95 * 1e3, mpix);
+        fprintf(csv, "%s,ok,%d,%d,%.6f,%.6f,%.6f,%.6f,", shaders[i].file,
+                shaders[i].samples, r->frames, r->seconds, r->median * 1e3, r->p95 * 1e3, mpix);
+        fprintf(json, "    { \"shader\": ");
+        writeJsonString(json, shaders[i].file);
+        fprintf(json, ", \"status\": \"ok\", \"samples_per_pixel\": %d, \"frames\": %d, "
+                      "\"seconds\": %.6f, \"median_ms\": %.6f, \"p95_ms\": %.6f, "
+                      "\"mpixels_per_s\": %.6f, ",
+                shaders[i].samples, r->frames, r->seconds, r->median * 1e3, r->p95 * 1e3, mpix);
+        if (results[0].failed) {
+            fprintf(logfile, " %11s %11s\n", "-", "-");
+            fprintf(csv, ",\n");
+            fprintf(json, "\"msamples_per_s\": null, \"noise_ns_per_sample\": null }%s\n",
+                    comma);
+        } else {
+            fprintf(logfile, " %11.2f %11.3f\n", msamples, noise);
+            fprintf(csv, "%.6f,%.6f\n", msamples, noise);
+            fprintf(json, "\"msamples_per_s\": %.6f, \"noise_ns_per_sample\": %.6f }%s\n",
+                    msamples, noise, comma);
+        }
+    }
+    fprintf(json, "  ]\n}\n");
+
+    fclose(csv);
+    fclose(json);
+    fclose(logfile);
+}
+
+// Compute the result for the active shader from its frame times
+void finishShader() {
+    Result *r = &results[activeshader];
+    r->frames = frames;
+    r->seconds = 0.0;
+    for (int i = 0; i < frames; i++)
+        r->seconds += frameTimes[i];
+    qsort(frameTimes, frames, sizeof(double), compareDoubles);
+    r->median = frames > 0 ? frameTimes[frames / 2] : 0.0;
+    r->p95 = frames > 0 ? frameTimes[(int)(frames * 0.95)] : 0.0;
+    printf("%-22s %7d frames, median %.3f ms, p95 %.3f ms\n", shaders[activeshader].file,
+           r->frames, r->median * 1e3, r->p95 * 1e3);
+    fflush(stdout);
+}
+
+// Build the active shader, or if it fails, mark it as failed and go on
+// to the next one. After the last shader, write the results and exit,
+// with status 1 if any shader failed.
+void startShader() {
+    for (; activeshader < NUMSHADERS; activeshader++) {
+        if (createShader(&programObject, VERTSHADERFILE, shaders[activeshader].file))
+            break;
+        results[activeshader].failed = 1;
+        printf("%-22s FAILED\n", shaders[activeshader].file);
+        fflush(stdout);
+    }
+    if (activeshader >= NUMSHADERS) {
+        int failed = 0;
+        writeResults();
+        for (int i = 0; i < NUMSHADERS; i++)
+            failed |= results[i].failed;
+        exit(failed);
+    }
+    frames = 0;
+    benchmarkStartTime = lastFrameTime = getTime();
+}
+
+// Switch to the next shader
+void nextShader() {
+    finishShader();
+    glDeleteProgram(programObject);
+    activeshader++;
+    startShader();
+}
+
+// Record the time of a frame, unless still warming up
+void frameDone() {
+    double now = getTime();
+    if (now - benchmarkStartTime > warmupDuration) {
+        if (frames == maxFrames) {
+            maxFrames = maxFrames ? 2 * maxFrames : 1024;
+            frameTimes = (double *)realloc(frameTimes, maxFrames * sizeof(double));
+        }
+        frameTimes[frames++] = now - lastFrameTime;
+    }
+    lastFrameTime = now;
+    if (now - benchmarkStartTime > warmupDuration + benchmarkDuration)
+        nextShader();
+}
+
 // Render scene
 void renderScene() {
-    glClear(GL_COLOR_BUFFER_BIT);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glUseProgram(programObject);
     glCallList(displayList);
     glUseProgram(0);
+#ifdef HEADLESS
+    glFinish(); // Nothing to swap, but wait for the frame to be drawn
+#else
     glutSwapBuffers();
-}
-
-// Timer to switch shaders
-void timer(int value) {
-    double elapsed = glutGet(GLUT_ELAPSED_TIME) / 1000.0 - benchmarkStartTime;
-    if (elapsed > benchmarkDuration) {
-        activeshader++;
-        benchmarkStartTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0;
-
-        switch (activeshader) {
-            case 1: createShader(&programObject, VERTSHADERFILE, FRAGSHADERFILE_S2D); break;
-            case 2: createShader(&programObject, VERTSHADERFILE, FRAGSHADERFILE_S3D); break;
-            case 3: createShader(&programObject, VERTSHADERFILE, FRAGSHADERFILE_S4D); break;
-            case 4: createShader(&programObject, VERTSHADERFILE, FRAGSHADERFILE_C2D); break;
-            case 5: createShader(&programObject, VERTSHADERFILE, FRAGSHADERFILE_C3D); break;
-            case 6: createShader(&programObject, VERTSHADERFILE, FRAGSHADERFILE_C4D); break;
-            default: exit(0);
-        }
-    }
-
-    glutPostRedisplay();
-    glutTimerFunc(16, timer, 0);
+    glFinish(); // Time the drawing, not just the queueing of commands
+#endif
+    frameDone();
 }
 
 // Initialize OpenGL settings
 void initOpenGL() {
+#ifndef HEADLESS
     glewInit();
+#endif
     glEnable(GL_DEPTH_TEST);
     initDisplayList();
-    createShader(&programObject, VERTSHADERFILE, FRAGSHADERFILE_CONST);
+    startShader();
 }
 
 // Window resize handler
@@ -165,9 +474,85 @@ void reshape(int width, int height) {
     glLoadIdentity();
 }
 
-// Main function
+#ifdef HEADLESS
+// Create an OpenGL compatibility context without any surface, and a
+// framebuffer object of the window size to render into
+void initHeadless() {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    EGLDisplay display = EGL_NO_DISPLAY;
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+        printError("ERROR", "Cannot open the EGL surfaceless platform!");
+        exit(1);
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    EGLContext context = EGL_NO_CONTEXT;
+    if (eglBindAPI(EGL_OPENGL_API)
+        && eglChooseConfig(display, configAttribs, &config, 1, &numConfigs)
+        && numConfigs > 0)
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT
+        || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        printError("ERROR", "Cannot create an OpenGL context!");
+        exit(1);
+    }
+
+    GLuint framebuffer, renderbuffers[2];
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(2, renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, windowWidth, windowHeight);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, windowWidth, windowHeight);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        printError("ERROR", "Cannot create the framebuffer object!");
+        exit(1);
+    }
+
+    printf("Renderer: %s\n", (const char *)glGetString(GL_RENDERER));
+}
+
+// Main function. The optional argument is the time per shader in seconds.
+int main(int argc, char **argv) {
+    if (argc > 1)
+        benchmarkDuration = atof(argv[1]);
+    initHeadless();
+    initOpenGL();
+    reshape(windowWidth, windowHeight);
+
+    benchmarkStartTime = lastFrameTime = getTime();
+    for (;;)
+        renderScene();
+    return 0;
+}
+#else
+// Draw frames as fast as possible. (Turn off vsync in the driver for
+// meaningful numbers.)
+void idle() {
+    glutPostRedisplay();
+}
+
+// Main function. The optional argument is the time per shader in seconds.
 int main(int argc, char **argv) {
     glutInit(&argc, argv);
+    if (argc > 1)
+        benchmarkDuration = atof(argv[1]);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA | GLUT_DEPTH);
     glutInitWindowSize(windowWidth, windowHeight);
     glutCreateWindow("GLSL Noise Benchmark");
@@ -176,8 +561,10 @@ int main(int argc, char **argv) {
 
     glutDisplayFunc(renderScene);
     glutReshapeFunc(reshape);
-    glutTimerFunc(0, timer, 0);
+    glutIdleFunc(idle);
 
+    benchmarkStartTime = lastFrameTime = getTime();
     glutMainLoop();
     return 0;
 }
+#endif
@@ -0,0 +1,47 @@
+//
+// Description : Scratch buffers for the CPU noise kernels, with a type
+//               of their own in each instruction set's build.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// The kernels are compiled once per instruction set. A std::vector<float>
+// in them would have its out-of-line members, like the ones that grow it,
+// emitted in every build, with the same names: the linker keeps one of
+// them, which may be an AVX one, and a CPU without AVX would then crash
+// in it. With an allocator declared in the namespace of the build, the
+// vectors are different types in each, and nothing is shared.
+//
+
+#ifndef WEBGLNOISE_BUFFER_H
+#define WEBGLNOISE_BUFFER_H
+
+#include <stddef.h>
+#include <new>
+#include <vector>
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+template <class T>
+struct Allocator {
+    typedef T value_type;
+    Allocator() {}
+    template <class U> Allocator(const Allocator<U> &) {}
+    T *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T))); }
+    void deallocate(T *p, size_t) { ::operator delete(p); }
+};
+
+template <class T, class U>
+bool operator==(const Allocator<T> &, const Allocator<U> &) { return true; }
+template <class T, class U>
+bool operator!=(const Allocator<T> &, const Allocator<U> &) { return false; }
+
+template <class T>
+using Buffer = std::vector<T, Allocator<T>>;
+
+}
+}
+
+#endif
@@ -0,0 +1,151 @@
+//
+// Description : C++ port of the GLSL cellular noise functions
+//               cellular(), pcellular() and cellular_voronoi() in
+//               ../src/cellular2D.glsl.
+//      Author : Stefan Gustavson (stefan.gustavson@liu.se)
+//     License : Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+//               Distributed under the MIT license. See LICENSE file.
+//               https://github.com/stegu/webgl-noise
+//
+// The shaders handle the feature points in vec3 or vec4 groups and then
+// sort out F1 and F2 with a min/max network over the groups. With one
+// point per lane, every feature point is a V of its own, and the same
+// min/max network becomes a running one: F2 = min(F2, max(F1, d)),
+// F1 = min(F1, d). Both keep the two smallest of the same distances, so
+// the results are the same. The functions return squared distances;
+// the shaders' final sqrt() is left to the caller.
+//
+
+#ifndef WEBGLNOISE_CELLULAR2D_H
+#define WEBGLNOISE_CELLULAR2D_H
+
+#include "helpers.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Fold one squared distance into the two smallest so far
+template <class V>
+static inline void insert(V d, V &F1, V &F2) {
+    F2 = min(F2, max(F1, d));
+    F1 = min(F1, d);
+}
+
+// Feature point offset for a cell, from its hash value p
+template <class V>
+static inline void feature2(V p, V &ox, V &oy) {
+    const float K = 0.142857142857f;  // 1/7
+    const float Ko = 0.428571428571f; // 3/7
+    ox = fract(p * K) - Ko;
+    oy = mod7(floor(p * K)) * K - Ko;
+}
+
+// Cellular noise, 3x3 search region, squared F1 and F2, for the cells
+// in columns xi[0 .. 2] and rows yi[0 .. 2] around the point, given by
+// their lattice coordinates modulo 289. Cell (i, j) is at offset
+// (i - 1, j - 1) from the cell of the point, as px.x .. px.z and oi in
+// the shader.
+template <class V>
+static inline void cellular_cells(const V (&xi)[3], const V (&yi)[3], V Pfx, V Pfy,
+                                  V &F1, V &F2) {
+    const float jitter = 1.0f; // Less gives more regular pattern
+
+    F1 = F2 = V(1e30f);
+    for (int i = 0; i < 3; i++) {
+        V px = permute(xi[i]);
+        for (int j = 0; j < 3; j++) {
+            V ox, oy;
+            feature2(permute(px + yi[j]), ox, oy);
+            V dx = Pfx - (i - 0.5f) + jitter * ox;
+            V dy = Pfy - (j - 0.5f) + jitter * oy;
+            // dy * dy first, which with FMA contracts the same way as in
+            // gridcellular.h, where dy is the same in all lanes
+            insert(dy * dy + dx * dx, F1, F2);
+        }
+    }
+}
+
+// Cellular noise, 3x3 search region, squared F1 and F2
+template <class V>
+static inline void cellular(V Px, V Py, V &F1, V &F2) {
+    V Pix = mod289(floor(Px)), Piy = mod289(floor(Py));
+    V xi[3], yi[3];
+    for (int i = 0; i < 3; i++) {
+        xi[i] = Pix + (float)(i - 1);
+        yi[i] = Piy + (float)(i - 1);
+    }
+    cellular_cells(xi, yi, fract(Px), fract(Py), F1, F2);
+}
+
+// Periodic variant, with the lattice coordinates of the cells wrapped to
+// the periods repx and repy, whole numbers, before they are hashed
+template <class V>
+static inline void pcellular(V Px, V Py, V repx, V repy, V &F1, V &F2) {
+    V Pix = floor(Px), Piy = floor(Py);
+    V xi[3], yi[3];
+    for (int i = 0; i < 3; i++) {
+        xi[i] = mod289(mod(Pix + (float)(i - 1), repx));
+        yi[i] = mod289(mod(Piy + (float)(i - 1), repy));
+    }
+    cellular_cells(xi, yi, fract(Px), fract(Py), F1, F2);
+}
+
+// The distance from the point to the nearest edge of its Voronoi cell,
+// given the vectors (dx[c], dy[c]) from the n feature points to the point,
+// their squared distances d[c], the vector (ax, ay) of the nearest one
+// and F1. The edge with point c is the bisector of the two points, at
+// (d[c] - F1) / (2 |c - a|). The nearest point itself is skipped.
+template <class V, int n>
+static inline V voronoi_border(const V (&dx)[n], const V (&dy)[n], const V (&d)[n],
+                               V ax, V ay, V F1) {
+    V border = V(1e30f);
+    for (int c = 0; c < n; c++) {
+        V ex = dx[c] - ax, ey = dy[c] - ay;
+        V e = sqrt(ex * ex + ey * ey);
+        border = select(lessThan(V(0.0f), e), min(border, (d[c] - F1) / (e + e)), border);
+    }
+    return border;
+}
+
+// Cellular noise with the Voronoi cell of the point, from the same 3x3
+// search and distances as cellular(): squared F1 and F2, the hash id of
+// the cell of the nearest feature point, the vector (fx, fy) from the
+// point to it, and the distance to the nearest edge of the Voronoi cell,
+// among the feature points in the search region. The feature points are
+// kept for the edges, which take a second pass over them.
+template <class V>
+static inline void cellular_voronoi(V Px, V Py, V &F1, V &F2, V &id, V &fx, V &fy,
+                                    V &border) {
+    const float jitter = 1.0f; // As in cellular()
+
+    V Pix = mod289(floor(Px)), Piy = mod289(floor(Py));
+    V Pfx = fract(Px), Pfy = fract(Py);
+
+    V dx[9], dy[9], d[9];
+    V ax = V(0.0f), ay = V(0.0f);
+    F1 = F2 = id = V(1e30f);
+    for (int i = 0; i < 3; i++) {
+        V px = permute(Pix + (float)(i - 1));
+        for (int j = 0; j < 3; j++) {
+            int c = 3 * i + j;
+            V p = permute(px + Piy + (float)(j - 1)), ox, oy;
+            feature2(p, ox, oy);
+            dx[c] = Pfx - (i - 0.5f) + jitter * ox;
+            dy[c] = Pfy - (j - 0.5f) + jitter * oy;
+            d[c] = dy[c] * dy[c] + dx[c] * dx[c]; // As in cellular()
+            auto nearer = lessThan(d[c], F1);
+            ax = select(nearer, dx[c], ax);
+            ay = select(nearer, dy[c], ay);
+            id = select(nearer, p, id);
+            insert(d[c], F1, F2);
+        }
+    }
+    border = voronoi_border(dx, dy, d, ax, ay, F1);
+    fx = -ax;
+    fy = -ay;
+}
+
+}
+}
+
+#endif
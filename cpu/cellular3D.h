@@ -0,0 +1,273 @@
+//
+// Description : C++ port of the GLSL cellular noise functions
+//               cellular(), pcellular() and cellular_voronoi() in
+//               ../src/cellular3D.glsl and cellular2x2x2() in
+//               ../src/cellular2x2x2.glsl, with cellular_culled(), a
+//               faster search for the same result as cellular().
+//      Author : Stefan Gustavson (stefan.gustavson@liu.se)
+//     License : Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+//               Distributed under the MIT license. See LICENSE file.
+//               https://github.com/stegu/webgl-noise
+//
+// As in cellular2D.h, the min/max network of the shaders becomes a
+// running one, and the functions return squared distances.
+//
+
+#ifndef WEBGLNOISE_CELLULAR3D_H
+#define WEBGLNOISE_CELLULAR3D_H
+
+#include "cellular2D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Feature point offset for a cell, from its hash value p
+template <class V>
+static inline void feature3(V p, V &ox, V &oy, V &oz) {
+    const float K = 0.142857142857f;    // 1/7
+    const float Ko = 0.428571428571f;   // 1/2-K/2
+    const float K2 = 0.020408163265306f; // 1/(7*7)
+    const float Kz = 0.166666666667f;   // 1/6
+    const float Kzo = 0.416666666667f;  // 1/2-1/6*2
+    ox = fract(p * K) - Ko;
+    oy = mod7(floor(p * K)) * K - Ko;
+    oz = floor(p * K2) * Kz - Kzo; // p < 289 guaranteed
+}
+
+// Cellular noise, 3x3x3 search region, squared F1 and F2, for the cells
+// at lattice coordinates xi, yi, zi (modulo 289) around the point, as
+// cellular_cells() in cellular2D.h. Offsets 1, 0, -1 of the shader's Pfx,
+// Pfy and Pfz go with the cells -1, 0, 1 around Pi.
+template <class V>
+static inline void cellular_cells(const V (&xi)[3], const V (&yi)[3], const V (&zi)[3],
+                                  V Pfx, V Pfy, V Pfz, V &F1, V &F2) {
+    const float jitter = 1.0f; // smaller jitter gives more regular pattern
+
+    V p[3], p1[3][3];
+    for (int i = 0; i < 3; i++)
+        p[i] = permute(xi[i]);
+    for (int j = 0; j < 3; j++)
+        for (int i = 0; i < 3; i++)
+            p1[j][i] = permute(p[i] + yi[j]);
+
+    F1 = F2 = V(1e30f);
+    for (int k = 0; k < 3; k++)
+        for (int j = 0; j < 3; j++)
+            for (int i = 0; i < 3; i++) {
+                V ox, oy, oz;
+                feature3(permute(p1[j][i] + zi[k]), ox, oy, oz);
+                V dx = Pfx + (float)(1 - i) + jitter * ox;
+                V dy = Pfy + (float)(1 - j) + jitter * oy;
+                V dz = Pfz + (float)(1 - k) + jitter * oz;
+                insert(dx * dx + dy * dy + dz * dz, F1, F2);
+            }
+}
+
+// Cellular noise, 3x3x3 search region, squared F1 and F2
+template <class V>
+static inline void cellular(V Px, V Py, V Pz, V &F1, V &F2) {
+    V Pix = mod289(floor(Px)), Piy = mod289(floor(Py)), Piz = mod289(floor(Pz));
+    V xi[3], yi[3], zi[3];
+    for (int i = 0; i < 3; i++) {
+        xi[i] = Pix + (float)(i - 1);
+        yi[i] = Piy + (float)(i - 1);
+        zi[i] = Piz + (float)(i - 1);
+    }
+    cellular_cells(xi, yi, zi, fract(Px) - 0.5f, fract(Py) - 0.5f, fract(Pz) - 0.5f,
+                   F1, F2);
+}
+
+// Periodic variant, as pcellular() in cellular2D.h, searching all 27
+// cells
+template <class V>
+static inline void pcellular(V Px, V Py, V Pz, V repx, V repy, V repz, V &F1, V &F2) {
+    V Pix = floor(Px), Piy = floor(Py), Piz = floor(Pz);
+    V xi[3], yi[3], zi[3];
+    for (int i = 0; i < 3; i++) {
+        xi[i] = mod289(mod(Pix + (float)(i - 1), repx));
+        yi[i] = mod289(mod(Piy + (float)(i - 1), repy));
+        zi[i] = mod289(mod(Piz + (float)(i - 1), repz));
+    }
+    cellular_cells(xi, yi, zi, fract(Px) - 0.5f, fract(Py) - 0.5f, fract(Pz) - 0.5f,
+                   F1, F2);
+}
+
+// The same as cellular(), but faster, in particular for points that are
+// close together or with few lanes. The cells are visited nearest first:
+// the 8 on the near sides of the point along each axis, then those on
+// the far side along one, two and three axes. The point is at least
+// 1 - |Pf| - Ko from the box its feature point can be in along a near
+// side, and 1 + |Pf| - Ko along a far side. A group of far cells is
+// skipped, before hashing them, when their boxes are no nearer than F2
+// so far in any lane. Skipped cells would not have changed F1 or F2, so
+// the results are the same as from cellular(), bit for bit.
+template <class V>
+static inline void cellular_culled(V Px, V Py, V Pz, V &F1, V &F2) {
+    const float jitter = 1.0f; // As in cellular()
+    // Half the sides of the boxes of feature points around the cell
+    // centres (Ko and Kzo in feature3()), with a margin for rounding
+    const float exy = jitter * 0.428571428571f + 1e-5f;
+    const float ez = jitter * 0.416666666667f + 1e-5f;
+
+    V Pix = mod289(floor(Px)), Piy = mod289(floor(Py)), Piz = mod289(floor(Pz));
+    V Pfx = fract(Px) - 0.5f, Pfy = fract(Py) - 0.5f, Pfz = fract(Pz) - 0.5f;
+
+    // Lattice offsets of the cells m = 0 (the point's own), 1 (near side)
+    // and 2 (far side) along each axis
+    V sx = select(lessThan(Pfx, V(0.0f)), V(-1.0f), V(1.0f));
+    V sy = select(lessThan(Pfy, V(0.0f)), V(-1.0f), V(1.0f));
+    V sz = select(lessThan(Pfz, V(0.0f)), V(-1.0f), V(1.0f));
+    V ox[3] = { V(0.0f), sx, -sx }, oy[3] = { V(0.0f), sy, -sy }, oz[3] = { V(0.0f), sz, -sz };
+
+    // Squared distances from the point to the boxes along each axis, for
+    // the own cell (a lower bound for the near side too) and the far side
+    V bx[3], by[3], bz[3];
+    bx[0] = max(abs(Pfx) - exy, V(0.0f));
+    by[0] = max(abs(Pfy) - exy, V(0.0f));
+    bz[0] = max(abs(Pfz) - ez, V(0.0f));
+    bx[2] = abs(Pfx) + (1.0f - exy);
+    by[2] = abs(Pfy) + (1.0f - exy);
+    bz[2] = abs(Pfz) + (1.0f - ez);
+    for (int m = 0; m < 3; m += 2) {
+        bx[m] = bx[m] * bx[m];
+        by[m] = by[m] * by[m];
+        bz[m] = bz[m] * bz[m];
+    }
+
+    V p[3], p1[3][3];
+    for (int i = 0; i < 3; i++)
+        p[i] = permute(Pix + ox[i]);
+    for (int j = 0; j < 3; j++)
+        for (int i = 0; i < 3; i++)
+            p1[j][i] = permute(p[i] + Piy + oy[j]);
+
+    auto cell = [&](int i, int j, int k) {
+        V fx, fy, fz;
+        feature3(permute(p1[j][i] + Piz + oz[k]), fx, fy, fz);
+        V dx = Pfx - ox[i] + jitter * fx;
+        V dy = Pfy - oy[j] + jitter * fy;
+        V dz = Pfz - oz[k] + jitter * fz;
+        insert(dx * dx + dy * dy + dz * dz, F1, F2);
+    };
+    auto reachable = [&](V bound) { return any(lessThan(bound, F2)); };
+
+    F1 = F2 = V(1e30f);
+    for (int k = 0; k < 2; k++)
+        for (int j = 0; j < 2; j++)
+            for (int i = 0; i < 2; i++)
+                cell(i, j, k);
+    // One far side
+    if (reachable(bx[2] + by[0] + bz[0]))
+        for (int k = 0; k < 2; k++)
+            for (int j = 0; j < 2; j++)
+                cell(2, j, k);
+    if (reachable(bx[0] + by[2] + bz[0]))
+        for (int k = 0; k < 2; k++)
+            for (int i = 0; i < 2; i++)
+                cell(i, 2, k);
+    if (reachable(bx[0] + by[0] + bz[2]))
+        for (int j = 0; j < 2; j++)
+            for (int i = 0; i < 2; i++)
+                cell(i, j, 2);
+    // Two far sides
+    if (reachable(bx[2] + by[2] + bz[0]))
+        for (int k = 0; k < 2; k++)
+            cell(2, 2, k);
+    if (reachable(bx[2] + by[0] + bz[2]))
+        for (int j = 0; j < 2; j++)
+            cell(2, j, 2);
+    if (reachable(bx[0] + by[2] + bz[2]))
+        for (int i = 0; i < 2; i++)
+            cell(i, 2, 2);
+    // Three
+    if (reachable(bx[2] + by[2] + bz[2]))
+        cell(2, 2, 2);
+}
+
+// The distance to the nearest face of the Voronoi cell, as
+// voronoi_border() in cellular2D.h
+template <class V, int n>
+static inline V voronoi_border(const V (&dx)[n], const V (&dy)[n], const V (&dz)[n],
+                               const V (&d)[n], V ax, V ay, V az, V F1) {
+    V border = V(1e30f);
+    for (int c = 0; c < n; c++) {
+        V ex = dx[c] - ax, ey = dy[c] - ay, ez = dz[c] - az;
+        V e = sqrt(ex * ex + ey * ey + ez * ez);
+        border = select(lessThan(V(0.0f), e), min(border, (d[c] - F1) / (e + e)), border);
+    }
+    return border;
+}
+
+// Cellular noise with the Voronoi cell of the point, from the same
+// 3x3x3 search and distances as cellular(), as cellular_voronoi() in
+// cellular2D.h. All 27 cells are needed for the faces, so there is no
+// culling.
+template <class V>
+static inline void cellular_voronoi(V Px, V Py, V Pz, V &F1, V &F2, V &id,
+                                    V &fx, V &fy, V &fz, V &border) {
+    const float jitter = 1.0f; // As in cellular()
+
+    V Pix = mod289(floor(Px)), Piy = mod289(floor(Py)), Piz = mod289(floor(Pz));
+    V Pfx = fract(Px) - 0.5f, Pfy = fract(Py) - 0.5f, Pfz = fract(Pz) - 0.5f;
+
+    V p[3], p1[3][3];
+    for (int i = 0; i < 3; i++)
+        p[i] = permute(Pix + (float)(i - 1));
+    for (int j = 0; j < 3; j++)
+        for (int i = 0; i < 3; i++)
+            p1[j][i] = permute(p[i] + Piy + (float)(j - 1));
+
+    // In the order of the shader, which picks the first of equally near
+    // feature points
+    V dx[27], dy[27], dz[27], d[27];
+    V ax = V(0.0f), ay = V(0.0f), az = V(0.0f);
+    F1 = F2 = id = V(1e30f);
+    for (int j = 0; j < 3; j++)
+        for (int k = 0; k < 3; k++)
+            for (int i = 0; i < 3; i++) {
+                int c = 9 * j + 3 * k + i;
+                V q = permute(p1[j][i] + Piz + (float)(k - 1)), ox, oy, oz;
+                feature3(q, ox, oy, oz);
+                dx[c] = Pfx + (float)(1 - i) + jitter * ox;
+                dy[c] = Pfy + (float)(1 - j) + jitter * oy;
+                dz[c] = Pfz + (float)(1 - k) + jitter * oz;
+                d[c] = dx[c] * dx[c] + dy[c] * dy[c] + dz[c] * dz[c];
+                auto nearer = lessThan(d[c], F1);
+                ax = select(nearer, dx[c], ax);
+                ay = select(nearer, dy[c], ay);
+                az = select(nearer, dz[c], az);
+                id = select(nearer, q, id);
+                insert(d[c], F1, F2);
+            }
+    border = voronoi_border(dx, dy, dz, d, ax, ay, az, F1);
+    fx = -ax;
+    fy = -ay;
+    fz = -az;
+}
+
+// Cellular noise, 2x2x2 search region, squared F1 and F2. Faster, but
+// F2 is often wrong and has sharp discontinuities, as in the shader.
+template <class V>
+static inline void cellular2x2x2(V Px, V Py, V Pz, V &F1, V &F2) {
+    const float jitter = 0.8f; // smaller jitter gives less errors in F2
+
+    V Pix = mod289(floor(Px)), Piy = mod289(floor(Py)), Piz = mod289(floor(Pz));
+    V Pfx = fract(Px), Pfy = fract(Py), Pfz = fract(Pz);
+
+    F1 = F2 = V(1e30f);
+    for (int c = 0; c < 8; c++) {
+        float bx = (float)(c & 1), by = (float)((c >> 1) & 1), bz = (float)(c >> 2);
+        V p = permute(permute(Pix + bx) + Piy + by);
+        V ox, oy, oz;
+        feature3(permute(p + Piz + bz), ox, oy, oz);
+        V dx = Pfx - bx + jitter * ox;
+        V dy = Pfy - by + jitter * oy;
+        V dz = Pfz - bz + jitter * oz;
+        insert(dx * dx + dy * dy + dz * dz, F1, F2);
+    }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,147 @@
+//
+// Description : C++ port of the GLSL classic 2D noise "cnoise" and
+//               its periodic variant "pnoise" in ../src/classicnoise2D.glsl,
+//               and the variants "cnoise_d" and "pnoise_d" with gradients.
+//      Author : Stefan Gustavson (stefan.gustavson@liu.se)
+//     License : Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+//               Distributed under the MIT license. See LICENSE file.
+//               https://github.com/stegu/webgl-noise
+//
+
+#ifndef WEBGLNOISE_CLASSICNOISE2D_H
+#define WEBGLNOISE_CLASSICNOISE2D_H
+
+#include "helpers.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+template <class V>
+static inline V fade(V t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+// Derivative of fade()
+template <class V>
+static inline V fade_d(V t) {
+    return t * t * (t * (t * 30.0f - 60.0f) + 30.0f);
+}
+
+// Common part of cnoise and pnoise, from the (already wrapped)
+// integer corners Pi0, Pi1 and the fractional part Pf0
+template <class V>
+static inline V classic(V Pi0x, V Pi0y, V Pi1x, V Pi1y, V Pf0x, V Pf0y) {
+    Pi0x = mod289(Pi0x); // To avoid truncation effects in permutation
+    Pi0y = mod289(Pi0y);
+    Pi1x = mod289(Pi1x);
+    Pi1y = mod289(Pi1y);
+    V Pf1x = Pf0x - 1.0f, Pf1y = Pf0y - 1.0f;
+
+    // Corners 00, 10, 01, 11 as in Pi.xzxz, Pi.yyww
+    V ix[4] = { Pi0x, Pi1x, Pi0x, Pi1x };
+    V iy[4] = { Pi0y, Pi0y, Pi1y, Pi1y };
+    V fx[4] = { Pf0x, Pf1x, Pf0x, Pf1x };
+    V fy[4] = { Pf0y, Pf0y, Pf1y, Pf1y };
+    V gx[4], gy[4], norm[4], n[4];
+    for (int c = 0; c < 4; c++) {
+        V i = permute(permute(ix[c]) + iy[c]);
+        gx[c] = fract(i * (1.0f / 41.0f)) * 2.0f - 1.0f;
+        gy[c] = abs(gx[c]) - 0.5f;
+        gx[c] = gx[c] - floor(gx[c] + 0.5f);
+        norm[c] = taylorInvSqrt(gx[c] * gx[c] + gy[c] * gy[c]);
+    }
+    // The shader lists the norms in the order 00, 01, 10, 11 but
+    // applies them in the order 00, 10, 01, 11. Keep that as it is.
+    n[0] = norm[0] * (gx[0] * fx[0] + gy[0] * fy[0]);
+    n[1] = norm[2] * (gx[1] * fx[1] + gy[1] * fy[1]);
+    n[2] = norm[1] * (gx[2] * fx[2] + gy[2] * fy[2]);
+    n[3] = norm[3] * (gx[3] * fx[3] + gy[3] * fy[3]);
+
+    V fade_x = fade(Pf0x), fade_y = fade(Pf0y);
+    V n_x0 = mix(n[0], n[1], fade_x);
+    V n_x1 = mix(n[2], n[3], fade_x);
+    return 2.3f * mix(n_x0, n_x1, fade_y);
+}
+
+// Classic Perlin noise
+template <class V>
+static inline V cnoise(V Px, V Py) {
+    V Pi0x = floor(Px), Pi0y = floor(Py);
+    return classic(Pi0x, Pi0y, Pi0x + 1.0f, Pi0y + 1.0f, fract(Px), fract(Py));
+}
+
+// Classic Perlin noise, periodic variant
+template <class V>
+static inline V pnoise(V Px, V Py, V repx, V repy) {
+    V Pi0x = floor(Px), Pi0y = floor(Py);
+    return classic(mod(Pi0x, repx), mod(Pi0y, repy),
+                   mod(Pi0x + 1.0f, repx), mod(Pi0y + 1.0f, repy),
+                   fract(Px), fract(Py));
+}
+
+// classic() with the gradient in (dx, dy), as classic_d() in the shader.
+// The gradient is the blend of the corner gradients, with the weights of
+// their values, plus the derivative of the fade curve times the
+// difference across the cell along each axis.
+template <class V>
+static inline V classic_d(V Pi0x, V Pi0y, V Pi1x, V Pi1y, V Pf0x, V Pf0y,
+                          V &dx, V &dy) {
+    Pi0x = mod289(Pi0x); // To avoid truncation effects in permutation
+    Pi0y = mod289(Pi0y);
+    Pi1x = mod289(Pi1x);
+    Pi1y = mod289(Pi1y);
+    V Pf1x = Pf0x - 1.0f, Pf1y = Pf0y - 1.0f;
+
+    V ix[4] = { Pi0x, Pi1x, Pi0x, Pi1x };
+    V iy[4] = { Pi0y, Pi0y, Pi1y, Pi1y };
+    V fx[4] = { Pf0x, Pf1x, Pf0x, Pf1x };
+    V fy[4] = { Pf0y, Pf0y, Pf1y, Pf1y };
+    V gx[4], gy[4], norm[4], n[4];
+    for (int c = 0; c < 4; c++) {
+        V i = permute(permute(ix[c]) + iy[c]);
+        gx[c] = fract(i * (1.0f / 41.0f)) * 2.0f - 1.0f;
+        gy[c] = abs(gx[c]) - 0.5f;
+        gx[c] = gx[c] - floor(gx[c] + 0.5f);
+        norm[c] = taylorInvSqrt(gx[c] * gx[c] + gy[c] * gy[c]);
+    }
+    // The norms in the order the shader applies them, see classic()
+    V nc[4] = { norm[0], norm[2], norm[1], norm[3] };
+    for (int c = 0; c < 4; c++)
+        n[c] = nc[c] * (gx[c] * fx[c] + gy[c] * fy[c]);
+
+    V fade_x = fade(Pf0x), fade_y = fade(Pf0y);
+    V n_x0 = mix(n[0], n[1], fade_x);
+    V n_x1 = mix(n[2], n[3], fade_x);
+
+    V wx[2] = { 1.0f - fade_x, fade_x }, wy[2] = { 1.0f - fade_y, fade_y };
+    dx = dy = V(0.0f);
+    for (int c = 0; c < 4; c++) {
+        V w = wx[c & 1] * wy[c >> 1] * nc[c];
+        dx += w * gx[c];
+        dy += w * gy[c];
+    }
+    dx = 2.3f * (dx + fade_d(Pf0x) * mix(n[1] - n[0], n[3] - n[2], fade_y));
+    dy = 2.3f * (dy + fade_d(Pf0y) * (n_x1 - n_x0));
+    return 2.3f * mix(n_x0, n_x1, fade_y);
+}
+
+// Classic Perlin noise, with its gradient
+template <class V>
+static inline V cnoise_d(V Px, V Py, V &dx, V &dy) {
+    V Pi0x = floor(Px), Pi0y = floor(Py);
+    return classic_d(Pi0x, Pi0y, Pi0x + 1.0f, Pi0y + 1.0f, fract(Px), fract(Py), dx, dy);
+}
+
+// Classic Perlin noise, periodic variant, with its gradient
+template <class V>
+static inline V pnoise_d(V Px, V Py, V repx, V repy, V &dx, V &dy) {
+    V Pi0x = floor(Px), Pi0y = floor(Py);
+    return classic_d(mod(Pi0x, repx), mod(Pi0y, repy),
+                     mod(Pi0x + 1.0f, repx), mod(Pi0y + 1.0f, repy),
+                     fract(Px), fract(Py), dx, dy);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,149 @@
+//
+// Description : C++ port of the GLSL classic 3D noise "cnoise" and
+//               its periodic variant "pnoise" in ../src/classicnoise3D.glsl,
+//               and the variants "cnoise_d" and "pnoise_d" with gradients.
+//      Author : Stefan Gustavson (stefan.gustavson@liu.se)
+//     License : Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+//               Distributed under the MIT license. See LICENSE file.
+//               https://github.com/stegu/webgl-noise
+//
+// The eight corners are handled in loops, with corner c at offset
+// (c & 1, (c >> 1) & 1, c >> 2), which is the order g000, g100, g010,
+// g110, g001, ... of the shader.
+//
+
+#ifndef WEBGLNOISE_CLASSICNOISE3D_H
+#define WEBGLNOISE_CLASSICNOISE3D_H
+
+#include "classicnoise2D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Gradient for one corner from its hash value
+template <class V>
+static inline void cgrad3(V ixyz, V &gx, V &gy, V &gz) {
+    gx = ixyz * (1.0f / 7.0f);
+    gy = fract(floor(gx) * (1.0f / 7.0f)) - 0.5f;
+    gx = fract(gx);
+    gz = 0.5f - abs(gx) - abs(gy);
+    V sz = step(gz, V(0.0f));
+    gx -= sz * (step(V(0.0f), gx) - 0.5f);
+    gy -= sz * (step(V(0.0f), gy) - 0.5f);
+}
+
+// Common part of cnoise and pnoise, from the (already wrapped)
+// integer corners Pi0, Pi1 and the fractional part Pf0
+template <class V>
+static inline V classic(V Pi0x, V Pi0y, V Pi0z, V Pi1x, V Pi1y, V Pi1z,
+                        V Pf0x, V Pf0y, V Pf0z) {
+    V Pi[2][3] = { { mod289(Pi0x), mod289(Pi0y), mod289(Pi0z) },
+                   { mod289(Pi1x), mod289(Pi1y), mod289(Pi1z) } };
+    V Pf[2][3] = { { Pf0x, Pf0y, Pf0z },
+                   { Pf0x - 1.0f, Pf0y - 1.0f, Pf0z - 1.0f } };
+
+    V ixy[4], n[8];
+    for (int c = 0; c < 4; c++)
+        ixy[c] = permute(permute(Pi[c & 1][0]) + Pi[c >> 1][1]);
+    for (int c = 0; c < 8; c++) {
+        int bx = c & 1, by = (c >> 1) & 1, bz = c >> 2;
+        V gx, gy, gz;
+        cgrad3(permute(ixy[c & 3] + Pi[bz][2]), gx, gy, gz);
+        V norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+        n[c] = norm * (gx * Pf[bx][0] + gy * Pf[by][1] + gz * Pf[bz][2]);
+    }
+
+    V fade_x = fade(Pf0x), fade_y = fade(Pf0y), fade_z = fade(Pf0z);
+    V n_z[4];
+    for (int c = 0; c < 4; c++)
+        n_z[c] = mix(n[c], n[c + 4], fade_z);
+    V n_yz0 = mix(n_z[0], n_z[2], fade_y);
+    V n_yz1 = mix(n_z[1], n_z[3], fade_y);
+    return 2.2f * mix(n_yz0, n_yz1, fade_x);
+}
+
+// Classic Perlin noise
+template <class V>
+static inline V cnoise(V Px, V Py, V Pz) {
+    V Pi0x = floor(Px), Pi0y = floor(Py), Pi0z = floor(Pz);
+    return classic(Pi0x, Pi0y, Pi0z, Pi0x + 1.0f, Pi0y + 1.0f, Pi0z + 1.0f,
+                   fract(Px), fract(Py), fract(Pz));
+}
+
+// Classic Perlin noise, periodic variant
+template <class V>
+static inline V pnoise(V Px, V Py, V Pz, V repx, V repy, V repz) {
+    V Pi0x = mod(floor(Px), repx), Pi0y = mod(floor(Py), repy);
+    V Pi0z = mod(floor(Pz), repz);
+    return classic(Pi0x, Pi0y, Pi0z, mod(Pi0x + 1.0f, repx),
+                   mod(Pi0y + 1.0f, repy), mod(Pi0z + 1.0f, repz),
+                   fract(Px), fract(Py), fract(Pz));
+}
+
+// classic() with the gradient in (dx, dy, dz), as classic_d() in the
+// shader. The gradient is the blend of the corner gradients, with the
+// weights of their values, plus the derivative of the fade curve times
+// the difference across the cell along each axis.
+template <class V>
+static inline V classic_d(V Pi0x, V Pi0y, V Pi0z, V Pi1x, V Pi1y, V Pi1z,
+                          V Pf0x, V Pf0y, V Pf0z, V &dx, V &dy, V &dz) {
+    V Pi[2][3] = { { mod289(Pi0x), mod289(Pi0y), mod289(Pi0z) },
+                   { mod289(Pi1x), mod289(Pi1y), mod289(Pi1z) } };
+    V Pf[2][3] = { { Pf0x, Pf0y, Pf0z },
+                   { Pf0x - 1.0f, Pf0y - 1.0f, Pf0z - 1.0f } };
+    V fade_x = fade(Pf0x), fade_y = fade(Pf0y), fade_z = fade(Pf0z);
+    V wx[2] = { 1.0f - fade_x, fade_x }, wy[2] = { 1.0f - fade_y, fade_y };
+    V wz[2] = { 1.0f - fade_z, fade_z };
+
+    V ixy[4], n[8];
+    for (int c = 0; c < 4; c++)
+        ixy[c] = permute(permute(Pi[c & 1][0]) + Pi[c >> 1][1]);
+    dx = dy = dz = V(0.0f);
+    for (int c = 0; c < 8; c++) {
+        int bx = c & 1, by = (c >> 1) & 1, bz = c >> 2;
+        V gx, gy, gz;
+        cgrad3(permute(ixy[c & 3] + Pi[bz][2]), gx, gy, gz);
+        V norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+        n[c] = norm * (gx * Pf[bx][0] + gy * Pf[by][1] + gz * Pf[bz][2]);
+        V w = wx[bx] * wy[by] * wz[bz] * norm;
+        dx += w * gx;
+        dy += w * gy;
+        dz += w * gz;
+    }
+
+    V n_z[4], dn_z = V(0.0f);
+    for (int c = 0; c < 4; c++) {
+        n_z[c] = mix(n[c], n[c + 4], fade_z);
+        dn_z += wx[c & 1] * wy[c >> 1] * (n[c + 4] - n[c]);
+    }
+    V n_yz0 = mix(n_z[0], n_z[2], fade_y);
+    V n_yz1 = mix(n_z[1], n_z[3], fade_y);
+    dx = 2.2f * (dx + fade_d(Pf0x) * (n_yz1 - n_yz0));
+    dy = 2.2f * (dy + fade_d(Pf0y) * mix(n_z[2] - n_z[0], n_z[3] - n_z[1], fade_x));
+    dz = 2.2f * (dz + fade_d(Pf0z) * dn_z);
+    return 2.2f * mix(n_yz0, n_yz1, fade_x);
+}
+
+// Classic Perlin noise, with its gradient
+template <class V>
+static inline V cnoise_d(V Px, V Py, V Pz, V &dx, V &dy, V &dz) {
+    V Pi0x = floor(Px), Pi0y = floor(Py), Pi0z = floor(Pz);
+    return classic_d(Pi0x, Pi0y, Pi0z, Pi0x + 1.0f, Pi0y + 1.0f, Pi0z + 1.0f,
+                     fract(Px), fract(Py), fract(Pz), dx, dy, dz);
+}
+
+// Classic Perlin noise, periodic variant, with its gradient
+template <class V>
+static inline V pnoise_d(V Px, V Py, V Pz, V repx, V repy, V repz,
+                         V &dx, V &dy, V &dz) {
+    V Pi0x = mod(floor(Px), repx), Pi0y = mod(floor(Py), repy);
+    V Pi0z = mod(floor(Pz), repz);
+    return classic_d(Pi0x, Pi0y, Pi0z, mod(Pi0x + 1.0f, repx),
+                     mod(Pi0y + 1.0f, repy), mod(Pi0z + 1.0f, repz),
+                     fract(Px), fract(Py), fract(Pz), dx, dy, dz);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,180 @@
+//
+// Description : C++ port of the GLSL classic 4D noise "cnoise" and
+//               its periodic variant "pnoise" in ../src/classicnoise4D.glsl,
+//               and the variants "cnoise_d" and "pnoise_d" with gradients.
+//      Author : Stefan Gustavson (stefan.gustavson@liu.se)
+//     License : Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+//               Distributed under the MIT license. See LICENSE file.
+//               https://github.com/stegu/webgl-noise
+//
+// The sixteen corners are handled in loops, with corner c at offset
+// (c & 1, (c >> 1) & 1, (c >> 2) & 1, c >> 3).
+//
+
+#ifndef WEBGLNOISE_CLASSICNOISE4D_H
+#define WEBGLNOISE_CLASSICNOISE4D_H
+
+#include "classicnoise2D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Gradient for one corner from its hash value
+template <class V>
+static inline void cgrad4(V ixyzw, V &gx, V &gy, V &gz, V &gw) {
+    gx = ixyzw * (1.0f / 7.0f);
+    gy = floor(gx) * (1.0f / 7.0f);
+    gz = floor(gy) * (1.0f / 6.0f);
+    gx = fract(gx) - 0.5f;
+    gy = fract(gy) - 0.5f;
+    gz = fract(gz) - 0.5f;
+    gw = 0.75f - abs(gx) - abs(gy) - abs(gz);
+    V sw = step(gw, V(0.0f));
+    gx -= sw * (step(V(0.0f), gx) - 0.5f);
+    gy -= sw * (step(V(0.0f), gy) - 0.5f);
+}
+
+// Common part of cnoise and pnoise, from the (already wrapped)
+// integer corners Pi0, Pi1 and the fractional part Pf0
+template <class V>
+static inline V classic(const V Pi0[4], const V Pi1[4], const V Pf0[4]) {
+    V Pi[2][4], Pf[2][4];
+    for (int d = 0; d < 4; d++) {
+        Pi[0][d] = mod289(Pi0[d]);
+        Pi[1][d] = mod289(Pi1[d]);
+        Pf[0][d] = Pf0[d];
+        Pf[1][d] = Pf0[d] - 1.0f;
+    }
+
+    V ixy[4], ixyz[8], n[16];
+    for (int c = 0; c < 4; c++)
+        ixy[c] = permute(permute(Pi[c & 1][0]) + Pi[c >> 1][1]);
+    for (int c = 0; c < 8; c++)
+        ixyz[c] = permute(ixy[c & 3] + Pi[c >> 2][2]);
+    for (int c = 0; c < 16; c++) {
+        int bx = c & 1, by = (c >> 1) & 1, bz = (c >> 2) & 1, bw = c >> 3;
+        V gx, gy, gz, gw;
+        cgrad4(permute(ixyz[c & 7] + Pi[bw][3]), gx, gy, gz, gw);
+        V norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz + gw * gw);
+        n[c] = norm * (gx * Pf[bx][0] + gy * Pf[by][1] + gz * Pf[bz][2] + gw * Pf[bw][3]);
+    }
+
+    V fade_x = fade(Pf0[0]), fade_y = fade(Pf0[1]);
+    V fade_z = fade(Pf0[2]), fade_w = fade(Pf0[3]);
+    V n_w[8], n_zw[4];
+    for (int c = 0; c < 8; c++)
+        n_w[c] = mix(n[c], n[c + 8], fade_w);
+    for (int c = 0; c < 4; c++)
+        n_zw[c] = mix(n_w[c], n_w[c + 4], fade_z);
+    V n_yzw0 = mix(n_zw[0], n_zw[2], fade_y);
+    V n_yzw1 = mix(n_zw[1], n_zw[3], fade_y);
+    return 2.2f * mix(n_yzw0, n_yzw1, fade_x);
+}
+
+// Classic Perlin noise
+template <class V>
+static inline V cnoise(V Px, V Py, V Pz, V Pw) {
+    V P[4] = { Px, Py, Pz, Pw }, Pi0[4], Pi1[4], Pf0[4];
+    for (int d = 0; d < 4; d++) {
+        Pi0[d] = floor(P[d]);
+        Pi1[d] = Pi0[d] + 1.0f;
+        Pf0[d] = fract(P[d]);
+    }
+    return classic(Pi0, Pi1, Pf0);
+}
+
+// Classic Perlin noise, periodic version
+template <class V>
+static inline V pnoise(V Px, V Py, V Pz, V Pw, V repx, V repy, V repz, V repw) {
+    V P[4] = { Px, Py, Pz, Pw }, rep[4] = { repx, repy, repz, repw };
+    V Pi0[4], Pi1[4], Pf0[4];
+    for (int d = 0; d < 4; d++) {
+        Pi0[d] = mod(floor(P[d]), rep[d]);
+        Pi1[d] = mod(Pi0[d] + 1.0f, rep[d]);
+        Pf0[d] = fract(P[d]);
+    }
+    return classic(Pi0, Pi1, Pf0);
+}
+
+// classic() with the gradient in grad[0 .. 3], as classic_d() in the
+// shader. The gradient is the blend of the corner gradients, with the
+// weights of their values, plus the derivative of the fade curve times
+// the difference across the cell along each axis.
+template <class V>
+static inline V classic_d(const V Pi0[4], const V Pi1[4], const V Pf0[4], V grad[4]) {
+    V Pi[2][4], Pf[2][4], w[2][4];
+    for (int d = 0; d < 4; d++) {
+        Pi[0][d] = mod289(Pi0[d]);
+        Pi[1][d] = mod289(Pi1[d]);
+        Pf[0][d] = Pf0[d];
+        Pf[1][d] = Pf0[d] - 1.0f;
+        w[1][d] = fade(Pf0[d]);
+        w[0][d] = 1.0f - w[1][d];
+        grad[d] = V(0.0f);
+    }
+
+    V ixy[4], ixyz[8], n[16];
+    for (int c = 0; c < 4; c++)
+        ixy[c] = permute(permute(Pi[c & 1][0]) + Pi[c >> 1][1]);
+    for (int c = 0; c < 8; c++)
+        ixyz[c] = permute(ixy[c & 3] + Pi[c >> 2][2]);
+    for (int c = 0; c < 16; c++) {
+        int bx = c & 1, by = (c >> 1) & 1, bz = (c >> 2) & 1, bw = c >> 3;
+        V g[4];
+        cgrad4(permute(ixyz[c & 7] + Pi[bw][3]), g[0], g[1], g[2], g[3]);
+        V norm = taylorInvSqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2] + g[3] * g[3]);
+        n[c] = norm * (g[0] * Pf[bx][0] + g[1] * Pf[by][1] + g[2] * Pf[bz][2] + g[3] * Pf[bw][3]);
+        V wc = w[bx][0] * w[by][1] * w[bz][2] * w[bw][3] * norm;
+        for (int d = 0; d < 4; d++)
+            grad[d] += wc * g[d];
+    }
+
+    V fade_x = w[1][0], fade_y = w[1][1], fade_z = w[1][2], fade_w = w[1][3];
+    V n_w[8], n_zw[4], dn_z = V(0.0f), dn_w = V(0.0f);
+    for (int c = 0; c < 8; c++)
+        n_w[c] = mix(n[c], n[c + 8], fade_w);
+    for (int c = 0; c < 4; c++) {
+        n_zw[c] = mix(n_w[c], n_w[c + 4], fade_z);
+        V w_xy = w[c & 1][0] * w[c >> 1][1];
+        dn_z += w_xy * (n_w[c + 4] - n_w[c]);
+        dn_w += w_xy * mix(n[c + 8] - n[c], n[c + 12] - n[c + 4], fade_z);
+    }
+    V n_yzw0 = mix(n_zw[0], n_zw[2], fade_y);
+    V n_yzw1 = mix(n_zw[1], n_zw[3], fade_y);
+    grad[0] = 2.2f * (grad[0] + fade_d(Pf0[0]) * (n_yzw1 - n_yzw0));
+    grad[1] = 2.2f * (grad[1] + fade_d(Pf0[1]) * mix(n_zw[2] - n_zw[0], n_zw[3] - n_zw[1], fade_x));
+    grad[2] = 2.2f * (grad[2] + fade_d(Pf0[2]) * dn_z);
+    grad[3] = 2.2f * (grad[3] + fade_d(Pf0[3]) * dn_w);
+    return 2.2f * mix(n_yzw0, n_yzw1, fade_x);
+}
+
+// Classic Perlin noise, with its gradient in grad[0 .. 3]
+template <class V>
+static inline V cnoise_d(V Px, V Py, V Pz, V Pw, V grad[4]) {
+    V P[4] = { Px, Py, Pz, Pw }, Pi0[4], Pi1[4], Pf0[4];
+    for (int d = 0; d < 4; d++) {
+        Pi0[d] = floor(P[d]);
+        Pi1[d] = Pi0[d] + 1.0f;
+        Pf0[d] = fract(P[d]);
+    }
+    return classic_d(Pi0, Pi1, Pf0, grad);
+}
+
+// Classic Perlin noise, periodic version, with its gradient in grad[0 .. 3]
+template <class V>
+static inline V pnoise_d(V Px, V Py, V Pz, V Pw, V repx, V repy, V repz, V repw,
+                         V grad[4]) {
+    V P[4] = { Px, Py, Pz, Pw }, rep[4] = { repx, repy, repz, repw };
+    V Pi0[4], Pi1[4], Pf0[4];
+    for (int d = 0; d < 4; d++) {
+        Pi0[d] = mod(floor(P[d]), rep[d]);
+        Pi1[d] = mod(Pi0[d] + 1.0f, rep[d]);
+        Pf0[d] = fract(P[d]);
+    }
+    return classic_d(Pi0, Pi1, Pf0, grad);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,249 @@
+//
+// Benchmark for the CPU noise functions: throughput of each
+// function with each instruction set the CPU supports.
+//
+// Usage: cpubench [samples]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "webglnoise.h"
+
+using namespace webglnoise;
+
+// Random coordinates in [-range, range]
+static void randomFill(std::vector<float> &v, float range, unsigned seed) {
+    srand(seed);
+    for (size_t k = 0; k < v.size(); k++)
+        v[k] = range * (2.0f * rand() / (float)RAND_MAX - 1.0f);
+}
+
+static double now() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? atol(argv[1]) : 1 << 22;
+    std::vector<float> x(n), y(n), z(n), w(n), out(n), ref(n), f2(n);
+    std::vector<float> f1(n), id(n), fx(n), fy(n), fz(n);
+    randomFill(x, 100.0f, 1);
+    randomFill(y, 100.0f, 2);
+    randomFill(z, 100.0f, 3);
+    randomFill(w, 100.0f, 4);
+
+    const char *names[] = { "snoise2", "snoise3", "snoise4",
+                            "cnoise2", "cnoise3", "cnoise4",
+                            "cellular2", "cellular3", "cell3 sq", "cell2x2x2",
+                            "voronoi2", "voronoi3", "psnoise3", "psnoise4",
+                            "psrdnoise3", "psrnoise3", "cnoise2_d", "cnoise3_d",
+                            "cnoise4_d", "snoise4_d", "curlnoise3", "snoise3v",
+                            "snoise4v" };
+    Isa widest = ISA_SCALAR;
+    printf("%-10s %-8s %10s %12s\n", "function", "isa", "ns/sample", "max|diff|");
+    for (int f = 0; f < 23; f++) {
+        for (int i = ISA_SCALAR; i <= ISA_AVX512; i++) {
+            if (!set_isa((Isa)i))
+                continue;
+            widest = (Isa)i;
+            double best = 1e30;
+            for (int rep = 0; rep < 3; rep++) {
+                double t0 = now();
+                switch (f) {
+                    case 0: snoise2(x.data(), y.data(), out.data(), n); break;
+                    case 1: snoise3(x.data(), y.data(), z.data(), out.data(), n); break;
+                    case 2: snoise4(x.data(), y.data(), z.data(), w.data(), out.data(), n); break;
+                    case 3: cnoise2(x.data(), y.data(), out.data(), n); break;
+                    case 4: cnoise3(x.data(), y.data(), z.data(), out.data(), n); break;
+                    case 5: cnoise4(x.data(), y.data(), z.data(), w.data(), out.data(), n); break;
+                    case 6: cellular2(x.data(), y.data(), out.data(), f2.data(), n); break;
+                    case 7: cellular3(x.data(), y.data(), z.data(), out.data(), f2.data(), n); break;
+                    case 8: cellular3(x.data(), y.data(), z.data(), out.data(), f2.data(), n, true); break;
+                    case 9: cellular2x2x2(x.data(), y.data(), z.data(), out.data(), f2.data(), n); break;
+                    // Compares the border distances
+                    case 10: cellular2_voronoi(x.data(), y.data(), f1.data(), f2.data(), id.data(),
+                                               fx.data(), fy.data(), out.data(), n); break;
+                    case 11: cellular3_voronoi(x.data(), y.data(), z.data(), f1.data(), f2.data(),
+                                               id.data(), fx.data(), fy.data(), fz.data(),
+                                               out.data(), n); break;
+                    case 12: psnoise3(x.data(), y.data(), z.data(), out.data(), n, 8.0f, 8.0f, 8.0f); break;
+                    case 13: psnoise4(x.data(), y.data(), z.data(), w.data(), out.data(), n,
+                                      8.0f, 8.0f, 8.0f, 8.0f); break;
+                    case 14: psrdnoise3(x.data(), y.data(), z.data(), out.data(), fx.data(),
+                                        fy.data(), fz.data(), n, 8.0f, 8.0f, 8.0f, 0.25f); break;
+                    case 15: psrnoise3(x.data(), y.data(), z.data(), out.data(), n,
+                                       8.0f, 8.0f, 8.0f, 0.25f); break;
+                    case 16: cnoise2_d(x.data(), y.data(), out.data(), fx.data(), fy.data(), n); break;
+                    case 17: cnoise3_d(x.data(), y.data(), z.data(), out.data(), fx.data(),
+                                       fy.data(), fz.data(), n); break;
+                    case 18: cnoise4_d(x.data(), y.data(), z.data(), w.data(), out.data(),
+                                       fx.data(), fy.data(), fz.data(), f1.data(), n); break;
+                    case 19: snoise4_d(x.data(), y.data(), z.data(), w.data(), out.data(),
+                                       fx.data(), fy.data(), fz.data(), f1.data(), n); break;
+                    // Compares the x components
+                    case 20: curlnoise3(x.data(), y.data(), z.data(), out.data(), fy.data(),
+                                        fz.data(), n); break;
+                    // Compare the first channels
+                    case 21: snoise3v(x.data(), y.data(), z.data(), out.data(), fy.data(),
+                                      fz.data(), n); break;
+                    case 22: snoise4v(x.data(), y.data(), z.data(), out.data(), fy.data(),
+                                      fz.data(), f1.data(), n); break;
+                }
+                double t = now() - t0;
+                if (t < best)
+                    best = t;
+            }
+            // Compare against the scalar kernels, which run first
+            if (i == ISA_SCALAR)
+                ref = out;
+            float diff = 0.0f;
+            for (size_t k = 0; k < n; k++)
+                diff = fmaxf(diff, fabsf(out[k] - ref[k]));
+            printf("%-10s %-8s %10.2f %12g\n", names[f], isa_name((Isa)i),
+                   best * 1e9 / n, diff);
+        }
+    }
+
+    // snoise3 with each lattice hash. The table lookups should give the
+    // same results as the polynomial.
+    const Hash hashes[] = { HASH_PERMUTE, HASH_TABLE, HASH_INT32 };
+    printf("\n%-10s %-8s %10s %10s %10s %12s\n", "snoise3", "isa", "permute", "table",
+           "int32", "max|diff|");
+    for (int i = ISA_SCALAR; i <= ISA_AVX512; i++) {
+        if (!set_isa((Isa)i))
+            continue;
+        double best[3] = { 1e30, 1e30, 1e30 };
+        for (int rep = 0; rep < 3; rep++)
+            for (int h = 0; h < 3; h++) {
+                double t0 = now();
+                snoise3_hash(x.data(), y.data(), z.data(), h == 1 ? out.data() : ref.data(),
+                             n, hashes[h]);
+                best[h] = std::min(best[h], now() - t0);
+            }
+        snoise3_hash(x.data(), y.data(), z.data(), ref.data(), n, HASH_PERMUTE);
+        float diff = 0.0f;
+        for (size_t k = 0; k < n; k++)
+            diff = fmaxf(diff, fabsf(out[k] - ref[k]));
+        printf("%-10s %-8s %10.2f %10.2f %10.2f %12g\n", "", isa_name((Isa)i),
+               best[0] * 1e9 / n, best[1] * 1e9 / n, best[2] * 1e9 / n, diff);
+    }
+
+    // fbm3 against the same sum from separate snoise3 calls per octave
+    const int octaves = 6;
+    std::vector<float> sx(n), sy(n), sz(n), octave(n);
+    printf("\n%-10s %-8s %10s %10s %12s\n", "fbm3", "isa", "fused", "separate", "max|diff|");
+    for (int i = ISA_SCALAR; i <= ISA_AVX512; i++) {
+        if (!set_isa((Isa)i))
+            continue;
+        double fused = 1e30, separate = 1e30;
+        for (int rep = 0; rep < 3; rep++) {
+            double t0 = now();
+            fbm3(x.data(), y.data(), z.data(), out.data(), n, octaves, 2.0f, 0.5f);
+            double t1 = now();
+            float freq = 1.0f, amp = 1.0f;
+            std::fill(ref.begin(), ref.end(), 0.0f);
+            for (int o = 0; o < octaves; o++) {
+                for (size_t k = 0; k < n; k++) {
+                    sx[k] = x[k] * freq;
+                    sy[k] = y[k] * freq;
+                    sz[k] = z[k] * freq;
+                }
+                snoise3(sx.data(), sy.data(), sz.data(), octave.data(), n);
+                for (size_t k = 0; k < n; k++)
+                    ref[k] += amp * octave[k];
+                freq *= 2.0f;
+                amp *= 0.5f;
+            }
+            double t2 = now();
+            fused = std::min(fused, t1 - t0);
+            separate = std::min(separate, t2 - t1);
+        }
+        float diff = 0.0f;
+        for (size_t k = 0; k < n; k++)
+            diff = fmaxf(diff, fabsf(out[k] - ref[k]));
+        printf("%-10s %-8s %10.2f %10.2f %12g\n", "", isa_name((Isa)i),
+               fused * 1e9 / n, separate * 1e9 / n, diff);
+    }
+
+    // A 256 x 256 x 64 volume of noise with a step of 0.01, with the
+    // widest instruction set, point by point and with the dense grid
+    // engines. (The origin is chosen to keep grid points off the diagonals
+    // of the lattice cubes, where snoise() has a discontinuity that the
+    // dense grid engine does not reproduce.)
+    set_isa(widest);
+    int width = 256, height = 256, depth = 64;
+    size_t pitch = image_pitch(width), size = pitch * height * depth;
+    float *data = (float *)aligned_alloc(64, size * sizeof(float));
+    float *dense = (float *)aligned_alloc(64, size * sizeof(float));
+    std::fill(data, data + size, 0.0f); // Including the padding of the rows
+    std::fill(dense, dense + size, 0.0f);
+    Image image = { data, width, height, depth, pitch };
+    Image denseImage = { dense, width, height, depth, pitch };
+    Image noF2 = { nullptr, width, height, depth, pitch };
+    Grid grid = { { 0.123f, 0.456f, 0.789f }, { 0.01f, 0.01f, 0.01f } };
+    double samples = (double)width * height * depth;
+    int cores = (int)std::thread::hardware_concurrency();
+
+    auto pnoise3_1 = [](const float *x, const float *y, const float *z,
+                        float *out, size_t n) { pnoise3(x, y, z, out, n, 1.0f, 2.0f, 3.0f); };
+    // F1 only, as generate() takes one output
+    auto cellular2_f1 = [](const float *x, const float *y, float *out, size_t n) {
+        std::vector<float> f2(n);
+        cellular2(x, y, out, f2.data(), n);
+    };
+    auto cellular3_f1 = [](const float *x, const float *y, const float *z,
+                           float *out, size_t n) {
+        std::vector<float> f2(n);
+        cellular3(x, y, z, out, f2.data(), n);
+    };
+    struct {
+        const char *name;
+        std::function<void(int threads)> point, grid;
+    } generators[] = {
+        { "snoise3", [&](int t) { generate(snoise3, image, grid, t); },
+                     [&](int t) { generate_snoise3(denseImage, grid, t); } },
+        { "cnoise2", [&](int t) { generate(cnoise2, image, grid, t); },
+                     [&](int t) { generate_cnoise2(denseImage, grid, t); } },
+        { "cnoise3", [&](int t) { generate(cnoise3, image, grid, t); },
+                     [&](int t) { generate_cnoise3(denseImage, grid, t); } },
+        { "pnoise3", [&](int t) { generate(pnoise3_1, image, grid, t); },
+                     [&](int t) { generate_pnoise3(denseImage, grid, 1.0f, 2.0f, 3.0f, t); } },
+        { "cellular2", [&](int t) { generate(cellular2_f1, image, grid, t); },
+                       [&](int t) { generate_cellular2(denseImage, noF2, grid, false, t); } },
+        { "cellular3", [&](int t) { generate(cellular3_f1, image, grid, t); },
+                       [&](int t) { generate_cellular3(denseImage, noF2, grid, false, t); } },
+    };
+    // "per core" is the throughput per thread, point by point and dense,
+    // relative to that of one thread, for the scaling across cores
+    printf("\n%-10s %-8s %10s %10s %9s %9s %12s\n", "generate", "threads", "ns/sample",
+           "dense", "per core", "dense", "max|diff|");
+    for (auto &g : generators) {
+        double single[2] = { 0.0, 0.0 };
+        for (int threads = 1; threads <= cores; threads *= 2) {
+            double t0 = now();
+            g.point(threads);
+            double t1 = now();
+            g.grid(threads);
+            double t2 = now();
+            if (threads == 1) {
+                single[0] = t1 - t0;
+                single[1] = t2 - t1;
+            }
+            float diff = 0.0f;
+            for (size_t k = 0; k < size; k++)
+                diff = fmaxf(diff, fabsf(data[k] - dense[k]));
+            printf("%-10s %-8d %10.2f %10.2f %8.0f%% %8.0f%% %12g\n", g.name, threads,
+                   (t1 - t0) * 1e9 / samples, (t2 - t1) * 1e9 / samples,
+                   100.0 * single[0] / ((t1 - t0) * threads),
+                   100.0 * single[1] / ((t2 - t1) * threads), diff);
+        }
+    }
+    free(data);
+    free(dense);
+    return 0;
+}
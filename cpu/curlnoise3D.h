@@ -0,0 +1,56 @@
+//
+// Description : C++ port of the GLSL curl noise in ../src/curlnoise3D.glsl.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// The simplex and the corner weights come from simplex3() in noise3D.h,
+// once for the three noise fields of the potential.
+//
+
+#ifndef WEBGLNOISE_CURLNOISE3D_H
+#define WEBGLNOISE_CURLNOISE3D_H
+
+#include "noise3D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Curl of the potential of three 3D simplex noise fields, into (cx, cy,
+// cz). The corner gradients of the first field come from the hash p of
+// the corner, as in snoise(), and those of the others from the seeded
+// hashes permute(p + 97) and permute(p + 152).
+template <class V>
+static inline void curlnoise(V vx, V vy, V vz, V &cx, V &cy, V &cz) {
+    const float seed[3] = { 0.0f, 97.0f, 152.0f };
+    V x[4], y[4], z[4], p[4], m4[4], m3[4];
+    simplex3(vx, vy, vz, x, y, z, p, m4);
+    for (int c = 0; c < 4; c++) {
+        V m = max(0.5f - (x[c] * x[c] + y[c] * y[c] + z[c] * z[c]), V(0.0f));
+        m3[c] = m * m * m;
+    }
+
+// Gradients of the three fields, each from its own corner gradients
+    V dx[3], dy[3], dz[3];
+    for (int f = 0; f < 3; f++) {
+        dx[f] = dy[f] = dz[f] = V(0.0f);
+        for (int c = 0; c < 4; c++) {
+            V px, py, pz;
+            grad3(f == 0 ? p[c] : permute(p[c] + seed[f]), px, py, pz);
+            V temp = -8.0f * m3[c] * (px * x[c] + py * y[c] + pz * z[c]);
+            dx[f] += m4[c] * px + temp * x[c];
+            dy[f] += m4[c] * py + temp * y[c];
+            dz[f] += m4[c] * pz + temp * z[c];
+        }
+    }
+
+    cx = 105.0f * (dy[2] - dz[1]);
+    cy = 105.0f * (dz[0] - dx[2]);
+    cz = 105.0f * (dx[1] - dy[0]);
+}
+
+}
+}
+
+#endif
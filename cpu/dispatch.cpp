@@ -0,0 +1,258 @@
+//
+// Description : Public entry points of the CPU noise library. The
+//               kernels are picked from cpuid when the library loads.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+
+#include "webglnoise.h"
+#include "kernels.h"
+
+namespace webglnoise {
+
+static const Kernels *table(Isa isa) {
+    switch (isa) {
+#if defined(__x86_64__) || defined(__i386__)
+        case ISA_SSE41: return &sse41::kernels;
+        case ISA_AVX2: return &avx2::kernels;
+        case ISA_AVX512: return &avx512::kernels;
+#endif
+        default: return &scalar::kernels;
+    }
+}
+
+bool isa_supported(Isa isa) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    switch (isa) {
+        case ISA_SCALAR: return true;
+        case ISA_SSE41: return __builtin_cpu_supports("sse4.1");
+        case ISA_AVX2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case ISA_AVX512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma");
+        default: return false;
+    }
+#else
+    return isa == ISA_SCALAR;
+#endif
+}
+
+static Isa best_isa() {
+    Isa best = ISA_SCALAR;
+    for (int i = ISA_SCALAR; i <= ISA_AVX512; i++)
+        if (isa_supported((Isa)i))
+            best = (Isa)i;
+    return best;
+}
+
+// Constant initialised, so that the library also works when called
+// from static constructors that run before the one at the end
+static Isa active_isa = ISA_SCALAR;
+static const Kernels *active = 0;
+
+static inline const Kernels *kernels() {
+    if (!active)
+        set_isa(best_isa());
+    return active;
+}
+
+const Kernels *active_kernels() {
+    return kernels();
+}
+
+Isa isa() {
+    kernels();
+    return active_isa;
+}
+
+const char *isa_name(Isa isa) {
+    return table(isa)->name;
+}
+
+bool set_isa(Isa isa) {
+    if (!isa_supported(isa))
+        return false;
+    active_isa = isa;
+    active = table(isa);
+    return true;
+}
+
+// Pick the kernels when the library is loaded
+static const Kernels *initial = kernels();
+
+void snoise2(const float *x, const float *y, float *out, size_t n) {
+    kernels()->snoise2(x, y, out, n);
+}
+
+void snoise3(const float *x, const float *y, const float *z,
+             float *out, size_t n) {
+    kernels()->snoise3(x, y, z, out, n);
+}
+
+void snoise3_hash(const float *x, const float *y, const float *z,
+                  float *out, size_t n, Hash hash) {
+    const Kernels *k = kernels();
+    if (hash == HASH_TABLE)
+        k->snoise3_table(x, y, z, out, n);
+    else if (hash == HASH_INT32)
+        k->snoise3_int32(x, y, z, out, n);
+    else
+        k->snoise3(x, y, z, out, n);
+}
+
+void snoise3v(const float *x, const float *y, const float *z,
+              float *outx, float *outy, float *outz, size_t n) {
+    kernels()->snoise3v(x, y, z, outx, outy, outz, n);
+}
+
+void snoise4v(const float *x, const float *y, const float *z,
+              float *outx, float *outy, float *outz, float *outw, size_t n) {
+    kernels()->snoise4v(x, y, z, outx, outy, outz, outw, n);
+}
+
+void snoise4(const float *x, const float *y, const float *z,
+             const float *w, float *out, size_t n) {
+    kernels()->snoise4(x, y, z, w, out, n);
+}
+
+void snoise4_d(const float *x, const float *y, const float *z,
+               const float *w, float *out, float *dx, float *dy,
+               float *dz, float *dw, size_t n) {
+    kernels()->snoise4_d(x, y, z, w, out, dx, dy, dz, dw, n);
+}
+
+void cnoise2(const float *x, const float *y, float *out, size_t n) {
+    kernels()->cnoise2(x, y, out, n);
+}
+
+void cnoise3(const float *x, const float *y, const float *z,
+             float *out, size_t n) {
+    kernels()->cnoise3(x, y, z, out, n);
+}
+
+void cnoise4(const float *x, const float *y, const float *z,
+             const float *w, float *out, size_t n) {
+    kernels()->cnoise4(x, y, z, w, out, n);
+}
+
+void pnoise2(const float *x, const float *y, float *out, size_t n,
+             float repx, float repy) {
+    kernels()->pnoise2(x, y, out, n, repx, repy);
+}
+
+void pnoise3(const float *x, const float *y, const float *z,
+             float *out, size_t n, float repx, float repy, float repz) {
+    kernels()->pnoise3(x, y, z, out, n, repx, repy, repz);
+}
+
+void pnoise4(const float *x, const float *y, const float *z,
+             const float *w, float *out, size_t n,
+             float repx, float repy, float repz, float repw) {
+    kernels()->pnoise4(x, y, z, w, out, n, repx, repy, repz, repw);
+}
+
+void cnoise2_d(const float *x, const float *y, float *out,
+               float *dx, float *dy, size_t n) {
+    kernels()->cnoise2_d(x, y, out, dx, dy, n);
+}
+
+void cnoise3_d(const float *x, const float *y, const float *z,
+               float *out, float *dx, float *dy, float *dz, size_t n) {
+    kernels()->cnoise3_d(x, y, z, out, dx, dy, dz, n);
+}
+
+void cnoise4_d(const float *x, const float *y, const float *z,
+               const float *w, float *out, float *dx, float *dy,
+               float *dz, float *dw, size_t n) {
+    kernels()->cnoise4_d(x, y, z, w, out, dx, dy, dz, dw, n);
+}
+
+void pnoise2_d(const float *x, const float *y, float *out,
+               float *dx, float *dy, size_t n, float repx, float repy) {
+    kernels()->pnoise2_d(x, y, out, dx, dy, n, repx, repy);
+}
+
+void pnoise3_d(const float *x, const float *y, const float *z,
+               float *out, float *dx, float *dy, float *dz, size_t n,
+               float repx, float repy, float repz) {
+    kernels()->pnoise3_d(x, y, z, out, dx, dy, dz, n, repx, repy, repz);
+}
+
+void pnoise4_d(const float *x, const float *y, const float *z,
+               const float *w, float *out, float *dx, float *dy,
+               float *dz, float *dw, size_t n,
+               float repx, float repy, float repz, float repw) {
+    kernels()->pnoise4_d(x, y, z, w, out, dx, dy, dz, dw, n, repx, repy, repz, repw);
+}
+
+void psnoise3(const float *x, const float *y, const float *z,
+              float *out, size_t n, float repx, float repy, float repz) {
+    kernels()->psnoise3(x, y, z, out, n, repx, repy, repz);
+}
+
+void psnoise4(const float *x, const float *y, const float *z,
+              const float *w, float *out, size_t n,
+              float repx, float repy, float repz, float repw) {
+    kernels()->psnoise4(x, y, z, w, out, n, repx, repy, repz, repw);
+}
+
+void psrdnoise3(const float *x, const float *y, const float *z,
+                float *out, float *dx, float *dy, float *dz, size_t n,
+                float perx, float pery, float perz, float rot) {
+    kernels()->psrdnoise3(x, y, z, out, dx, dy, dz, n, perx, pery, perz, rot);
+}
+
+void psrnoise3(const float *x, const float *y, const float *z,
+               float *out, size_t n, float perx, float pery, float perz, float rot) {
+    kernels()->psrnoise3(x, y, z, out, n, perx, pery, perz, rot);
+}
+
+void curlnoise3(const float *x, const float *y, const float *z,
+                float *cx, float *cy, float *cz, size_t n) {
+    kernels()->curlnoise3(x, y, z, cx, cy, cz, n);
+}
+
+void cellular2(const float *x, const float *y, float *f1, float *f2, size_t n,
+               bool squared) {
+    kernels()->cellular2(x, y, f1, f2, n, squared);
+}
+
+void cellular3(const float *x, const float *y, const float *z,
+               float *f1, float *f2, size_t n, bool squared) {
+    kernels()->cellular3(x, y, z, f1, f2, n, squared);
+}
+
+void cellular2x2x2(const float *x, const float *y, const float *z,
+                   float *f1, float *f2, size_t n, bool squared) {
+    kernels()->cellular2x2x2(x, y, z, f1, f2, n, squared);
+}
+
+void pcellular2(const float *x, const float *y, float *f1, float *f2, size_t n,
+                float repx, float repy, bool squared) {
+    kernels()->pcellular2(x, y, f1, f2, n, repx, repy, squared);
+}
+
+void pcellular3(const float *x, const float *y, const float *z,
+                float *f1, float *f2, size_t n,
+                float repx, float repy, float repz, bool squared) {
+    kernels()->pcellular3(x, y, z, f1, f2, n, repx, repy, repz, squared);
+}
+
+void cellular2_voronoi(const float *x, const float *y, float *f1, float *f2,
+                       float *id, float *fx, float *fy, float *border, size_t n) {
+    kernels()->cellular2_voronoi(x, y, f1, f2, id, fx, fy, border, n);
+}
+
+void cellular3_voronoi(const float *x, const float *y, const float *z,
+                       float *f1, float *f2, float *id, float *fx, float *fy,
+                       float *fz, float *border, size_t n) {
+    kernels()->cellular3_voronoi(x, y, z, f1, f2, id, fx, fy, fz, border, n);
+}
+
+void fbm3(const float *x, const float *y, const float *z,
+          float *out, size_t n, int octaves, float lacunarity, float gain) {
+    kernels()->fbm3(x, y, z, out, n, octaves, lacunarity, gain);
+}
+
+}
@@ -0,0 +1,48 @@
+//
+// Description : C++ port of the GLSL fractal sum of 3D simplex noise
+//               in ../src/fbm3D.glsl.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// Each point is loaded once and stays in registers for all octaves.
+// The octaves are evaluated two at a time: they do not depend on each
+// other, so the two long chains of dependent instructions in snoise()
+// can overlap even on CPUs with a small reordering window. (Big out of
+// order cores overlap consecutive octaves on their own.) The sum is
+// accumulated in the same order as in the shader, so the result is the
+// same as from separate snoise3() calls.
+//
+
+#ifndef WEBGLNOISE_FBM3D_H
+#define WEBGLNOISE_FBM3D_H
+
+#include "noise3D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+template <class V>
+static inline V fbm(V px, V py, V pz, int octaves, float lacunarity, float gain) {
+    V sum = 0.0f;
+    float freq = 1.0f, amp = 1.0f;
+    int o = 0;
+    for (; o + 2 <= octaves; o += 2) {
+        float freq1 = freq * lacunarity, amp1 = amp * gain;
+        V n0 = snoise(px * freq, py * freq, pz * freq);
+        V n1 = snoise(px * freq1, py * freq1, pz * freq1);
+        sum += amp * n0;
+        sum += amp1 * n1;
+        freq = freq1 * lacunarity;
+        amp = amp1 * gain;
+    }
+    if (o < octaves)
+        sum += amp * snoise(px * freq, py * freq, pz * freq);
+    return sum;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,382 @@
+//
+//
+// Check of the mediump noise functions in ../src/mediump with emulated
+// half floats, the least precision that mediump may have: every
+// operation is rounded to the nearest fp16 value, with 11 significant
+// bits. The GLSL functions are ported here one operation at a time,
+// in the order of the shader source, for a float type T that is either
+// double or the emulated half.
+//
+// Usage: fp16check [samples]
+//
+// First, the whole-number helpers of the hash are checked for every
+// input they are meant to take: they must give exactly the same values
+// as integer arithmetic, or the noise would pick other gradients than
+// with highp floats. The permute() of the highp files is checked the same
+// way, to show where it goes wrong. Then the noise is evaluated at random
+// points within a range of coordinates, which are rounded to fp16, and
+// compared with the ports in double precision. The highp noise from the
+// library must agree with those, which shows that the mediump functions
+// compute the same noise. The error of the half floats is the rounding
+// error of mediump: it does not grow with the coordinates for classic
+// noise, where fract(P) is exact, but it does for simplex noise, where
+// the skewed lattice coordinates are rounded. A function passes when
+// its error for coordinates within +-4 is below 1/255 rms, one step of
+// an 8-bit colour channel, and below 0.03 everywhere.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <functional>
+#include <vector>
+#include "webglnoise.h"
+
+using namespace webglnoise;
+
+// x rounded to the nearest half float, ties to even, with subnormals
+// below 2^-14 and infinity from 65520 up
+static float toHalf(double x) {
+    double a = fabs(x);
+    if (!(a < 65520.0))
+        return a == a ? (float)copysign(INFINITY, x) : (float)x;
+    int e;
+    frexp(a, &e);
+    double scale = ldexp(1.0, 11 - (e < -13 ? -13 : e));
+    return (float)copysign(nearbyint(a * scale) / scale, x);
+}
+
+// A float that is rounded to a half float by every operation. The sums
+// and products of half floats are exact as doubles, so they are rounded
+// only once.
+struct half {
+    float v;
+    half() {}
+    half(double x) : v(toHalf(x)) {}
+};
+
+static half operator+(half a, half b) { return half((double)a.v + b.v); }
+static half operator-(half a, half b) { return half((double)a.v - b.v); }
+static half operator*(half a, half b) { return half((double)a.v * b.v); }
+static bool operator<(half a, half b) { return a.v < b.v; }
+static bool operator>(half a, half b) { return a.v > b.v; }
+static half floor(half x) { return half(floor(x.v)); }
+static half abs(half x) { return half(fabs(x.v)); }
+static half max(half a, half b) { return a.v < b.v ? b : a; }
+
+static double max(double a, double b) { return fmax(a, b); }
+using std::abs;
+using std::floor;
+
+// The GLSL functions that the ports use, for float and half
+template <class T> static T fract(T x) { return x - floor(x); }
+template <class T> static T step(T edge, T x) { return T(x < edge ? 0.0 : 1.0); }
+template <class T> static T mix(T x, T y, T a) { return x + (y - x) * a; }
+
+// mod289(), mod17(), mod41(), mod49(), mod7() and permute() of
+// ../src/mediump
+template <class T> static T mod289(T x) {
+    x = x - floor(x * T(1.0 / 289.0)) * T(289.0);
+    x = x + T(289.0) * (T(1.0) - step(T(0.0), x));
+    return x - T(289.0) * step(T(289.0), x);
+}
+
+template <class T> static T modn(T x, double n) {
+    return x - floor((x + T(0.5)) * T(1.0 / n)) * T(n);
+}
+
+template <class T> static T permute(T x) {
+    x = x - T(289.0) * step(T(289.0), x);
+    T a = floor((x + T(8.5)) * T(1.0 / 17.0));
+    T b = x - T(17.0) * a;
+    return T(10.0) * b + T(17.0) * modn(T(2.0) * b * b + T(10.0) * a, 17.0);
+}
+
+// permute() of the highp files
+template <class T> static T permuteHighp(T x) {
+    x = ((x * T(34.0)) + T(10.0)) * x;
+    return x - floor(x * T(1.0 / 289.0)) * T(289.0);
+}
+
+template <class T> static T taylorInvSqrt(T r) {
+    return T(1.79284291400159) - T(0.85373472095314) * r;
+}
+
+// snoise() of mediump/noise2D.glsl
+template <class T> static T snoise2(T vx, T vy) {
+    const T Cx(0.211324865405187), Cy(0.366025403784439),
+        Cz(-0.577350269189626), Cw(0.048780487804878);
+    T s = vx * Cy + vy * Cy;
+    T ix = floor(vx + s), iy = floor(vy + s);
+    T t = ix * Cx + iy * Cx;
+    T x[3], y[3];
+    x[0] = vx - ix + t;
+    y[0] = vy - iy + t;
+    T i1x = x[0] > y[0] ? T(1.0) : T(0.0), i1y = T(1.0) - i1x;
+    x[1] = x[0] + Cx - i1x;
+    y[1] = y[0] + Cx - i1y;
+    x[2] = x[0] + Cz;
+    y[2] = y[0] + Cz;
+
+    ix = mod289(ix);
+    iy = mod289(iy);
+    const T ox[3] = { T(0.0), i1x, T(1.0) }, oy[3] = { T(0.0), i1y, T(1.0) };
+    T n = T(0.0);
+    for (int k = 0; k < 3; k++) {
+        T p = mod289(permute(permute(iy + oy[k]) + ix + ox[k]));
+        T m = max(T(0.5) - (x[k] * x[k] + y[k] * y[k]), T(0.0));
+        m = m * m;
+        m = m * m;
+        T gx = modn(p, 41.0) * Cw - T(1.0);
+        T h = abs(gx) - T(0.5);
+        T a0 = gx - floor(gx + T(0.5));
+        m = m * (T(1.79284291400159) - T(0.85373472095314) * (a0 * a0 + h * h));
+        n = n + m * (a0 * x[k] + h * y[k]);
+    }
+    return T(130.0) * n;
+}
+
+// snoise() of mediump/noise3D.glsl
+template <class T> static T snoise3(T vx, T vy, T vz) {
+    const T Cx(1.0 / 6.0), Cy(1.0 / 3.0);
+    T s = vx * Cy + vy * Cy + vz * Cy;
+    T i[3] = { floor(vx + s), floor(vy + s), floor(vz + s) };
+    T t = i[0] * Cx + i[1] * Cx + i[2] * Cx;
+    T x0[3] = { vx - i[0] + t, vy - i[1] + t, vz - i[2] + t };
+
+    // g = step(x0.yzx, x0.xyz), i1 = min(g, l.zxy), i2 = max(g, l.zxy)
+    T o[4][3];
+    for (int a = 0; a < 3; a++) {
+        T g = step(x0[(a + 1) % 3], x0[a]);
+        T lz = T(1.0) - step(x0[a], x0[(a + 2) % 3]); // l.zxy[a]
+        o[0][a] = T(0.0);
+        o[1][a] = g < lz ? g : lz;
+        o[2][a] = g < lz ? lz : g;
+        o[3][a] = T(1.0);
+    }
+    T x[4][3];
+    for (int a = 0; a < 3; a++) {
+        x[0][a] = x0[a];
+        x[1][a] = x0[a] - o[1][a] + Cx;
+        x[2][a] = x0[a] - o[2][a] + Cy;
+        x[3][a] = x0[a] - T(0.5);
+    }
+
+    for (int a = 0; a < 3; a++)
+        i[a] = mod289(i[a]);
+    T n = T(0.0);
+    for (int k = 0; k < 4; k++) {
+        T p = mod289(permute(permute(permute(i[2] + o[k][2]) + i[1] + o[k][1])
+                             + i[0] + o[k][0]));
+        T j = modn(p, 49.0);
+        T x_ = floor((j + T(0.5)) * T(1.0 / 7.0));
+        T y_ = j - T(7.0) * x_;
+        T ax = T(4.0) * x_ - T(13.0);
+        T ay = T(4.0) * y_ - T(13.0);
+        T h = T(14.0) - abs(ax) - abs(ay);
+        T sh = T(-14.0) * step(h, step(T(0.0), ax) - T(1.0));
+        ax = (ax + (step(T(0.0), ax) * T(2.0) - T(1.0)) * sh) * T(1.0 / 14.0);
+        ay = (ay + (step(T(0.0), ay) * T(2.0) - T(1.0)) * sh) * T(1.0 / 14.0);
+        h = h * T(1.0 / 14.0);
+        T norm = taylorInvSqrt(ax * ax + ay * ay + h * h);
+        ax = ax * norm;
+        ay = ay * norm;
+        h = h * norm;
+        T m = max(T(0.5) - (x[k][0] * x[k][0] + x[k][1] * x[k][1]
+                            + x[k][2] * x[k][2]), T(0.0));
+        m = m * m;
+        n = n + m * m * (ax * x[k][0] + ay * x[k][1] + h * x[k][2]);
+    }
+    return T(105.0) * n;
+}
+
+template <class T> static T fade(T t) {
+    return t * t * t * (t * (t * T(6.0) - T(15.0)) + T(10.0));
+}
+
+// cnoise() of mediump/classicnoise2D.glsl
+template <class T> static T cnoise2(T Px, T Py) {
+    T Pi[2][2] = { { mod289(floor(Px)), mod289(floor(Py)) },
+                   { mod289(floor(Px) + T(1.0)), mod289(floor(Py) + T(1.0)) } };
+    T Pf[2][2] = { { fract(Px), fract(Py) },
+                   { fract(Px) - T(1.0), fract(Py) - T(1.0) } };
+    T gx[2][2], gy[2][2], n[2][2];
+    for (int by = 0; by < 2; by++)
+        for (int bx = 0; bx < 2; bx++) {
+            T i = mod289(permute(permute(Pi[bx][0]) + Pi[by][1]));
+            gx[by][bx] = modn(i, 41.0) * T(2.0 / 41.0) - T(1.0);
+            gy[by][bx] = abs(gx[by][bx]) - T(0.5);
+            gx[by][bx] = gx[by][bx] - floor(gx[by][bx] + T(0.5));
+        }
+    // As in the shader, n10 and n01 are scaled with the norm of each other's
+    // gradient
+    for (int by = 0; by < 2; by++)
+        for (int bx = 0; bx < 2; bx++) {
+            T norm = taylorInvSqrt(gx[bx][by] * gx[bx][by] + gy[bx][by] * gy[bx][by]);
+            n[by][bx] = norm * (gx[by][bx] * Pf[bx][0] + gy[by][bx] * Pf[by][1]);
+        }
+    T fx = fade(Pf[0][0]), fy = fade(Pf[0][1]);
+    return T(2.3) * mix(mix(n[0][0], n[0][1], fx), mix(n[1][0], n[1][1], fx), fy);
+}
+
+// cgrad() of mediump/classicnoise3D.glsl
+template <class T> static void cgrad(T i, T &gx, T &gy, T &gz) {
+    T q = floor((i + T(0.5)) * T(1.0 / 7.0));
+    gx = T(2.0) * (i - T(7.0) * q);
+    gy = T(2.0) * modn(q, 7.0) - T(7.0);
+    gz = T(7.0) - abs(gx) - abs(gy);
+    T sz = step(gz, T(0.0)) - step(abs(i - T(147.0)), T(0.0));
+    gx = gx - sz * (step(T(0.0), gx) * T(14.0) - T(7.0));
+    gy = gy - sz * (step(T(0.0), gy) * T(14.0) - T(7.0));
+    gx = gx * T(1.0 / 14.0);
+    gy = gy * T(1.0 / 14.0);
+    gz = gz * T(1.0 / 14.0);
+}
+
+// cnoise() of mediump/classicnoise3D.glsl, with corner c at offset
+// (c & 1, (c >> 1) & 1, c >> 2)
+template <class T> static T cnoise3(T Px, T Py, T Pz) {
+    T P[3] = { Px, Py, Pz }, Pi[2][3], Pf[2][3];
+    for (int a = 0; a < 3; a++) {
+        Pi[0][a] = mod289(floor(P[a]));
+        Pi[1][a] = mod289(floor(P[a]) + T(1.0));
+        Pf[0][a] = fract(P[a]);
+        Pf[1][a] = Pf[0][a] - T(1.0);
+    }
+    T n[8];
+    for (int c = 0; c < 8; c++) {
+        int bx = c & 1, by = (c >> 1) & 1, bz = c >> 2;
+        T ixy = permute(permute(Pi[bx][0]) + Pi[by][1]);
+        T gx, gy, gz;
+        cgrad(mod289(permute(ixy + Pi[bz][2])), gx, gy, gz);
+        T norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+        n[c] = norm * (gx * Pf[bx][0] + gy * Pf[by][1] + gz * Pf[bz][2]);
+    }
+    T fx = fade(Pf[0][0]), fy = fade(Pf[0][1]), fz = fade(Pf[0][2]);
+    T n_z[4];
+    for (int c = 0; c < 4; c++)
+        n_z[c] = mix(n[c], n[c + 4], fz);
+    return T(2.2) * mix(mix(n_z[0], n_z[2], fy), mix(n_z[1], n_z[3], fy), fx);
+}
+
+// Number of whole numbers lo <= x < hi for which f(half(x)) is not g(x)
+static int countWrong(int lo, int hi, std::function<half(half)> f,
+                      std::function<long(long)> g) {
+    int wrong = 0;
+    for (long x = lo; x < hi; x++)
+        if (f(half((double)x)).v != (float)g(x))
+            wrong++;
+    return wrong;
+}
+
+typedef std::function<void(float *const *in, float *out, size_t n)> NoiseFn;
+typedef std::function<float(const float *in)> PortFn;
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? atol(argv[1]) : 1 << 18;
+    const double rmsTolerance = 1.0 / 255.0, maxTolerance = 0.03;
+    int failed = 0;
+
+    auto mod = [](long x, long m) { return ((x % m) + m) % m; };
+    struct {
+        const char *name;
+        int lo, hi;
+        std::function<half(half)> f;
+        std::function<long(long)> g;
+        bool mustPass;
+    } exact[] = {
+        { "mod289", -2048, 2049, [](half x) { return mod289(x); },
+          [&](long x) { return mod(x, 289); }, true },
+        { "mod17", -80, 360, [](half x) { return modn(x, 17.0); },
+          [&](long x) { return mod(x, 17); }, true },
+        { "mod41", -80, 360, [](half x) { return modn(x, 41.0); },
+          [&](long x) { return mod(x, 41); }, true },
+        { "mod49", -80, 360, [](half x) { return modn(x, 49.0); },
+          [&](long x) { return mod(x, 49); }, true },
+        { "mod7", -80, 360, [](half x) { return modn(x, 7.0); },
+          [&](long x) { return mod(x, 7); }, true },
+        { "permute", -80, 642, [](half x) { return mod289(permute(x)); },
+          [&](long x) { return mod(34 * x * x + 10 * x, 289); }, true },
+        { "highp permute", 0, 578, [](half x) { return permuteHighp(x); },
+          [&](long x) { return mod(34 * x * x + 10 * x, 289); }, false },
+    };
+    printf("%-14s %-12s %s\n", "helper", "inputs", "wrong with fp16");
+    for (auto &e : exact) {
+        int wrong = countWrong(e.lo, e.hi, e.f, e.g);
+        char inputs[32];
+        snprintf(inputs, sizeof(inputs), "%d..%d", e.lo, e.hi - 1);
+        bool pass = wrong == 0 || !e.mustPass;
+        printf("%-14s %-12s %d%s\n", e.name, inputs, wrong, pass ? "" : "  FAILED");
+        if (!pass)
+            failed++;
+    }
+
+    struct {
+        const char *name;
+        int dims;
+        NoiseFn highp;
+        PortFn exact;
+        PortFn mediump;
+    } checks[] = {
+        { "snoise2", 2,
+          [](float *const *v, float *out, size_t n) { snoise2(v[0], v[1], out, n); },
+          [](const float *p) { return (float)snoise2<double>(p[0], p[1]); },
+          [](const float *p) { return snoise2(half(p[0]), half(p[1])).v; } },
+        { "snoise3", 3,
+          [](float *const *v, float *out, size_t n) { snoise3(v[0], v[1], v[2], out, n); },
+          [](const float *p) { return (float)snoise3<double>(p[0], p[1], p[2]); },
+          [](const float *p) {
+              return snoise3(half(p[0]), half(p[1]), half(p[2])).v; } },
+        { "cnoise2", 2,
+          [](float *const *v, float *out, size_t n) { cnoise2(v[0], v[1], out, n); },
+          [](const float *p) { return (float)cnoise2<double>(p[0], p[1]); },
+          [](const float *p) { return cnoise2(half(p[0]), half(p[1])).v; } },
+        { "cnoise3", 3,
+          [](float *const *v, float *out, size_t n) { cnoise3(v[0], v[1], v[2], out, n); },
+          [](const float *p) { return (float)cnoise3<double>(p[0], p[1], p[2]); },
+          [](const float *p) {
+              return cnoise3(half(p[0]), half(p[1]), half(p[2])).v; } },
+    };
+    const float ranges[] = { 4.0f, 16.0f, 64.0f };
+
+    printf("\n%-8s %5s %12s %12s %12s %12s\n", "function", "range", "highp>1e-3",
+           "highp max", "fp16 rms", "fp16 max");
+    std::vector<float> P[3], highp(n);
+    for (int d = 0; d < 3; d++)
+        P[d].resize(n);
+    float *p[3] = { P[0].data(), P[1].data(), P[2].data() };
+    for (auto &c : checks)
+        for (float range : ranges) {
+            // Random coordinates in [-range, range], rounded to fp16
+            srand(c.dims);
+            for (int d = 0; d < c.dims; d++)
+                for (size_t k = 0; k < n; k++)
+                    P[d][k] = toHalf(range * (2.0 * rand() / RAND_MAX - 1.0));
+            c.highp(p, highp.data(), n);
+            size_t off = 0;
+            double highpMax = 0.0, sum = 0.0, worst = 0.0;
+            for (size_t k = 0; k < n; k++) {
+                float q[3] = { P[0][k], P[1][k], P[2][k] };
+                float exact = c.exact(q);
+                double e = fabs(highp[k] - exact);
+                highpMax = fmax(highpMax, e);
+                if (e > 1e-3)
+                    off++;
+                e = fabs(c.mediump(q) - exact);
+                sum += e * e;
+                worst = fmax(worst, e);
+            }
+            // The highp noise must be the same at all ranges. Only the
+            // range of 4 has to be within the fp16 tolerances: the others
+            // show how the error grows.
+            double rms = sqrt(sum / n);
+            bool pass = off == 0 && (range > 4.0f
+                                     || (rms <= rmsTolerance && worst <= maxTolerance));
+            printf("%-8s %5g %11.3f%% %12g %12g %12g%s\n", c.name, range,
+                   100.0 * off / n, highpMax, rms, worst,
+                   pass ? "" : "  FAILED");
+            if (!pass)
+                failed++;
+        }
+    return failed ? 1 : 0;
+}
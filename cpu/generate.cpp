@@ -0,0 +1,236 @@
+//
+// Description : Multi-threaded generation of noise images and volumes.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// The image is split into tiles, numbered in memory order, and every
+// thread starts out owning a contiguous range of tile numbers. A thread
+// takes tiles from the front of its own range, and when that runs out,
+// it steals the back half of the range of another thread. A range is a
+// single 64-bit atomic (begin and end packed together), so both taking
+// and stealing are one compare-and-swap, and each range sits on its
+// own cache line.
+//
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "kernels.h"
+
+namespace webglnoise {
+
+enum { LINE = 64 / sizeof(float) }; // Floats per cache line
+
+size_t image_pitch(int width) {
+    return (width + LINE - 1) / LINE * LINE;
+}
+
+struct alignas(64) Range {
+    std::atomic<uint64_t> r;
+};
+
+static inline uint64_t pack(uint32_t begin, uint32_t end) {
+    return (uint64_t)end << 32 | begin;
+}
+
+// Take the first tile of our own range
+static bool take(Range &own, uint32_t &tile) {
+    uint64_t r = own.r.load();
+    for (;;) {
+        uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (begin >= end)
+            return false;
+        if (own.r.compare_exchange_weak(r, pack(begin + 1, end))) {
+            tile = begin;
+            return true;
+        }
+    }
+}
+
+// Move the back half of the range of another thread to our own,
+// which is empty, so nobody else is changing it
+static bool steal(Range &victim, Range &own) {
+    uint64_t r = victim.r.load();
+    for (;;) {
+        uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (begin >= end)
+            return false;
+        uint32_t mid = end - (end - begin + 1) / 2;
+        if (victim.r.compare_exchange_weak(r, pack(begin, mid))) {
+            own.r.store(pack(mid, end));
+            return true;
+        }
+    }
+}
+
+void for_each_tile(const Image &image, int sx, int sy, int sz, int threads,
+                   const std::function<void(const Tile &)> &fn) {
+    sx = (sx + LINE - 1) / LINE * LINE;
+    int nx = (image.width + sx - 1) / sx;
+    int ny = (image.height + sy - 1) / sy;
+    int nz = (image.depth + sz - 1) / sz;
+    uint32_t tiles = (uint32_t)nx * ny * nz;
+    if (tiles == 0)
+        return;
+
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0)
+        threads = 1;
+    if ((uint32_t)threads > tiles)
+        threads = (int)tiles;
+
+    std::vector<Range> ranges(threads);
+    for (int t = 0; t < threads; t++)
+        ranges[t].r.store(pack((uint64_t)tiles * t / threads,
+                               (uint64_t)tiles * (t + 1) / threads));
+
+    auto work = [&](int self) {
+        uint32_t k;
+        for (;;) {
+            while (take(ranges[self], k)) {
+                int tx = k % nx, ty = k / nx % ny, tz = k / nx / ny;
+                Tile tile;
+                tile.x0 = tx * sx;
+                tile.y0 = ty * sy;
+                tile.z0 = tz * sz;
+                tile.x1 = tile.x0 + sx < image.width ? tile.x0 + sx : image.width;
+                tile.y1 = tile.y0 + sy < image.height ? tile.y0 + sy : image.height;
+                tile.z1 = tile.z0 + sz < image.depth ? tile.z0 + sz : image.depth;
+                fn(tile);
+            }
+            bool stolen = false;
+            for (int i = 1; i < threads && !stolen; i++)
+                stolen = steal(ranges[(self + i) % threads], ranges[self]);
+            if (!stolen)
+                return;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(work, t);
+    work(0);
+    for (auto &thread : pool)
+        thread.join();
+}
+
+float grid_line(const Grid &grid, int d, int i) {
+    return grid.origin[d] + i * grid.step[d];
+}
+
+// Tile size for evaluating noise one sample at a time: 4 KB of output
+// per tile, which keeps the tiles small enough to balance the load well
+enum { TILE_X = 64, TILE_Y = 16 };
+
+void generate(const Noise2 &noise, const Image &image, const Grid &grid,
+              int threads) {
+    for_each_tile(image, TILE_X, TILE_Y, 1, threads, [&](const Tile &t) {
+        float x[TILE_X], y[TILE_X];
+        int n = t.x1 - t.x0;
+        for (int i = 0; i < n; i++)
+            x[i] = grid_line(grid, 0, t.x0 + i);
+        for (int k = t.z0; k < t.z1; k++)
+            for (int j = t.y0; j < t.y1; j++) {
+                float yj = grid_line(grid, 1, j);
+                for (int i = 0; i < n; i++)
+                    y[i] = yj;
+                float *row = image.data + ((size_t)k * image.height + j) * image.pitch;
+                noise(x, y, row + t.x0, n);
+            }
+    });
+}
+
+void sample_tile(TileNoise noise, const void *context, const Image &image,
+                 const Grid &grid, const Tile &t) {
+    float x[TILE_X], y[TILE_X], z[TILE_X];
+    for (int i0 = t.x0; i0 < t.x1; i0 += TILE_X) {
+        int n = t.x1 - i0 < TILE_X ? t.x1 - i0 : TILE_X;
+        for (int i = 0; i < n; i++)
+            x[i] = grid_line(grid, 0, i0 + i);
+        for (int k = t.z0; k < t.z1; k++)
+            for (int j = t.y0; j < t.y1; j++) {
+                float yj = grid_line(grid, 1, j), zk = grid_line(grid, 2, k);
+                for (int i = 0; i < n; i++) {
+                    y[i] = yj;
+                    z[i] = zk;
+                }
+                float *row = image.data + ((size_t)k * image.height + j) * image.pitch;
+                noise(context, x, y, z, row + i0, n);
+            }
+    }
+}
+
+void generate(const Noise3 &noise, const Image &image, const Grid &grid,
+              int threads) {
+    for_each_tile(image, TILE_X, TILE_Y, 1, threads, [&](const Tile &t) {
+        sample_tile([](const void *c, const float *x, const float *y, const float *z,
+                       float *out, size_t n) {
+            (*static_cast<const Noise3 *>(c))(x, y, z, out, n);
+        }, &noise, image, grid, t);
+    });
+}
+
+// Bricks for the dense grid engines: each lattice vertex near a brick
+// costs a fixed amount of setup, so they are bigger than the tiles above
+enum { BRICK_X = 64, BRICK_Y = 16, BRICK_Z = 16 };
+
+void generate_snoise3(const Image &image, const Grid &grid, int threads) {
+    const Kernels *k = active_kernels();
+    for_each_tile(image, BRICK_X, BRICK_Y, BRICK_Z, threads, [&](const Tile &t) {
+        k->snoise3_grid(image, grid, t);
+    });
+}
+
+void generate_cnoise2(const Image &image, const Grid &grid, int threads) {
+    const Kernels *k = active_kernels();
+    for_each_tile(image, BRICK_X, BRICK_Y, BRICK_Z, threads, [&](const Tile &t) {
+        k->cnoise2_grid(image, grid, t, nullptr);
+    });
+}
+
+void generate_cnoise3(const Image &image, const Grid &grid, int threads) {
+    const Kernels *k = active_kernels();
+    for_each_tile(image, BRICK_X, BRICK_Y, BRICK_Z, threads, [&](const Tile &t) {
+        k->cnoise3_grid(image, grid, t, nullptr);
+    });
+}
+
+void generate_pnoise2(const Image &image, const Grid &grid, float repx, float repy,
+                      int threads) {
+    const Kernels *k = active_kernels();
+    float rep[] = { repx, repy };
+    for_each_tile(image, BRICK_X, BRICK_Y, BRICK_Z, threads, [&](const Tile &t) {
+        k->cnoise2_grid(image, grid, t, rep);
+    });
+}
+
+void generate_pnoise3(const Image &image, const Grid &grid, float repx, float repy,
+                      float repz, int threads) {
+    const Kernels *k = active_kernels();
+    float rep[] = { repx, repy, repz };
+    for_each_tile(image, BRICK_X, BRICK_Y, BRICK_Z, threads, [&](const Tile &t) {
+        k->cnoise3_grid(image, grid, t, rep);
+    });
+}
+
+void generate_cellular2(const Image &f1, const Image &f2, const Grid &grid,
+                        bool squared, int threads) {
+    const Kernels *k = active_kernels();
+    for_each_tile(f1, BRICK_X, BRICK_Y, BRICK_Z, threads, [&](const Tile &t) {
+        k->cellular2_grid(f1, f2, grid, t, squared);
+    });
+}
+
+void generate_cellular3(const Image &f1, const Image &f2, const Grid &grid,
+                        bool squared, int threads) {
+    const Kernels *k = active_kernels();
+    for_each_tile(f1, BRICK_X, BRICK_Y, BRICK_Z, threads, [&](const Tile &t) {
+        k->cellular3_grid(f1, f2, grid, t, squared);
+    });
+}
+
+}
@@ -0,0 +1,356 @@
+//
+// Check of the analytic gradients of the CPU noise functions against
+// finite differences of the noise values, with each instruction set
+// the CPU supports. Also checks that the noise values are the same as
+// from the functions without the gradient, that curl noise is the curl
+// of its potential, and that its divergence is 0. Finally, measures the
+// error of snoise3 against a double precision evaluation of the shader,
+// for the bound given in README.
+//
+// Usage: gradcheck [samples]
+// (samples is the number of points for the gradients, by default 2^18)
+//
+// The differences are taken with a step of 1/1024, which keeps both the
+// truncation error and the rounding error of the noise values well below
+// the tolerance. The noise has seams, where the slope jumps (classic 2D
+// noise at cell edges) or even the value (4D simplex noise, where the
+// kernels reach past the neighbouring simplices), and a difference across
+// a seam has nothing to do with the gradient. So each point is checked
+// with the central difference and with the second order one-sided
+// differences to either side, and the best of them counts: one of them
+// misses the seam, unless there are seams on both sides within two steps.
+// A function passes when 99.9% of the points are within the tolerance.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "webglnoise.h"
+
+using namespace webglnoise;
+
+// Random coordinates in [-range, range]
+static void randomFill(std::vector<float> &v, float range, unsigned seed) {
+    srand(seed);
+    for (size_t k = 0; k < v.size(); k++)
+        v[k] = range * (2.0f * rand() / (float)RAND_MAX - 1.0f);
+}
+
+typedef std::function<void(float *const *in, float *out, size_t n)> NoiseFn;
+typedef std::function<void(float *const *in, float *out, float *const *grad,
+                           size_t n)> GradFn;
+
+// snoise(vec3) from ../src/noise3D.glsl, evaluated in double precision
+// as the reference for the accuracy of snoise3, except for the gradients.
+// The lattice hash is done in integers, as it is exact in the shader,
+// and the gradients are mapped onto the octahedron in float, as in the
+// shader: for the points on its equator, h is 0 only up to rounding, and
+// its sign picks one of two quite different gradients. spread is set to
+// the spread of the components of x0, which is 0 on the main diagonal of
+// the cell.
+static int permute(int x) {
+    return (34 * x * x + 10 * x) % 289;
+}
+
+static double snoise3Ref(double vx, double vy, double vz, double &spread) {
+    const double Cx = 1.0 / 6.0, Cy = 1.0 / 3.0;
+
+    double s = (vx + vy + vz) * Cy;
+    double i[3] = { floor(vx + s), floor(vy + s), floor(vz + s) };
+    double t = (i[0] + i[1] + i[2]) * Cx;
+    double x0[3] = { vx - i[0] + t, vy - i[1] + t, vz - i[2] + t };
+    spread = fmax(fmax(x0[0], x0[1]), x0[2]) - fmin(fmin(x0[0], x0[1]), x0[2]);
+
+    double g[3], l[3], i1[3], i2[3];
+    for (int a = 0; a < 3; a++) {
+        g[a] = x0[a] >= x0[(a + 1) % 3] ? 1.0 : 0.0;
+        l[a] = 1.0 - g[a];
+    }
+    for (int a = 0; a < 3; a++) {
+        i1[a] = fmin(g[a], l[(a + 2) % 3]);
+        i2[a] = fmax(g[a], l[(a + 2) % 3]);
+    }
+    // The corners of the simplex, and the vectors from them to v
+    int corner[4][3];
+    double x[4][3];
+    for (int a = 0; a < 3; a++) {
+        corner[0][a] = 0;
+        corner[1][a] = (int)i1[a];
+        corner[2][a] = (int)i2[a];
+        corner[3][a] = 1;
+        x[0][a] = x0[a];
+        x[1][a] = x0[a] - i1[a] + Cx;
+        x[2][a] = x0[a] - i2[a] + Cy;
+        x[3][a] = x0[a] - 0.5;
+    }
+    int ix = ((int)i[0] % 289 + 289) % 289, iy = ((int)i[1] % 289 + 289) % 289,
+        iz = ((int)i[2] % 289 + 289) % 289;
+
+    const float n_ = 0.142857142857f; // 1.0/7.0
+    const float nsx = n_ * 2.0f, nsy = n_ * 0.5f - 1.0f;
+    double sum = 0.0;
+    for (int c = 0; c < 4; c++) {
+        int p = permute(permute(permute(iz + corner[c][2]) + iy + corner[c][1])
+                        + ix + corner[c][0]);
+        float gx = (float)(p % 49 / 7) * nsx + nsy;
+        float gy = (float)(p % 7) * nsx + nsy;
+        float h = 1.0f - fabsf(gx) - fabsf(gy);
+        if (h <= 0.0f) {
+            gx -= floorf(gx) * 2.0f + 1.0f;
+            gy -= floorf(gy) * 2.0f + 1.0f;
+        }
+        double norm = 1.79284291400159 - 0.85373472095314 *
+            ((double)gx * gx + (double)gy * gy + (double)h * h);
+        double m = fmax(0.5 - (x[c][0] * x[c][0] + x[c][1] * x[c][1] + x[c][2] * x[c][2]), 0.0);
+        m = m * m;
+        sum += m * m * norm * (gx * x[c][0] + gy * x[c][1] + h * x[c][2]);
+    }
+    return 105.0 * sum;
+}
+
+typedef std::function<void(float *const *in, float *const *out, size_t n)> FieldFn;
+
+// Derivatives of the three channels of a 3D vector field along each axis,
+// D[s][c][a] for channel c along axis a, by the central (s = 0), forward
+// (s = 1) and backward (s = 2) differences used for the gradients in main()
+static void fieldDifferences(const FieldFn &field, float *const *p, float h,
+                             size_t n, std::vector<float> (&D)[3][3][3]) {
+    const float offsets[4] = { -2.0f * h, -h, h, 2.0f * h };
+    std::vector<float> Q[3], F[5][3];
+    float *q[3], *f[5][3];
+    for (int d = 0; d < 3; d++) {
+        Q[d].assign(p[d], p[d] + n);
+        q[d] = Q[d].data();
+    }
+    for (int o = 0; o < 5; o++)
+        for (int c = 0; c < 3; c++) {
+            F[o][c].resize(n);
+            f[o][c] = F[o][c].data();
+        }
+    field(p, f[4], n);
+    for (int a = 0; a < 3; a++) {
+        for (int o = 0; o < 4; o++) {
+            for (size_t k = 0; k < n; k++)
+                Q[a][k] = p[a][k] + offsets[o];
+            field(q, f[o], n);
+        }
+        Q[a].assign(p[a], p[a] + n);
+        for (int c = 0; c < 3; c++) {
+            for (int s = 0; s < 3; s++)
+                D[s][c][a].resize(n);
+            for (size_t k = 0; k < n; k++) {
+                D[0][c][a][k] = (f[2][c][k] - f[1][c][k]) / (2.0f * h);
+                D[1][c][a][k] = (-3.0f * f[4][c][k] + 4.0f * f[2][c][k] - f[3][c][k]) / (2.0f * h);
+                D[2][c][a][k] = (3.0f * f[4][c][k] - 4.0f * f[1][c][k] + f[0][c][k]) / (2.0f * h);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? atol(argv[1]) : 1 << 18;
+    const float h = 1.0f / 1024.0f, tolerance = 1e-2f;
+
+    struct {
+        const char *name;
+        int dims;
+        NoiseFn value;
+        GradFn grad;
+    } checks[] = {
+        { "snoise4_d", 4,
+          [](float *const *v, float *out, size_t n) {
+              snoise4(v[0], v[1], v[2], v[3], out, n); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              snoise4_d(v[0], v[1], v[2], v[3], out, d[0], d[1], d[2], d[3], n); } },
+        { "cnoise2_d", 2,
+          [](float *const *v, float *out, size_t n) { cnoise2(v[0], v[1], out, n); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              cnoise2_d(v[0], v[1], out, d[0], d[1], n); } },
+        { "cnoise3_d", 3,
+          [](float *const *v, float *out, size_t n) { cnoise3(v[0], v[1], v[2], out, n); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              cnoise3_d(v[0], v[1], v[2], out, d[0], d[1], d[2], n); } },
+        { "cnoise4_d", 4,
+          [](float *const *v, float *out, size_t n) {
+              cnoise4(v[0], v[1], v[2], v[3], out, n); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              cnoise4_d(v[0], v[1], v[2], v[3], out, d[0], d[1], d[2], d[3], n); } },
+        { "pnoise2_d", 2,
+          [](float *const *v, float *out, size_t n) {
+              pnoise2(v[0], v[1], out, n, 3.0f, 4.0f); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              pnoise2_d(v[0], v[1], out, d[0], d[1], n, 3.0f, 4.0f); } },
+        { "pnoise3_d", 3,
+          [](float *const *v, float *out, size_t n) {
+              pnoise3(v[0], v[1], v[2], out, n, 3.0f, 4.0f, 5.0f); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              pnoise3_d(v[0], v[1], v[2], out, d[0], d[1], d[2], n, 3.0f, 4.0f, 5.0f); } },
+        { "psrdnoise3", 3,
+          [](float *const *v, float *out, size_t n) {
+              psrnoise3(v[0], v[1], v[2], out, n, 8.0f, 8.0f, 8.0f, 0.25f); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              psrdnoise3(v[0], v[1], v[2], out, d[0], d[1], d[2], n,
+                         8.0f, 8.0f, 8.0f, 0.25f); } },
+        { "pnoise4_d", 4,
+          [](float *const *v, float *out, size_t n) {
+              pnoise4(v[0], v[1], v[2], v[3], out, n, 3.0f, 4.0f, 5.0f, 6.0f); },
+          [](float *const *v, float *out, float *const *d, size_t n) {
+              pnoise4_d(v[0], v[1], v[2], v[3], out, d[0], d[1], d[2], d[3], n,
+                        3.0f, 4.0f, 5.0f, 6.0f); } },
+    };
+
+    std::vector<float> P[4], Q[4], grad[4], value(n), out(n), f[4], err(n);
+    for (int d = 0; d < 4; d++) {
+        P[d].resize(n);
+        Q[d].resize(n);
+        grad[d].resize(n);
+        f[d].resize(n);
+        randomFill(P[d], 20.0f, d + 1);
+    }
+    float *p[4], *q[4], *g[4];
+    for (int d = 0; d < 4; d++) {
+        p[d] = P[d].data();
+        q[d] = Q[d].data();
+        g[d] = grad[d].data();
+    }
+
+    int failed = 0;
+    printf("%-10s %-8s %12s %12s %12s %12s\n", "function", "isa", "max|diff|",
+           "median err", "99.9% err", "max err");
+    for (auto &c : checks)
+        for (int i = ISA_SCALAR; i <= ISA_AVX512; i++) {
+            if (!set_isa((Isa)i))
+                continue;
+            c.grad(p, out.data(), g, n);
+            c.value(p, value.data(), n);
+            float diff = 0.0f;
+            for (size_t k = 0; k < n; k++)
+                diff = fmaxf(diff, fabsf(out[k] - value[k]));
+
+            // Differences along each axis, from the noise at -2, -1, 1 and 2
+            // steps. The coordinates are within +-20, where floats are spaced
+            // 1/2^19 or finer, so the steps are exact.
+            std::fill(err.begin(), err.end(), 0.0f);
+            for (int a = 0; a < c.dims; a++) {
+                const float offsets[4] = { -2.0f * h, -h, h, 2.0f * h };
+                for (int d = 0; d < c.dims; d++)
+                    Q[d] = P[d];
+                for (int o = 0; o < 4; o++) {
+                    for (size_t k = 0; k < n; k++)
+                        Q[a][k] = P[a][k] + offsets[o];
+                    c.value(q, f[o].data(), n);
+                }
+                for (size_t k = 0; k < n; k++) {
+                    float central = (f[2][k] - f[1][k]) / (2.0f * h);
+                    float forward = (-3.0f * value[k] + 4.0f * f[2][k] - f[3][k]) / (2.0f * h);
+                    float backward = (3.0f * value[k] - 4.0f * f[1][k] + f[0][k]) / (2.0f * h);
+                    float e = fminf(fabsf(central - grad[a][k]),
+                                    fminf(fabsf(forward - grad[a][k]),
+                                          fabsf(backward - grad[a][k])));
+                    err[k] = fmaxf(err[k], e);
+                }
+            }
+            std::sort(err.begin(), err.end());
+            float median = err[n / 2], p999 = err[n - 1 - n / 1000];
+            bool pass = p999 <= tolerance && diff <= 1e-6f;
+            printf("%-10s %-8s %12g %12g %12g %12g%s\n", c.name, isa_name((Isa)i),
+                   diff, median, p999, err[n - 1], pass ? "" : "  FAILED");
+            if (!pass)
+                failed++;
+        }
+
+    // Curl noise against the curl of its potential, the three channels of
+    // snoise3v(), by finite differences, and the divergence of curl noise,
+    // which is 0, by finite differences of the curl noise itself. As for
+    // the gradients, the best of the three differences counts.
+    FieldFn potential = [](float *const *v, float *const *out, size_t n) {
+        snoise3v(v[0], v[1], v[2], out[0], out[1], out[2], n); };
+    FieldFn curl = [](float *const *v, float *const *out, size_t n) {
+        curlnoise3(v[0], v[1], v[2], out[0], out[1], out[2], n); };
+    std::vector<float> D[3][3][3];
+    float *c[3] = { f[0].data(), f[1].data(), f[2].data() };
+    auto report = [&](const char *name, int isa, float tol) {
+        std::sort(err.begin(), err.end());
+        float median = err[n / 2], p999 = err[n - 1 - n / 1000];
+        bool pass = p999 <= tol;
+        printf("%-10s %-8s %12s %12g %12g %12g%s\n", name, isa_name((Isa)isa), "",
+               median, p999, err[n - 1], pass ? "" : "  FAILED");
+        if (!pass)
+            failed++;
+    };
+    for (int i = ISA_SCALAR; i <= ISA_AVX512; i++) {
+        if (!set_isa((Isa)i))
+            continue;
+        curl(p, c, n);
+        fieldDifferences(potential, p, h, n, D);
+        for (size_t k = 0; k < n; k++) {
+            err[k] = INFINITY;
+            for (int s = 0; s < 3; s++) {
+                float ex = fabsf(D[s][2][1][k] - D[s][1][2][k] - c[0][k]);
+                float ey = fabsf(D[s][0][2][k] - D[s][2][0][k] - c[1][k]);
+                float ez = fabsf(D[s][1][0][k] - D[s][0][1][k] - c[2][k]);
+                err[k] = fminf(err[k], fmaxf(ex, fmaxf(ey, ez)));
+            }
+        }
+        report("curlnoise3", i, tolerance);
+
+        fieldDifferences(curl, p, h, n, D);
+        for (size_t k = 0; k < n; k++) {
+            err[k] = INFINITY;
+            for (int s = 0; s < 3; s++)
+                err[k] = fminf(err[k], fabsf(D[s][0][0][k] + D[s][1][1][k] +
+                                             D[s][2][2][k]));
+        }
+        report("div curl", i, tolerance);
+    }
+
+    // The error of snoise3 against snoise3Ref(), in units in the last place
+    // (ULP) of max(|x|, |y|, |z|, 1), over 4 million random points per range.
+    // Points within a few ULP of the main diagonal of their cell are counted
+    // apart: there, x0 in float can have three equal components, and the
+    // shader then takes i1 = (0, 0, 0) and i2 = (1, 1, 1), a flat simplex,
+    // where the exact code takes a proper one. The shader code in float is
+    // off by up to a few tenths at such points (see README).
+    const float ranges[] = { 10.0f, 100.0f, 1000.0f, 10000.0f };
+    const size_t m = 1 << 22;
+    const float maxUlp = 32.0f, diagonalUlp = 4.0f;
+    std::vector<float> X(m), Y(m), Z(m), noise(m), ulp(m);
+    std::vector<double> ref(m);
+    std::vector<char> diagonal(m);
+    printf("\n%-10s %-8s %12s %12s %12s %12s\n", "snoise3", "isa", "range", "median ULP",
+           "max ULP", "diagonal");
+    for (float range : ranges) {
+        randomFill(X, range, 11);
+        randomFill(Y, range, 12);
+        randomFill(Z, range, 13);
+        size_t diagonals = 0;
+        for (size_t k = 0; k < m; k++) {
+            double spread;
+            ref[k] = snoise3Ref(X[k], Y[k], Z[k], spread);
+            float a = fmaxf(fmaxf(fabsf(X[k]), fabsf(Y[k])), fmaxf(fabsf(Z[k]), 1.0f));
+            ulp[k] = nextafterf(a, INFINITY) - a;
+            diagonal[k] = spread <= diagonalUlp * ulp[k];
+            diagonals += diagonal[k];
+        }
+        for (int i = ISA_SCALAR; i <= ISA_AVX512; i++) {
+            if (!set_isa((Isa)i))
+                continue;
+            snoise3(X.data(), Y.data(), Z.data(), noise.data(), m);
+            std::vector<float> e;
+            for (size_t k = 0; k < m; k++)
+                if (!diagonal[k])
+                    e.push_back((float)(fabs(noise[k] - ref[k]) / ulp[k]));
+            std::sort(e.begin(), e.end());
+            size_t ne = e.size();
+            bool pass = e[ne - 1] <= maxUlp;
+            printf("%-10s %-8s %12g %12g %12g %12zu%s\n", "", isa_name((Isa)i), range,
+                   e[ne / 2], e[ne - 1], diagonals, pass ? "" : "  FAILED");
+            if (!pass)
+                failed++;
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,268 @@
+//
+// Description : Dense grid evaluation of cellular noise, cellular() from
+//               ../src/cellular2D.glsl and ../src/cellular3D.glsl, with
+//               the feature points computed once per lattice cell.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// Evaluated point by point, every sample hashes the 9 or 27 cells around
+// it, and so do all its neighbours in the same cell. Here the feature
+// point offsets of all cells within reach of a tile are computed first,
+// W cells at a time, into a small table per coordinate. What is left per
+// sample is the distance to each neighbouring feature point, with the
+// offsets read from the table.
+//
+// Within a vector of samples that share a cell, the 9 or 27 feature
+// points are the same for all lanes. A vector that crosses into the
+// next cell is done once per cell, keeping the lanes in that cell. The
+// hashes only depend on the lattice coordinates modulo 289, and the
+// distances are computed with the same arithmetic as in cellular(), so
+// the results are the same as point by point, bit for bit.
+//
+
+#ifndef WEBGLNOISE_GRIDCELLULAR_H
+#define WEBGLNOISE_GRIDCELLULAR_H
+
+#include "buffer.h"
+#include "cellular3D.h"
+#include "tiles.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Tables for the grid lines along one axis of a tile, padded to whole
+// vectors. The cells within reach of the tile are numbered from 0, the
+// one left of the lowest cell with a sample.
+struct CellAxis {
+    Buffer<float> f;    // Fractional part, per sample
+    Buffer<float> cell; // Number of the cell of each sample
+    Buffer<float> i;    // Wrapped lattice coordinate, per cell
+};
+
+// Fill the tables for grid lines first .. first + n - 1 along axis d,
+// with the fractional parts less centre, as Pf in cellular()
+template <class V>
+static void cell_axis(CellAxis &a, const Grid &grid, int d, int first, int n,
+                      float centre) {
+    enum { W = V::width };
+    int pitch = (n + W - 1) / W * W;
+    Buffer<float> fl(pitch);
+    a.f.resize(pitch);
+    a.cell.resize(pitch);
+    for (int i = 0; i < pitch; i++)
+        a.f[i] = grid_line(grid, d, first + i);
+    for (int i = 0; i < pitch; i += W) {
+        V P = load(&a.f[i]);
+        store(&fl[i], floor(P));
+        store(&a.f[i], fract(P) - centre);
+    }
+
+    float lo = fl[0], hi = fl[0];
+    for (int i = 1; i < pitch; i++) {
+        lo = fl[i] < lo ? fl[i] : lo;
+        hi = fl[i] > hi ? fl[i] : hi;
+    }
+    for (int i = 0; i < pitch; i++)
+        a.cell[i] = fl[i] - lo + 1.0f;
+    int cells = (int)(hi - lo) + 3, padded = (cells + W - 1) / W * W;
+    a.i.resize(padded);
+    for (int c = 0; c < padded; c++)
+        a.i[c] = lo - 1.0f + (float)c;
+    for (int c = 0; c < padded; c += W)
+        store(&a.i[c], mod289(load(&a.i[c])));
+    a.i.resize(cells);
+}
+
+// The first and last cell of the vector of samples at i, in either order
+static inline void cell_range(const CellAxis &a, int i, int w, int &c0, int &c1) {
+    c0 = (int)a.cell[i];
+    c1 = (int)a.cell[i + w - 1];
+    if (c0 > c1) {
+        int c = c0;
+        c0 = c1;
+        c1 = c;
+    }
+}
+
+// Squared F1 and F2 of the samples in a row, in f1 and f2, using the 3x3
+// cells centred on cell cy of the feature table ox, oy (ncx cells wide)
+template <class V>
+static void cellular2_row(const CellAxis &ax, float pfy, int cy, int ncx,
+                          const float *ox, const float *oy, float *f1, float *f2) {
+    enum { W = V::width };
+    const float jitter = 1.0f; // As in cellular()
+    V Pfy = V(pfy);
+    for (size_t i = 0; i < ax.f.size(); i += W) {
+        int c0, c1;
+        cell_range(ax, (int)i, W, c0, c1);
+        V Pfx = load(&ax.f[i]), F1, F2;
+        for (int c = c0; c <= c1; c++) {
+            V G1 = V(1e30f), G2 = V(1e30f);
+            for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++) {
+                    size_t q = (size_t)(cy + b - 1) * ncx + c + a - 1;
+                    V dx = Pfx - (a - 0.5f) + jitter * V(ox[q]);
+                    V dy = Pfy - (b - 0.5f) + jitter * V(oy[q]);
+                    insert(dx * dx + dy * dy, G1, G2);
+                }
+            if (c == c0) {
+                F1 = G1;
+                F2 = G2;
+            } else {
+                auto in = lessThan(abs(load(&ax.cell[i]) - (float)c), V(0.5f));
+                F1 = select(in, G1, F1);
+                F2 = select(in, G2, F2);
+            }
+        }
+        store(f1 + i, F1);
+        store(f2 + i, F2);
+    }
+}
+
+// The same in 3D, with the 3x3x3 cells centred on (cy, cz) of a feature
+// table ncx by ncy cells across
+template <class V>
+static void cellular3_row(const CellAxis &ax, float pfy, float pfz, int cy, int cz,
+                          int ncx, int ncy, const float *ox, const float *oy,
+                          const float *oz, float *f1, float *f2) {
+    enum { W = V::width };
+    const float jitter = 1.0f; // As in cellular()
+    V Pfy = V(pfy), Pfz = V(pfz);
+    for (size_t i = 0; i < ax.f.size(); i += W) {
+        int c0, c1;
+        cell_range(ax, (int)i, W, c0, c1);
+        V Pfx = load(&ax.f[i]), F1, F2;
+        for (int c = c0; c <= c1; c++) {
+            V G1 = V(1e30f), G2 = V(1e30f);
+            for (int k = 0; k < 3; k++)
+                for (int j = 0; j < 3; j++)
+                    for (int a = 0; a < 3; a++) {
+                        size_t q = ((size_t)(cz + k - 1) * ncy + cy + j - 1) * ncx + c + a - 1;
+                        V dx = Pfx + (float)(1 - a) + jitter * V(ox[q]);
+                        V dy = Pfy + (float)(1 - j) + jitter * V(oy[q]);
+                        V dz = Pfz + (float)(1 - k) + jitter * V(oz[q]);
+                        insert(dx * dx + dy * dy + dz * dz, G1, G2);
+                    }
+            if (c == c0) {
+                F1 = G1;
+                F2 = G2;
+            } else {
+                auto in = lessThan(abs(load(&ax.cell[i]) - (float)c), V(0.5f));
+                F1 = select(in, G1, F1);
+                F2 = select(in, G2, F2);
+            }
+        }
+        store(f1 + i, F1);
+        store(f2 + i, F2);
+    }
+}
+
+// Take the square roots of a row of squared distances, unless squared
+template <class V>
+static void distances(float *row, size_t pitch, bool squared) {
+    enum { W = V::width };
+    if (!squared)
+        for (size_t i = 0; i < pitch; i += W)
+            store(row + i, sqrt(load(row + i)));
+}
+
+// Copy row j of slice k of a tile to an image
+static void put_row(const Image &image, const Tile &tile, int j, int k, const float *row) {
+    float *out = image.data + ((size_t)k * image.height + j) * image.pitch + tile.x0;
+    for (int i = 0; i < tile.x1 - tile.x0; i++)
+        out[i] = row[i];
+}
+
+// cellular(vec2) at (x, y) for every slice of the tile, F1 to f1 and F2
+// to f2, unless f2.data is null
+template <class V>
+static void cellular2_cached(const Image &f1, const Image &f2, const Grid &grid,
+                             const Tile &tile, bool squared) {
+    enum { W = V::width };
+    CellAxis ax, ay;
+    int nx = tile.x1 - tile.x0, ny = tile.y1 - tile.y0;
+    cell_axis<V>(ax, grid, 0, tile.x0, nx, 0.0f);
+    cell_axis<V>(ay, grid, 1, tile.y0, ny, 0.0f);
+    int ncx = (int)ax.i.size(), ncy = (int)ay.i.size();
+
+    // Feature point offsets of every cell, W at a time, as in cellular()
+    size_t m = (size_t)ncx * ncy, padded = (m + W - 1) / W * W;
+    Buffer<float> ox(padded), oy(padded);
+    for (size_t q = 0; q < m; q++) {
+        ox[q] = ax.i[q % ncx];
+        oy[q] = ay.i[q / ncx];
+    }
+    for (size_t q = 0; q < padded; q += W) {
+        V x, y;
+        feature2(permute(permute(load(&ox[q])) + load(&oy[q])), x, y);
+        store(&ox[q], x);
+        store(&oy[q], y);
+    }
+
+    size_t pitch = ax.f.size();
+    Buffer<float> r1(pitch), r2(pitch);
+    for (int j = 0; j < ny; j++) {
+        cellular2_row<V>(ax, ay.f[j], (int)ay.cell[j], ncx, ox.data(), oy.data(),
+                         r1.data(), r2.data());
+        distances<V>(r1.data(), pitch, squared);
+        if (f2.data)
+            distances<V>(r2.data(), pitch, squared);
+        for (int k = tile.z0; k < tile.z1; k++) {
+            put_row(f1, tile, tile.y0 + j, k, r1.data());
+            if (f2.data)
+                put_row(f2, tile, tile.y0 + j, k, r2.data());
+        }
+    }
+}
+
+// cellular(vec3), F1 to f1 and F2 to f2, unless f2.data is null
+template <class V>
+static void cellular3_cached(const Image &f1, const Image &f2, const Grid &grid,
+                             const Tile &tile, bool squared) {
+    enum { W = V::width };
+    CellAxis ax, ay, az;
+    int nx = tile.x1 - tile.x0, ny = tile.y1 - tile.y0, nz = tile.z1 - tile.z0;
+    cell_axis<V>(ax, grid, 0, tile.x0, nx, 0.5f);
+    cell_axis<V>(ay, grid, 1, tile.y0, ny, 0.5f);
+    cell_axis<V>(az, grid, 2, tile.z0, nz, 0.5f);
+    int ncx = (int)ax.i.size(), ncy = (int)ay.i.size(), ncz = (int)az.i.size();
+
+    // Feature point offsets of every cell, W at a time, as in cellular()
+    size_t m = (size_t)ncx * ncy * ncz, padded = (m + W - 1) / W * W;
+    Buffer<float> ox(padded), oy(padded), oz(padded);
+    for (size_t q = 0; q < m; q++) {
+        ox[q] = ax.i[q % ncx];
+        oy[q] = ay.i[q / ncx % ncy];
+        oz[q] = az.i[q / ncx / ncy];
+    }
+    for (size_t q = 0; q < padded; q += W) {
+        V x, y, z;
+        feature3(permute(permute(permute(load(&ox[q])) + load(&oy[q])) + load(&oz[q])),
+                 x, y, z);
+        store(&ox[q], x);
+        store(&oy[q], y);
+        store(&oz[q], z);
+    }
+
+    size_t pitch = ax.f.size();
+    Buffer<float> r1(pitch), r2(pitch);
+    for (int k = 0; k < nz; k++)
+        for (int j = 0; j < ny; j++) {
+            cellular3_row<V>(ax, ay.f[j], az.f[k], (int)ay.cell[j], (int)az.cell[k],
+                             ncx, ncy, ox.data(), oy.data(), oz.data(),
+                             r1.data(), r2.data());
+            distances<V>(r1.data(), pitch, squared);
+            put_row(f1, tile, tile.y0 + j, tile.z0 + k, r1.data());
+            if (f2.data) {
+                distances<V>(r2.data(), pitch, squared);
+                put_row(f2, tile, tile.y0 + j, tile.z0 + k, r2.data());
+            }
+        }
+}
+
+}
+}
+
+#endif
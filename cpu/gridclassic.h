@@ -0,0 +1,241 @@
+//
+// Description : Dense grid evaluation of classic Perlin noise, cnoise()
+//               and pnoise() from ../src/classicnoise2D.glsl and
+//               ../src/classicnoise3D.glsl, one axis at a time.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// Classic noise is separable on a grid. The fractional part of a sample
+// and its fade() weight along one axis depend only on the coordinate
+// along that axis, and the corner gradients only change where the
+// samples cross a lattice line. So for each tile, the fractional parts,
+// fade weights and wrapped lattice coordinates are computed once per
+// grid line along every axis, and the corner gradients once per lattice
+// cell that the tile touches.
+//
+// Within a row of the tile, the y and z weights are constant, and the
+// blend of the corner values in a cell reduces to
+//
+//     mix(a0 * fx + b0, a1 * (fx - 1) + b1, fade(fx))
+//
+// with four coefficients per cell and row. That leaves a few multiply-
+// adds per sample, with the vector instructions going along the rows.
+// The gradients are computed with the same arithmetic as in cnoise()
+// and pnoise(), at the same coordinates, but the blend is summed in a
+// different order, so the results differ from the point by point kernels
+// by a few ULP.
+//
+
+#ifndef WEBGLNOISE_GRIDCLASSIC_H
+#define WEBGLNOISE_GRIDCLASSIC_H
+
+#include "buffer.h"
+#include "classicnoise3D.h"
+#include "tiles.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Tables for the grid lines along one axis of a tile, padded to whole
+// vectors. Samples in the same lattice cell form runs, numbered in order.
+struct Axis {
+    Buffer<float> f, u;   // Fractional part and its fade, per sample
+    Buffer<float> cell;   // Number of the cell of each sample
+    Buffer<float> i0, i1; // Wrapped lattice coordinates, per cell
+};
+
+// Fill the tables for grid lines first .. first + n - 1 along axis d.
+// A period rep of 0 means none (cnoise). Otherwise the lattice
+// coordinates are wrapped as in pnoise(), where the 3D shader wraps
+// Pi0 + 1 after Pi0 (nested) and the 2D shader wraps floor(P) + 1.
+template <class V>
+static void axis(Axis &a, const Grid &grid, int d, int first, int n,
+                 float rep, bool nested) {
+    enum { W = V::width };
+    int pitch = (n + W - 1) / W * W;
+    Buffer<float> fl(pitch), i0(pitch), i1(pitch);
+    a.f.resize(pitch);
+    a.u.resize(pitch);
+    for (int i = 0; i < pitch; i++)
+        a.f[i] = grid_line(grid, d, first + i);
+    for (int i = 0; i < pitch; i += W) {
+        V P = load(&a.f[i]), Pi0 = floor(P), Pi1 = Pi0 + 1.0f;
+        store(&fl[i], Pi0);
+        if (rep != 0.0f) {
+            Pi1 = mod(nested ? mod(Pi0, V(rep)) + 1.0f : Pi1, V(rep));
+            Pi0 = mod(Pi0, V(rep));
+        }
+        store(&i0[i], mod289(Pi0));
+        store(&i1[i], mod289(Pi1));
+        V Pf = fract(P);
+        store(&a.f[i], Pf);
+        store(&a.u[i], fade(Pf));
+    }
+
+    a.cell.resize(pitch);
+    a.i0.clear();
+    a.i1.clear();
+    for (int i = 0; i < pitch; i++) {
+        if (i == 0 || fl[i] != fl[i - 1]) {
+            a.i0.push_back(i0[i]);
+            a.i1.push_back(i1[i]);
+        }
+        a.cell[i] = (float)(a.i0.size() - 1);
+    }
+}
+
+// The blend of one cell along a row, with the weights of the other axes
+// already applied
+struct Blend {
+    float a0, b0, a1, b1;
+};
+
+template <class V>
+static inline V blend(const Blend &c, V f, V u) {
+    return mix(f * c.a0 + c.b0, (f - 1.0f) * c.a1 + c.b1, u);
+}
+
+template <class V>
+static void blend_row(const Axis &ax, const Blend *cells, float *row) {
+    enum { W = V::width };
+    for (size_t i = 0; i < ax.f.size(); i += W) {
+        int first = (int)ax.cell[i], last = (int)ax.cell[i + W - 1];
+        V f = load(&ax.f[i]), u = load(&ax.u[i]);
+        V r = blend(cells[first], f, u);
+        // A vector that crosses into the next cell(s)
+        for (int c = first + 1; c <= last; c++)
+            r = select(lessThan(V(c - 0.5f), load(&ax.cell[i])), blend(cells[c], f, u), r);
+        store(row + i, r);
+    }
+}
+
+// cnoise(vec2) if rep is null, otherwise pnoise(vec2, rep), at (x, y)
+// for every slice of the tile
+template <class V>
+static void cnoise2_separable(const Image &image, const Grid &grid, const Tile &tile,
+                              const float *rep) {
+    enum { W = V::width };
+    Axis ax, ay;
+    int nx = tile.x1 - tile.x0, ny = tile.y1 - tile.y0;
+    axis<V>(ax, grid, 0, tile.x0, nx, rep ? rep[0] : 0.0f, false);
+    axis<V>(ay, grid, 1, tile.y0, ny, rep ? rep[1] : 0.0f, false);
+    int ncx = (int)ax.i0.size(), ncy = (int)ay.i0.size();
+
+    // Corners 00, 10, 01, 11 of every cell, W at a time, as in classic()
+    size_t m = (size_t)ncx * ncy * 4, padded = (m + W - 1) / W * W;
+    Buffer<float> gx(padded), gy(padded), norm(padded);
+    for (int cy = 0; cy < ncy; cy++)
+        for (int cx = 0; cx < ncx; cx++)
+            for (int c = 0; c < 4; c++) {
+                size_t q = ((size_t)cy * ncx + cx) * 4 + c;
+                gx[q] = c & 1 ? ax.i1[cx] : ax.i0[cx];
+                gy[q] = c >> 1 ? ay.i1[cy] : ay.i0[cy];
+            }
+    for (size_t q = 0; q < padded; q += W) {
+        V i = permute(permute(load(&gx[q])) + load(&gy[q]));
+        V x = fract(i * (1.0f / 41.0f)) * 2.0f - 1.0f;
+        V y = abs(x) - 0.5f;
+        x = x - floor(x + 0.5f);
+        store(&gx[q], x);
+        store(&gy[q], y);
+        store(&norm[q], taylorInvSqrt(x * x + y * y));
+    }
+    // The shader swaps the norms of corners 10 and 01, see classic()
+    for (size_t q = 0; q < m; q += 4)
+        for (int c = 0; c < 4; c++) {
+            float s = 2.3f * norm[q + (c == 1 ? 2 : c == 2 ? 1 : c)];
+            gx[q + c] *= s;
+            gy[q + c] *= s;
+        }
+
+    Buffer<Blend> cells(ncx);
+    Buffer<float> row(ax.f.size());
+    for (int j = 0; j < ny; j++) {
+        float fy = ay.f[j], w[2] = { 1.0f - ay.u[j], ay.u[j] };
+        const float *g = &gx[(size_t)ay.cell[j] * ncx * 4];
+        const float *h = &gy[(size_t)ay.cell[j] * ncx * 4];
+        for (int cx = 0; cx < ncx; cx++, g += 4, h += 4) {
+            cells[cx].a0 = w[0] * g[0] + w[1] * g[2];
+            cells[cx].a1 = w[0] * g[1] + w[1] * g[3];
+            cells[cx].b0 = w[0] * h[0] * fy + w[1] * h[2] * (fy - 1.0f);
+            cells[cx].b1 = w[0] * h[1] * fy + w[1] * h[3] * (fy - 1.0f);
+        }
+        blend_row<V>(ax, cells.data(), row.data());
+        for (int k = tile.z0; k < tile.z1; k++) {
+            float *out = image.data + ((size_t)k * image.height + tile.y0 + j)
+                * image.pitch + tile.x0;
+            for (int i = 0; i < nx; i++)
+                out[i] = row[i];
+        }
+    }
+}
+
+// cnoise(vec3) if rep is null, otherwise pnoise(vec3, rep)
+template <class V>
+static void cnoise3_separable(const Image &image, const Grid &grid, const Tile &tile,
+                              const float *rep) {
+    enum { W = V::width };
+    Axis ax, ay, az;
+    int nx = tile.x1 - tile.x0, ny = tile.y1 - tile.y0, nz = tile.z1 - tile.z0;
+    axis<V>(ax, grid, 0, tile.x0, nx, rep ? rep[0] : 0.0f, true);
+    axis<V>(ay, grid, 1, tile.y0, ny, rep ? rep[1] : 0.0f, true);
+    axis<V>(az, grid, 2, tile.z0, nz, rep ? rep[2] : 0.0f, true);
+    int ncx = (int)ax.i0.size(), ncy = (int)ay.i0.size(), ncz = (int)az.i0.size();
+
+    // The eight corners of every cell, W at a time, as in classic(),
+    // normalised and with the final scaling by 2.2 folded in
+    size_t m = (size_t)ncx * ncy * ncz * 8, padded = (m + W - 1) / W * W;
+    Buffer<float> gx(padded), gy(padded), gz(padded);
+    for (int cz = 0; cz < ncz; cz++)
+        for (int cy = 0; cy < ncy; cy++)
+            for (int cx = 0; cx < ncx; cx++)
+                for (int c = 0; c < 8; c++) {
+                    size_t q = (((size_t)cz * ncy + cy) * ncx + cx) * 8 + c;
+                    gx[q] = c & 1 ? ax.i1[cx] : ax.i0[cx];
+                    gy[q] = (c >> 1) & 1 ? ay.i1[cy] : ay.i0[cy];
+                    gz[q] = c >> 2 ? az.i1[cz] : az.i0[cz];
+                }
+    for (size_t q = 0; q < padded; q += W) {
+        V x, y, z;
+        cgrad3(permute(permute(permute(load(&gx[q])) + load(&gy[q])) + load(&gz[q])),
+               x, y, z);
+        V norm = taylorInvSqrt(x * x + y * y + z * z) * 2.2f;
+        store(&gx[q], x * norm);
+        store(&gy[q], y * norm);
+        store(&gz[q], z * norm);
+    }
+
+    Buffer<Blend> cells(ncx);
+    Buffer<float> row(ax.f.size());
+    for (int k = 0; k < nz; k++) {
+        float fz[2] = { az.f[k], az.f[k] - 1.0f };
+        float wz[2] = { 1.0f - az.u[k], az.u[k] };
+        for (int j = 0; j < ny; j++) {
+            float fy[2] = { ay.f[j], ay.f[j] - 1.0f };
+            float wy[2] = { 1.0f - ay.u[j], ay.u[j] };
+            size_t q = ((size_t)az.cell[k] * ncy + (size_t)ay.cell[j]) * ncx * 8;
+            for (int cx = 0; cx < ncx; cx++, q += 8) {
+                float a[2] = { 0.0f, 0.0f }, b[2] = { 0.0f, 0.0f };
+                for (int c = 0; c < 8; c++) {
+                    int bx = c & 1, by = (c >> 1) & 1, bz = c >> 2;
+                    float w = wy[by] * wz[bz];
+                    a[bx] += w * gx[q + c];
+                    b[bx] += w * (gy[q + c] * fy[by] + gz[q + c] * fz[bz]);
+                }
+                cells[cx] = { a[0], b[0], a[1], b[1] };
+            }
+            blend_row<V>(ax, cells.data(), row.data());
+            float *out = image.data + ((size_t)(tile.z0 + k) * image.height + tile.y0 + j)
+                * image.pitch + tile.x0;
+            for (int i = 0; i < nx; i++)
+                out[i] = row[i];
+        }
+    }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,162 @@
+//
+// Description : Dense grid evaluation of 3D simplex noise, snoise(vec3)
+//               from ../src/noise3D.glsl, by splatting.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// snoise() is a sum of one kernel per simplex lattice vertex,
+// 105 * max(0.5 - r^2, 0)^4 * dot(g, x), where x is the offset from the
+// vertex and g its gradient. With r^2 < 0.5 the kernel of a vertex
+// never reaches outside the simplices that share it, so the four
+// corners of the simplex around a point are the only vertices that
+// contribute to it.
+//
+// Evaluated point by point, every grid point hashes its four corners
+// and computes their gradients again. Here the loops are turned around:
+// each vertex near a tile gets its gradient computed once, and then adds
+// its kernel to all grid points of the tile within its radius, one row
+// at a time, with the vector instructions going along the rows. That
+// leaves a few multiply-adds per grid point and vertex.
+//
+// The hash of a vertex is computed from its integer coordinates modulo
+// 289. That is what the float arithmetic of permute() in the shader
+// gives, as it is exact for all values that occur, so every vertex gets
+// the same gradient as in snoise(). The offsets x are rounded a little
+// differently, so the results differ from snoise3() by a few ULP.
+//
+
+#ifndef WEBGLNOISE_GRIDSIMPLEX3D_H
+#define WEBGLNOISE_GRIDSIMPLEX3D_H
+
+#include <math.h>
+#include "buffer.h"
+#include "noise3D.h"
+#include "tiles.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// The permute() chain of the shader for lattice vertex (ix, iy, iz)
+static inline int hash289(int ix, int iy, int iz) {
+    auto mod = [](int a) { a %= 289; return a < 0 ? a + 289 : a; };
+    auto perm = [](int a) { return (a * 34 + 10) * a % 289; };
+    return perm(perm(perm(mod(iz)) + mod(iy)) + mod(ix));
+}
+
+// Grid lines lo .. hi along one axis that may be within distance w of
+// the coordinate c, for grid lines at x0 + i * step, 0 <= i < n. This
+// errs on the side of too many, as the kernels are zero outside their
+// radius anyway.
+static inline void span(float c, float w, float x0, float step, int n, int &lo, int &hi) {
+    if (step == 0.0f) {
+        lo = 0;
+        hi = fabsf(x0 - c) < w ? n - 1 : -1;
+        return;
+    }
+    float a = (c - w - x0) / step, b = (c + w - x0) / step;
+    lo = (int)fmaxf(floorf(fminf(a, b)), 0.0f);
+    hi = (int)fminf(ceilf(fmaxf(a, b)), (float)(n - 1));
+}
+
+template <class V>
+static void snoise3_splat(const Image &image, const Grid &grid, const Tile &tile) {
+    enum { W = V::width };
+    const float F3 = 1.0f / 3.0f, G3 = 1.0f / 6.0f;
+    const float R = 0.7072f; // sqrt(0.5), rounded up
+
+    int nx = tile.x1 - tile.x0, ny = tile.y1 - tile.y0, nz = tile.z1 - tile.z0;
+    int pitch = (nx + W - 1) / W * W;
+
+    // Coordinates of the grid points of the tile
+    Buffer<float> xs(pitch), ys(ny), zs(nz);
+    for (int i = 0; i < pitch; i++)
+        xs[i] = grid_line(grid, 0, tile.x0 + i);
+    for (int j = 0; j < ny; j++)
+        ys[j] = grid_line(grid, 1, tile.y0 + j);
+    for (int k = 0; k < nz; k++)
+        zs[k] = grid_line(grid, 2, tile.z0 + k);
+
+    // Bounding box of the tile, grown by the kernel radius
+    float lo[3] = { fminf(xs[0], xs[nx - 1]) - R, fminf(ys[0], ys[ny - 1]) - R,
+                    fminf(zs[0], zs[nz - 1]) - R };
+    float hi[3] = { fmaxf(xs[0], xs[nx - 1]) + R, fmaxf(ys[0], ys[ny - 1]) + R,
+                    fmaxf(zs[0], zs[nz - 1]) + R };
+
+    // Vertices in the box. Skewing is increasing in all coordinates, so
+    // the skewed box corners bound the integer coordinates.
+    float slo = (lo[0] + lo[1] + lo[2]) * F3, shi = (hi[0] + hi[1] + hi[2]) * F3;
+    Buffer<float> vx, vy, vz, vt, vh;
+    for (int iz = (int)floorf(lo[2] + slo); iz <= (int)ceilf(hi[2] + shi); iz++)
+        for (int iy = (int)floorf(lo[1] + slo); iy <= (int)ceilf(hi[1] + shi); iy++)
+            for (int ix = (int)floorf(lo[0] + slo); ix <= (int)ceilf(hi[0] + shi); ix++) {
+                float t = (float)(ix + iy + iz) * G3;
+                float px = ix - t, py = iy - t, pz = iz - t;
+                if (px < lo[0] || px > hi[0] || py < lo[1] || py > hi[1]
+                    || pz < lo[2] || pz > hi[2])
+                    continue;
+                vx.push_back((float)ix);
+                vy.push_back((float)iy);
+                vz.push_back((float)iz);
+                vt.push_back(t);
+                vh.push_back((float)hash289(ix, iy, iz));
+            }
+
+    // Normalised gradients, W vertices at a time, with the final
+    // scaling by 105 folded in
+    size_t nv = vh.size();
+    vh.resize((nv + W - 1) / W * W, 0.0f);
+    Buffer<float> gx(vh.size()), gy(vh.size()), gz(vh.size());
+    for (size_t v = 0; v < vh.size(); v += W) {
+        V x, y, z;
+        grad3(load(&vh[v]), x, y, z);
+        store(&gx[v], x * 105.0f);
+        store(&gy[v], y * 105.0f);
+        store(&gz[v], z * 105.0f);
+    }
+
+    // Add up the kernels in a buffer with rows padded to whole vectors
+    Buffer<float> sum((size_t)pitch * ny * nz, 0.0f);
+    for (size_t v = 0; v < nv; v++) {
+        float t = vt[v];
+        int k0, k1;
+        span(vz[v] - t, R, zs[0], grid.step[2], nz, k0, k1);
+        for (int k = k0; k <= k1; k++) {
+            float dz = zs[k] - vz[v] + t;
+            int j0, j1;
+            span(vy[v] - t, R, ys[0], grid.step[1], ny, j0, j1);
+            for (int j = j0; j <= j1; j++) {
+                float dy = ys[j] - vy[v] + t;
+                // 0.5 - r^2, before adding x^2
+                float rem = 0.5f - (dy * dy + dz * dz);
+                if (rem <= 0.0f)
+                    continue;
+                int i0, i1;
+                span(vx[v] - t, sqrtf(rem), xs[0], grid.step[0], nx, i0, i1);
+                float c = gy[v] * dy + gz[v] * dz;
+                float *row = &sum[((size_t)k * ny + j) * pitch];
+                for (int i = i0 / W * W; i <= i1; i += W) {
+                    V x = load(&xs[i]) - vx[v] + t;
+                    V m = max(rem - x * x, V(0.0f));
+                    m = m * m;
+                    store(row + i, load(row + i) + m * m * (gx[v] * x + c));
+                }
+            }
+        }
+    }
+
+    for (int k = 0; k < nz; k++)
+        for (int j = 0; j < ny; j++) {
+            const float *row = &sum[((size_t)k * ny + j) * pitch];
+            float *out = image.data + ((size_t)(tile.z0 + k) * image.height + tile.y0 + j)
+                * image.pitch + tile.x0;
+            for (int i = 0; i < nx; i++)
+                out[i] = row[i];
+        }
+}
+
+}
+}
+
+#endif
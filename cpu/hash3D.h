@@ -0,0 +1,108 @@
+//
+// Description : Alternative lattice hashes for the C++ port of 3D simplex
+//               noise, to use in place of PermuteHash (noise3D.h).
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// A hash policy has two members: wrap(i), applied once to the integer
+// part of the skewed point, and grad(ix, iy, iz, gx, gy, gz), which
+// gives the normalised gradient of one lattice vertex. snoise(x, y, z,
+// hash) is compiled separately for each policy, so the choice costs
+// nothing at run time.
+//
+// PermuteHash is the shader's arithmetic, and the one to use for
+// results that match the GPU. TableHash looks the same permutation and
+// gradients up in tables instead of computing them, and gives the same
+// results bit for bit. Int32Hash is an integer hash of the unwrapped
+// coordinates, with the same set of gradients but a different pattern,
+// and without the period of 289 of the polynomial.
+//
+
+#ifndef WEBGLNOISE_HASH3D_H
+#define WEBGLNOISE_HASH3D_H
+
+#include "noise3D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Call f(i, k) for the indices i = k .. k + W - 1 of tables of n entries
+// (n a multiple of W), to fill them W entries at a time
+template <class V, class F>
+static inline void tabulate(int n, F f) {
+    enum { W = V::width };
+    for (int i = 0; i < n; i += W) {
+        float index[W];
+        for (int k = 0; k < W; k++)
+            index[k] = (float)(i + k);
+        f(load(index), i);
+    }
+}
+
+// The permutation polynomial and grad3() from lookup tables, with the
+// last round of the permutation folded into the gradient tables. Wrapped
+// coordinates are at most 290 (mod289() may give 289 instead of 0, and
+// a corner adds 1), so the sums fed to the permutation stay below 592.
+template <class V>
+struct TableHash {
+    float perm[592];
+    float gx[592], gy[592], gz[592];
+
+    TableHash() {
+        tabulate<V>(592, [this](V i, int k) {
+            V x, y, z;
+            store(perm + k, permute(i));
+            grad3(permute(i), x, y, z);
+            store(gx + k, x);
+            store(gy + k, y);
+            store(gz + k, z);
+        });
+    }
+
+    V wrap(V i) const { return mod289(i); }
+    void grad(V ix, V iy, V iz, V &x, V &y, V &z) const {
+        vuint p = toUint(gather(perm, toUint(gather(perm, toUint(iz)) + iy)) + ix);
+        x = gather(gx, p);
+        y = gather(gy, p);
+        z = gather(gz, p);
+    }
+};
+
+// A 32-bit integer hash of the unwrapped coordinates (the finaliser of
+// a multiplicative hash), mapped onto the 49 gradients of grad3()
+template <class V>
+struct Int32Hash {
+    float gx[64], gy[64], gz[64];
+
+    Int32Hash() {
+        tabulate<V>(64, [this](V i, int k) {
+            V x, y, z;
+            grad3(i, x, y, z);
+            store(gx + k, x);
+            store(gy + k, y);
+            store(gz + k, z);
+        });
+    }
+
+    V wrap(V i) const { return i; }
+    void grad(V ix, V iy, V iz, V &x, V &y, V &z) const {
+        vuint h = (toUint(ix) * 0x8da6b343u) ^ (toUint(iy) * 0xd8163841u)
+                ^ (toUint(iz) * 0xcb1ab31fu);
+        h = h ^ (h >> 16);
+        h = h * 0x7feb352du;
+        h = h ^ (h >> 15);
+        h = h * 0x846ca68bu;
+        h = h ^ (h >> 16);
+        vuint j = ((h >> 16) * 49u) >> 16; // Top bits scaled to 0 .. 48
+        x = lookup64(gx, j);
+        y = lookup64(gy, j);
+        z = lookup64(gz, j);
+    }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,42 @@
+//
+// Description : Helper functions shared by the CPU noise kernels,
+//               ported from the GLSL files in ../src.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+
+#ifndef WEBGLNOISE_HELPERS_H
+#define WEBGLNOISE_HELPERS_H
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Modulo 289 without a division (only multiplications)
+template <class V>
+static inline V mod289(V x) {
+    return x - floor(x * (1.0f / 289.0f)) * 289.0f;
+}
+
+// Permutation polynomial: (34x^2 + 10x) mod 289
+template <class V>
+static inline V permute(V x) {
+    return mod289(((x * 34.0f) + 10.0f) * x);
+}
+
+// Modulo 7 without a division
+template <class V>
+static inline V mod7(V x) {
+    return x - floor(x * (1.0f / 7.0f)) * 7.0f;
+}
+
+template <class V>
+static inline V taylorInvSqrt(V r) {
+    return 1.79284291400159f - 0.85373472095314f * r;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,562 @@
+//
+// Description : Batch drivers for the noise kernels. This file is
+//               compiled once per instruction set, with WEBGLNOISE_ISA
+//               naming the namespace of that build, see Makefile.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+
+#include <math.h>
+#include <string.h>
+#include "kernels.h"
+#include "simd.h"
+#include "noise2D.h"
+#include "noise3D.h"
+#include "noise4D.h"
+#include "classicnoise2D.h"
+#include "classicnoise3D.h"
+#include "classicnoise4D.h"
+#include "psnoise3D.h"
+#include "psnoise4D.h"
+#include "psrdnoise3D.h"
+#include "curlnoise3D.h"
+#include "cellular2D.h"
+#include "cellular3D.h"
+#include "fbm3D.h"
+#include "hash3D.h"
+#include "gridsimplex3D.h"
+#include "gridclassic.h"
+#include "gridcellular.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+enum { W = vfloat::width };
+
+// Run a kernel over arrays of points, W points at a time. The last
+// few points are copied to zero padded buffers, so any array length
+// works without reading or writing outside of the arrays.
+template <int N, class F>
+static inline void batch(F f, const float *const *in, float *out, size_t n) {
+    size_t k = 0;
+    for (; k + W <= n; k += W) {
+        vfloat v[N];
+        for (int d = 0; d < N; d++)
+            v[d] = load(in[d] + k);
+        store(out + k, f(v));
+    }
+    if (k < n) {
+        float buf[N][W] = {}, res[W];
+        vfloat v[N];
+        for (int d = 0; d < N; d++) {
+            memcpy(buf[d], in[d] + k, (n - k) * sizeof(float));
+            v[d] = load(buf[d]);
+        }
+        store(res, f(v));
+        memcpy(out + k, res, (n - k) * sizeof(float));
+    }
+}
+
+// The same for kernels with M outputs, which f(v, r) stores in r[0 .. M-1]
+template <int N, int M, class F>
+static inline void batch(F f, const float *const *in, float *const *out, size_t n) {
+    size_t k = 0;
+    for (; k + W <= n; k += W) {
+        vfloat v[N], r[M];
+        for (int d = 0; d < N; d++)
+            v[d] = load(in[d] + k);
+        f(v, r);
+        for (int d = 0; d < M; d++)
+            store(out[d] + k, r[d]);
+    }
+    if (k < n) {
+        float buf[N][W] = {}, res[W];
+        vfloat v[N], r[M];
+        for (int d = 0; d < N; d++) {
+            memcpy(buf[d], in[d] + k, (n - k) * sizeof(float));
+            v[d] = load(buf[d]);
+        }
+        f(v, r);
+        for (int d = 0; d < M; d++) {
+            store(res, r[d]);
+            memcpy(out[d] + k, res, (n - k) * sizeof(float));
+        }
+    }
+}
+
+static void snoise2(const float *x, const float *y, float *out, size_t n) {
+    const float *in[] = { x, y };
+    batch<2>([](const vfloat *v) { return snoise(v[0], v[1]); }, in, out, n);
+}
+
+static void snoise3(const float *x, const float *y, const float *z,
+                    float *out, size_t n) {
+    const float *in[] = { x, y, z };
+    batch<3>([](const vfloat *v) { return snoise(v[0], v[1], v[2]); }, in, out, n);
+}
+
+// The lookup tables of the hashes are filled on first use
+static void snoise3_table(const float *x, const float *y, const float *z,
+                          float *out, size_t n) {
+    static const TableHash<vfloat> hash;
+    const float *in[] = { x, y, z };
+    batch<3>([&](const vfloat *v) { return snoise(v[0], v[1], v[2], hash); }, in, out, n);
+}
+
+static void snoise3_int32(const float *x, const float *y, const float *z,
+                          float *out, size_t n) {
+    static const Int32Hash<vfloat> hash;
+    const float *in[] = { x, y, z };
+    batch<3>([&](const vfloat *v) { return snoise(v[0], v[1], v[2], hash); }, in, out, n);
+}
+
+static void snoise3v(const float *x, const float *y, const float *z,
+                     float *outx, float *outy, float *outz, size_t n) {
+    const float *in[] = { x, y, z };
+    float *outs[] = { outx, outy, outz };
+    batch<3, 3>([](const vfloat *v, vfloat *r) { snoisev<3>(v[0], v[1], v[2], r); },
+                in, outs, n);
+}
+
+static void snoise4v(const float *x, const float *y, const float *z,
+                     float *outx, float *outy, float *outz, float *outw, size_t n) {
+    const float *in[] = { x, y, z };
+    float *outs[] = { outx, outy, outz, outw };
+    batch<3, 4>([](const vfloat *v, vfloat *r) { snoisev<4>(v[0], v[1], v[2], r); },
+                in, outs, n);
+}
+
+static void snoise4(const float *x, const float *y, const float *z,
+                    const float *w, float *out, size_t n) {
+    const float *in[] = { x, y, z, w };
+    batch<4>([](const vfloat *v) { return snoise(v[0], v[1], v[2], v[3]); }, in, out, n);
+}
+
+static void snoise4_d(const float *x, const float *y, const float *z,
+                      const float *w, float *out, float *dx, float *dy,
+                      float *dz, float *dw, size_t n) {
+    const float *in[] = { x, y, z, w };
+    float *outs[] = { out, dx, dy, dz, dw };
+    batch<4, 5>([](const vfloat *v, vfloat *r) {
+        r[0] = snoise_d(v[0], v[1], v[2], v[3], r + 1);
+    }, in, outs, n);
+}
+
+static void cnoise2(const float *x, const float *y, float *out, size_t n) {
+    const float *in[] = { x, y };
+    batch<2>([](const vfloat *v) { return cnoise(v[0], v[1]); }, in, out, n);
+}
+
+static void cnoise3(const float *x, const float *y, const float *z,
+                    float *out, size_t n) {
+    const float *in[] = { x, y, z };
+    batch<3>([](const vfloat *v) { return cnoise(v[0], v[1], v[2]); }, in, out, n);
+}
+
+static void cnoise4(const float *x, const float *y, const float *z,
+                    const float *w, float *out, size_t n) {
+    const float *in[] = { x, y, z, w };
+    batch<4>([](const vfloat *v) { return cnoise(v[0], v[1], v[2], v[3]); }, in, out, n);
+}
+
+static void pnoise2(const float *x, const float *y, float *out, size_t n,
+                    float repx, float repy) {
+    const float *in[] = { x, y };
+    vfloat rx = repx, ry = repy;
+    batch<2>([=](const vfloat *v) { return pnoise(v[0], v[1], rx, ry); }, in, out, n);
+}
+
+static void pnoise3(const float *x, const float *y, const float *z,
+                    float *out, size_t n, float repx, float repy, float repz) {
+    const float *in[] = { x, y, z };
+    vfloat rx = repx, ry = repy, rz = repz;
+    batch<3>([=](const vfloat *v) { return pnoise(v[0], v[1], v[2], rx, ry, rz); },
+             in, out, n);
+}
+
+static void pnoise4(const float *x, const float *y, const float *z,
+                    const float *w, float *out, size_t n,
+                    float repx, float repy, float repz, float repw) {
+    const float *in[] = { x, y, z, w };
+    vfloat rx = repx, ry = repy, rz = repz, rw = repw;
+    batch<4>([=](const vfloat *v) { return pnoise(v[0], v[1], v[2], v[3], rx, ry, rz, rw); },
+             in, out, n);
+}
+
+static void cnoise2_d(const float *x, const float *y, float *out,
+                      float *dx, float *dy, size_t n) {
+    const float *in[] = { x, y };
+    float *outs[] = { out, dx, dy };
+    batch<2, 3>([](const vfloat *v, vfloat *r) {
+        r[0] = cnoise_d(v[0], v[1], r[1], r[2]);
+    }, in, outs, n);
+}
+
+static void cnoise3_d(const float *x, const float *y, const float *z,
+                      float *out, float *dx, float *dy, float *dz, size_t n) {
+    const float *in[] = { x, y, z };
+    float *outs[] = { out, dx, dy, dz };
+    batch<3, 4>([](const vfloat *v, vfloat *r) {
+        r[0] = cnoise_d(v[0], v[1], v[2], r[1], r[2], r[3]);
+    }, in, outs, n);
+}
+
+static void cnoise4_d(const float *x, const float *y, const float *z,
+                      const float *w, float *out, float *dx, float *dy,
+                      float *dz, float *dw, size_t n) {
+    const float *in[] = { x, y, z, w };
+    float *outs[] = { out, dx, dy, dz, dw };
+    batch<4, 5>([](const vfloat *v, vfloat *r) {
+        r[0] = cnoise_d(v[0], v[1], v[2], v[3], r + 1);
+    }, in, outs, n);
+}
+
+static void pnoise2_d(const float *x, const float *y, float *out,
+                      float *dx, float *dy, size_t n, float repx, float repy) {
+    const float *in[] = { x, y };
+    float *outs[] = { out, dx, dy };
+    vfloat rx = repx, ry = repy;
+    batch<2, 3>([=](const vfloat *v, vfloat *r) {
+        r[0] = pnoise_d(v[0], v[1], rx, ry, r[1], r[2]);
+    }, in, outs, n);
+}
+
+static void pnoise3_d(const float *x, const float *y, const float *z,
+                      float *out, float *dx, float *dy, float *dz, size_t n,
+                      float repx, float repy, float repz) {
+    const float *in[] = { x, y, z };
+    float *outs[] = { out, dx, dy, dz };
+    vfloat rx = repx, ry = repy, rz = repz;
+    batch<3, 4>([=](const vfloat *v, vfloat *r) {
+        r[0] = pnoise_d(v[0], v[1], v[2], rx, ry, rz, r[1], r[2], r[3]);
+    }, in, outs, n);
+}
+
+static void pnoise4_d(const float *x, const float *y, const float *z,
+                      const float *w, float *out, float *dx, float *dy,
+                      float *dz, float *dw, size_t n,
+                      float repx, float repy, float repz, float repw) {
+    const float *in[] = { x, y, z, w };
+    float *outs[] = { out, dx, dy, dz, dw };
+    vfloat rx = repx, ry = repy, rz = repz, rw = repw;
+    batch<4, 5>([=](const vfloat *v, vfloat *r) {
+        r[0] = pnoise_d(v[0], v[1], v[2], v[3], rx, ry, rz, rw, r + 1);
+    }, in, outs, n);
+}
+
+static void psnoise3(const float *x, const float *y, const float *z,
+                     float *out, size_t n, float repx, float repy, float repz) {
+    const float *in[] = { x, y, z };
+    vfloat rx = repx, ry = repy, rz = repz;
+    batch<3>([=](const vfloat *v) { return psnoise(v[0], v[1], v[2], rx, ry, rz); },
+             in, out, n);
+}
+
+static void psnoise4(const float *x, const float *y, const float *z,
+                     const float *w, float *out, size_t n,
+                     float repx, float repy, float repz, float repw) {
+    const float *in[] = { x, y, z, w };
+    vfloat rx = repx, ry = repy, rz = repz, rw = repw;
+    batch<4>([=](const vfloat *v) { return psnoise(v[0], v[1], v[2], v[3], rx, ry, rz, rw); },
+             in, out, n);
+}
+
+static void psrdnoise3(const float *x, const float *y, const float *z,
+                       float *out, float *dx, float *dy, float *dz, size_t n,
+                       float perx, float pery, float perz, float rot) {
+    const float *in[] = { x, y, z };
+    float *outs[] = { out, dx, dy, dz };
+    vfloat Sa, Ca;
+    sincos(vfloat(rot * 6.28318530718f), Sa, Ca);
+    bool rotate = rot != 0.0f;
+    batch<3, 4>([=](const vfloat *v, vfloat *r) {
+        r[0] = psrdnoise(v[0], v[1], v[2], perx, pery, perz, rotate, Sa, Ca, r[1], r[2], r[3]);
+    }, in, outs, n);
+}
+
+static void psrnoise3(const float *x, const float *y, const float *z,
+                      float *out, size_t n, float perx, float pery, float perz, float rot) {
+    const float *in[] = { x, y, z };
+    vfloat Sa, Ca;
+    sincos(vfloat(rot * 6.28318530718f), Sa, Ca);
+    bool rotate = rot != 0.0f;
+    batch<3>([=](const vfloat *v) {
+        return psrnoise(v[0], v[1], v[2], perx, pery, perz, rotate, Sa, Ca);
+    }, in, out, n);
+}
+
+static void curlnoise3(const float *x, const float *y, const float *z,
+                       float *cx, float *cy, float *cz, size_t n) {
+    const float *in[] = { x, y, z };
+    float *outs[] = { cx, cy, cz };
+    batch<3, 3>([](const vfloat *v, vfloat *r) {
+        curlnoise(v[0], v[1], v[2], r[0], r[1], r[2]);
+    }, in, outs, n);
+}
+
+static void cellular2(const float *x, const float *y, float *f1, float *f2, size_t n,
+                      bool squared) {
+    const float *in[] = { x, y };
+    float *out[] = { f1, f2 };
+    batch<2, 2>([=](const vfloat *v, vfloat *r) {
+        cellular(v[0], v[1], r[0], r[1]);
+        if (!squared) {
+            r[0] = sqrt(r[0]);
+            r[1] = sqrt(r[1]);
+        }
+    }, in, out, n);
+}
+
+static void cellular3(const float *x, const float *y, const float *z,
+                      float *f1, float *f2, size_t n, bool squared) {
+    const float *in[] = { x, y, z };
+    float *out[] = { f1, f2 };
+    batch<3, 2>([=](const vfloat *v, vfloat *r) {
+        cellular_culled(v[0], v[1], v[2], r[0], r[1]);
+        if (!squared) {
+            r[0] = sqrt(r[0]);
+            r[1] = sqrt(r[1]);
+        }
+    }, in, out, n);
+}
+
+static void cellular2x2x2(const float *x, const float *y, const float *z,
+                          float *f1, float *f2, size_t n, bool squared) {
+    const float *in[] = { x, y, z };
+    float *out[] = { f1, f2 };
+    batch<3, 2>([=](const vfloat *v, vfloat *r) {
+        cellular2x2x2(v[0], v[1], v[2], r[0], r[1]);
+        if (!squared) {
+            r[0] = sqrt(r[0]);
+            r[1] = sqrt(r[1]);
+        }
+    }, in, out, n);
+}
+
+static void pcellular2(const float *x, const float *y, float *f1, float *f2, size_t n,
+                       float repx, float repy, bool squared) {
+    const float *in[] = { x, y };
+    float *out[] = { f1, f2 };
+    vfloat rx = repx, ry = repy;
+    batch<2, 2>([=](const vfloat *v, vfloat *r) {
+        pcellular(v[0], v[1], rx, ry, r[0], r[1]);
+        if (!squared) {
+            r[0] = sqrt(r[0]);
+            r[1] = sqrt(r[1]);
+        }
+    }, in, out, n);
+}
+
+static void pcellular3(const float *x, const float *y, const float *z,
+                       float *f1, float *f2, size_t n,
+                       float repx, float repy, float repz, bool squared) {
+    const float *in[] = { x, y, z };
+    float *out[] = { f1, f2 };
+    vfloat rx = repx, ry = repy, rz = repz;
+    batch<3, 2>([=](const vfloat *v, vfloat *r) {
+        pcellular(v[0], v[1], v[2], rx, ry, rz, r[0], r[1]);
+        if (!squared) {
+            r[0] = sqrt(r[0]);
+            r[1] = sqrt(r[1]);
+        }
+    }, in, out, n);
+}
+
+static void cellular2_voronoi(const float *x, const float *y, float *f1, float *f2,
+                              float *id, float *fx, float *fy, float *border, size_t n) {
+    const float *in[] = { x, y };
+    float *out[] = { f1, f2, id, fx, fy, border };
+    batch<2, 6>([](const vfloat *v, vfloat *r) {
+        cellular_voronoi(v[0], v[1], r[0], r[1], r[2], r[3], r[4], r[5]);
+        r[0] = sqrt(r[0]);
+        r[1] = sqrt(r[1]);
+    }, in, out, n);
+}
+
+static void cellular3_voronoi(const float *x, const float *y, const float *z,
+                              float *f1, float *f2, float *id, float *fx, float *fy,
+                              float *fz, float *border, size_t n) {
+    const float *in[] = { x, y, z };
+    float *out[] = { f1, f2, id, fx, fy, fz, border };
+    batch<3, 7>([](const vfloat *v, vfloat *r) {
+        cellular_voronoi(v[0], v[1], v[2], r[0], r[1], r[2], r[3], r[4], r[5], r[6]);
+        r[0] = sqrt(r[0]);
+        r[1] = sqrt(r[1]);
+    }, in, out, n);
+}
+
+static void fbm3(const float *x, const float *y, const float *z,
+                 float *out, size_t n, int octaves, float lacunarity, float gain) {
+    const float *in[] = { x, y, z };
+    batch<3>([=](const vfloat *v) { return fbm(v[0], v[1], v[2], octaves, lacunarity, gain); },
+             in, out, n);
+}
+
+// Splatting pays off when each vertex covers enough grid points to make
+// up for its setup and to fill the vector lanes along the rows. On
+// coarser grids, the noise is evaluated point by point instead.
+static void snoise3_grid(const Image &image, const Grid &grid, const Tile &tile) {
+    float coarse = 0.4f / W;
+    if (fabsf(grid.step[0]) > coarse
+        || (image.height > 1 && fabsf(grid.step[1]) > coarse)
+        || (image.depth > 1 && fabsf(grid.step[2]) > coarse))
+        sample_tile([](const void *, const float *x, const float *y, const float *z,
+                       float *out, size_t n) {
+            snoise3(x, y, z, out, n);
+        }, 0, image, grid, tile);
+    else
+        snoise3_splat<vfloat>(image, grid, tile);
+}
+
+// The separable engines pay off as long as a lattice cell spans a few
+// samples along each axis, more of them in 3D, where each cell and row
+// blends eight corners. On coarser grids, the noise is evaluated point
+// by point instead.
+static bool coarse_cells(const Image &image, const Grid &grid, int dims) {
+    float coarse = dims == 2 ? 0.5f : 0.25f;
+    return fabsf(grid.step[0]) > coarse
+        || (image.height > 1 && fabsf(grid.step[1]) > coarse)
+        || (dims > 2 && image.depth > 1 && fabsf(grid.step[2]) > coarse);
+}
+
+static void cnoise2_grid(const Image &image, const Grid &grid, const Tile &tile,
+                         const float *rep) {
+    if (!coarse_cells(image, grid, 2))
+        cnoise2_separable<vfloat>(image, grid, tile, rep);
+    else if (rep) {
+        sample_tile([](const void *rep, const float *x, const float *y, const float *,
+                       float *out, size_t n) {
+            const float *r = static_cast<const float *>(rep);
+            pnoise2(x, y, out, n, r[0], r[1]);
+        }, rep, image, grid, tile);
+    } else
+        sample_tile([](const void *, const float *x, const float *y, const float *,
+                       float *out, size_t n) {
+            cnoise2(x, y, out, n);
+        }, 0, image, grid, tile);
+}
+
+static void cnoise3_grid(const Image &image, const Grid &grid, const Tile &tile,
+                         const float *rep) {
+    if (!coarse_cells(image, grid, 3))
+        cnoise3_separable<vfloat>(image, grid, tile, rep);
+    else if (rep) {
+        sample_tile([](const void *rep, const float *x, const float *y, const float *z,
+                       float *out, size_t n) {
+            const float *r = static_cast<const float *>(rep);
+            pnoise3(x, y, z, out, n, r[0], r[1], r[2]);
+        }, rep, image, grid, tile);
+    } else
+        sample_tile([](const void *, const float *x, const float *y, const float *z,
+                       float *out, size_t n) {
+            cnoise3(x, y, z, out, n);
+        }, 0, image, grid, tile);
+}
+
+// The feature point tables pay off while a vector of samples spans only
+// a few cells along a row, as one that spans several cells is done once
+// per cell, which costs more in 3D, with 27 cells to search. Across the
+// rows, a cell should hold a row or more, or the tables get larger than
+// the tile. On coarser grids, the noise is evaluated point by point
+// instead, a row at a time.
+static bool coarse_features(const Image &image, const Grid &grid, int dims) {
+    float coarse = dims == 2 ? 10.0f / W : 2.4f / W;
+    return fabsf(grid.step[0]) > coarse
+        || (image.height > 1 && fabsf(grid.step[1]) > 1.0f)
+        || (dims > 2 && image.depth > 1 && fabsf(grid.step[2]) > 1.0f);
+}
+
+template <class F>
+static void sample_rows(F cells, const Image &f1, const Image &f2, const Grid &grid,
+                        const Tile &tile) {
+    enum { N = 64 };
+    float x[N], y[N], z[N], r[N];
+    for (int i0 = tile.x0; i0 < tile.x1; i0 += N) {
+        int n = tile.x1 - i0 < N ? tile.x1 - i0 : N;
+        for (int i = 0; i < n; i++)
+            x[i] = grid_line(grid, 0, i0 + i);
+        for (int k = tile.z0; k < tile.z1; k++)
+            for (int j = tile.y0; j < tile.y1; j++) {
+                float yj = grid_line(grid, 1, j), zk = grid_line(grid, 2, k);
+                for (int i = 0; i < n; i++) {
+                    y[i] = yj;
+                    z[i] = zk;
+                }
+                size_t row = ((size_t)k * f1.height + j) * f1.pitch + i0;
+                float *out2 = f2.data ? f2.data + ((size_t)k * f2.height + j) * f2.pitch + i0 : r;
+                cells(x, y, z, f1.data + row, out2, n);
+            }
+    }
+}
+
+static void cellular2_grid(const Image &f1, const Image &f2, const Grid &grid,
+                           const Tile &tile, bool squared) {
+    if (!coarse_features(f1, grid, 2))
+        cellular2_cached<vfloat>(f1, f2, grid, tile, squared);
+    else
+        sample_rows([=](const float *x, const float *y, const float *, float *o1, float *o2,
+                        size_t n) {
+            cellular2(x, y, o1, o2, n, squared);
+        }, f1, f2, grid, tile);
+}
+
+static void cellular3_grid(const Image &f1, const Image &f2, const Grid &grid,
+                           const Tile &tile, bool squared) {
+    if (!coarse_features(f1, grid, 3))
+        cellular3_cached<vfloat>(f1, f2, grid, tile, squared);
+    else
+        sample_rows([=](const float *x, const float *y, const float *z, float *o1, float *o2,
+                        size_t n) {
+            cellular3(x, y, z, o1, o2, n, squared);
+        }, f1, f2, grid, tile);
+}
+
+#define STR(s) STR_(s)
+#define STR_(s) #s
+
+extern const Kernels kernels = {
+    STR(WEBGLNOISE_ISA),
+    snoise2,
+    snoise3,
+    snoise3_table,
+    snoise3_int32,
+    snoise3v,
+    snoise4v,
+    snoise4,
+    snoise4_d,
+    cnoise2,
+    cnoise3,
+    cnoise4,
+    pnoise2,
+    pnoise3,
+    pnoise4,
+    cnoise2_d,
+    cnoise3_d,
+    cnoise4_d,
+    pnoise2_d,
+    pnoise3_d,
+    pnoise4_d,
+    psnoise3,
+    psnoise4,
+    psrdnoise3,
+    psrnoise3,
+    curlnoise3,
+    cellular2,
+    cellular3,
+    cellular2x2x2,
+    pcellular2,
+    pcellular3,
+    cellular2_voronoi,
+    cellular3_voronoi,
+    fbm3,
+    snoise3_grid,
+    cnoise2_grid,
+    cnoise3_grid,
+    cellular2_grid,
+    cellular3_grid,
+};
+
+}
+}
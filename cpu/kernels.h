@@ -0,0 +1,123 @@
+//
+// Description : Table of batch kernels for one instruction set,
+//               used by dispatch.cpp to pick the kernels at load time.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+
+#ifndef WEBGLNOISE_KERNELS_H
+#define WEBGLNOISE_KERNELS_H
+
+#include <stddef.h>
+#include "tiles.h"
+
+namespace webglnoise {
+
+struct Kernels {
+    const char *name;
+    void (*snoise2)(const float *x, const float *y, float *out, size_t n);
+    void (*snoise3)(const float *x, const float *y, const float *z,
+                    float *out, size_t n);
+    void (*snoise3_table)(const float *x, const float *y, const float *z,
+                          float *out, size_t n);
+    void (*snoise3_int32)(const float *x, const float *y, const float *z,
+                          float *out, size_t n);
+    void (*snoise3v)(const float *x, const float *y, const float *z,
+                     float *outx, float *outy, float *outz, size_t n);
+    void (*snoise4v)(const float *x, const float *y, const float *z,
+                     float *outx, float *outy, float *outz, float *outw, size_t n);
+    void (*snoise4)(const float *x, const float *y, const float *z,
+                    const float *w, float *out, size_t n);
+    void (*snoise4_d)(const float *x, const float *y, const float *z,
+                      const float *w, float *out, float *dx, float *dy,
+                      float *dz, float *dw, size_t n);
+    void (*cnoise2)(const float *x, const float *y, float *out, size_t n);
+    void (*cnoise3)(const float *x, const float *y, const float *z,
+                    float *out, size_t n);
+    void (*cnoise4)(const float *x, const float *y, const float *z,
+                    const float *w, float *out, size_t n);
+    void (*pnoise2)(const float *x, const float *y, float *out, size_t n,
+                    float repx, float repy);
+    void (*pnoise3)(const float *x, const float *y, const float *z,
+                    float *out, size_t n, float repx, float repy, float repz);
+    void (*pnoise4)(const float *x, const float *y, const float *z,
+                    const float *w, float *out, size_t n,
+                    float repx, float repy, float repz, float repw);
+    // Classic noise with its gradient in dx, dy, ...
+    void (*cnoise2_d)(const float *x, const float *y, float *out,
+                      float *dx, float *dy, size_t n);
+    void (*cnoise3_d)(const float *x, const float *y, const float *z,
+                      float *out, float *dx, float *dy, float *dz, size_t n);
+    void (*cnoise4_d)(const float *x, const float *y, const float *z,
+                      const float *w, float *out, float *dx, float *dy,
+                      float *dz, float *dw, size_t n);
+    void (*pnoise2_d)(const float *x, const float *y, float *out,
+                      float *dx, float *dy, size_t n, float repx, float repy);
+    void (*pnoise3_d)(const float *x, const float *y, const float *z,
+                      float *out, float *dx, float *dy, float *dz, size_t n,
+                      float repx, float repy, float repz);
+    void (*pnoise4_d)(const float *x, const float *y, const float *z,
+                      const float *w, float *out, float *dx, float *dy,
+                      float *dz, float *dw, size_t n,
+                      float repx, float repy, float repz, float repw);
+    void (*psnoise3)(const float *x, const float *y, const float *z,
+                     float *out, size_t n, float repx, float repy, float repz);
+    void (*psnoise4)(const float *x, const float *y, const float *z,
+                     const float *w, float *out, size_t n,
+                     float repx, float repy, float repz, float repw);
+    void (*psrdnoise3)(const float *x, const float *y, const float *z,
+                       float *out, float *dx, float *dy, float *dz, size_t n,
+                       float perx, float pery, float perz, float rot);
+    void (*psrnoise3)(const float *x, const float *y, const float *z,
+                      float *out, size_t n, float perx, float pery, float perz, float rot);
+    void (*curlnoise3)(const float *x, const float *y, const float *z,
+                       float *cx, float *cy, float *cz, size_t n);
+    void (*cellular2)(const float *x, const float *y, float *f1, float *f2, size_t n,
+                      bool squared);
+    void (*cellular3)(const float *x, const float *y, const float *z,
+                      float *f1, float *f2, size_t n, bool squared);
+    void (*cellular2x2x2)(const float *x, const float *y, const float *z,
+                          float *f1, float *f2, size_t n, bool squared);
+    void (*pcellular2)(const float *x, const float *y, float *f1, float *f2, size_t n,
+                       float repx, float repy, bool squared);
+    void (*pcellular3)(const float *x, const float *y, const float *z,
+                       float *f1, float *f2, size_t n,
+                       float repx, float repy, float repz, bool squared);
+    void (*cellular2_voronoi)(const float *x, const float *y, float *f1, float *f2,
+                              float *id, float *fx, float *fy, float *border, size_t n);
+    void (*cellular3_voronoi)(const float *x, const float *y, const float *z,
+                              float *f1, float *f2, float *id, float *fx, float *fy,
+                              float *fz, float *border, size_t n);
+    void (*fbm3)(const float *x, const float *y, const float *z,
+                 float *out, size_t n, int octaves, float lacunarity, float gain);
+
+    // Dense grid engines, filling one tile of an image
+    void (*snoise3_grid)(const Image &image, const Grid &grid, const Tile &tile);
+    // Classic noise, with the periods of pnoise, or cnoise if rep is null
+    void (*cnoise2_grid)(const Image &image, const Grid &grid, const Tile &tile,
+                         const float *rep);
+    void (*cnoise3_grid)(const Image &image, const Grid &grid, const Tile &tile,
+                         const float *rep);
+    // Cellular noise, F1 to f1 and F2 to f2, unless f2.data is null
+    void (*cellular2_grid)(const Image &f1, const Image &f2, const Grid &grid,
+                           const Tile &tile, bool squared);
+    void (*cellular3_grid)(const Image &f1, const Image &f2, const Grid &grid,
+                           const Tile &tile, bool squared);
+};
+
+// The table in use, see dispatch.cpp
+const Kernels *active_kernels();
+
+// One table per build of kernels.cpp, see Makefile
+namespace scalar { extern const Kernels kernels; }
+#if defined(__x86_64__) || defined(__i386__)
+namespace sse41 { extern const Kernels kernels; }
+namespace avx2 { extern const Kernels kernels; }
+namespace avx512 { extern const Kernels kernels; }
+#endif
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+//
+// Description : C++ port of the GLSL 2D simplex noise function
+//               in ../src/noise2D.glsl.
+//      Author : Ian McEwan, Ashima Arts.
+//  Maintainer : stegu
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+
+#ifndef WEBGLNOISE_NOISE2D_H
+#define WEBGLNOISE_NOISE2D_H
+
+#include "helpers.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Contribution of one simplex corner, from the hash p of the corner and
+// the vector (x, y) from it to the point, as scorner4x() in the shader
+template <class V>
+static inline V scorner(V p, V x, V y) {
+    V m = max(0.5f - (x * x + y * y), V(0.0f));
+    m = m * m;
+    m = m * m;
+
+// Gradients: 41 points uniformly over a line, mapped onto a diamond.
+// The ring size 17*17 = 289 is close to a multiple of 41 (41*7 = 287)
+    V gx = 2.0f * fract(p * 0.024390243902439f) - 1.0f;
+    V h = abs(gx) - 0.5f;
+    V a0 = gx - floor(gx + 0.5f);
+
+// Normalise gradients implicitly by scaling m
+    m *= 1.79284291400159f - 0.85373472095314f * (a0 * a0 + h * h);
+    return m * (a0 * x + h * y);
+}
+
+// 2D simplex noise. With one point per lane, this is snoise4x() of the
+// shader, which evaluates four points in the components of vec4s: the
+// SSE4.1 kernel runs it as is, and the AVX2 and AVX-512 kernels on 8 and
+// 16 points at a time.
+template <class V>
+static inline V snoise(V vx, V vy) {
+    const float Cx = 0.211324865405187f,  // (3.0-sqrt(3.0))/6.0
+                Cy = 0.366025403784439f,  // 0.5*(sqrt(3.0)-1.0)
+                Cz = -0.577350269189626f; // -1.0 + 2.0 * C.x
+// First corner
+    V s = vx * Cy + vy * Cy;
+    V ix = floor(vx + s), iy = floor(vy + s);
+    V t = ix * Cx + iy * Cx;
+    V x0x = vx - ix + t, x0y = vy - iy + t;
+
+// Other corners
+    V i1x = select(lessThan(x0y, x0x), V(1.0f), V(0.0f));
+    V i1y = 1.0f - i1x;
+    V x1x = x0x + Cx - i1x, x1y = x0y + Cx - i1y;
+    V x2x = x0x + Cz, x2y = x0y + Cz;
+
+// Permutations
+    ix = mod289(ix); // Avoid truncation effects in permutation
+    iy = mod289(iy);
+    V p0 = permute(permute(iy) + ix);
+    V p1 = permute(permute(iy + i1y) + ix + i1x);
+    V p2 = permute(permute(iy + 1.0f) + ix + 1.0f);
+
+// Compute final noise value at P
+    return 130.0f * (scorner(p0, x0x, x0y) + scorner(p1, x1x, x1y) + scorner(p2, x2x, x2y));
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,180 @@
+//
+// Description : C++ port of the GLSL 3D simplex noise function
+//               in ../src/noise3D.glsl.
+//      Author : Ian McEwan, Ashima Arts.
+//  Maintainer : stegu
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// The code follows the shader line by line, with each vecN written
+// out as N values of type V (float lanes, see simd.h). All arithmetic
+// is done in the same order as in the shader, so the lattice hashing
+// is exact and gives the same gradients as the GPU. See README for the
+// error bound on the final value.
+//
+
+#ifndef WEBGLNOISE_NOISE3D_H
+#define WEBGLNOISE_NOISE3D_H
+
+#include "helpers.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Gradients: 7x7 points over a square, mapped onto an octahedron.
+// The ring size 17*17 = 289 is close to a multiple of 49 (49*6 = 294)
+// The gradient is returned normalised, as "p0 *= norm.x" in the shader.
+template <class V>
+static inline void grad3(V p, V &gx, V &gy, V &gz) {
+    const float n_ = 0.142857142857f; // 1.0/7.0
+    const float nsx = n_ * 2.0f, nsy = n_ * 0.5f - 1.0f, nsz = n_;
+
+    V j = p - 49.0f * floor(p * nsz * nsz); //  mod(p,7*7)
+
+    V x_ = floor(j * nsz);
+    V y_ = floor(j - 7.0f * x_); // mod(j,N)
+
+    V x = x_ * nsx + nsy;
+    V y = y_ * nsx + nsy;
+    V h = 1.0f - abs(x) - abs(y);
+
+    V sx = floor(x) * 2.0f + 1.0f;
+    V sy = floor(y) * 2.0f + 1.0f;
+    V sh = -step(h, V(0.0f));
+
+    gx = x + sx * sh;
+    gy = y + sy * sh;
+    gz = h;
+
+    V norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+    gx *= norm;
+    gy *= norm;
+    gz *= norm;
+}
+
+// The hash of the shader: lattice coordinates wrapped modulo 289, and
+// three rounds of the permutation polynomial. See hash3D.h for others.
+template <class V>
+struct PermuteHash {
+    V wrap(V i) const { return mod289(i); }
+    void grad(V ix, V iy, V iz, V &gx, V &gy, V &gz) const {
+        grad3(permute(permute(permute(iz) + iy) + ix), gx, gy, gz);
+    }
+};
+
+// 3D simplex noise, with the gradient of lattice vertex i (wrapped by
+// hash.wrap() and then offset by 0 or 1 per axis) from hash.grad()
+template <class V, class H>
+static inline V snoise(V vx, V vy, V vz, const H &hash) {
+    const float Cx = 1.0f / 6.0f, Cy = 1.0f / 3.0f;
+
+// First corner
+    V s = vx * Cy + vy * Cy + vz * Cy;
+    V ix = floor(vx + s), iy = floor(vy + s), iz = floor(vz + s);
+    V t = ix * Cx + iy * Cx + iz * Cx;
+    V x0x = vx - ix + t, x0y = vy - iy + t, x0z = vz - iz + t;
+
+// Other corners
+    V gx = step(x0y, x0x), gy = step(x0z, x0y), gz = step(x0x, x0z);
+    V lx = 1.0f - gx, ly = 1.0f - gy, lz = 1.0f - gz;
+    V i1x = min(gx, lz), i1y = min(gy, lx), i1z = min(gz, ly);
+    V i2x = max(gx, lz), i2y = max(gy, lx), i2z = max(gz, ly);
+
+    V x1x = x0x - i1x + Cx, x1y = x0y - i1y + Cx, x1z = x0z - i1z + Cx;
+    V x2x = x0x - i2x + Cy, x2y = x0y - i2y + Cy, x2z = x0z - i2z + Cy;
+    V x3x = x0x - 0.5f, x3y = x0y - 0.5f, x3z = x0z - 0.5f;
+
+// Permutations and normalised gradients
+    ix = hash.wrap(ix);
+    iy = hash.wrap(iy);
+    iz = hash.wrap(iz);
+    V g0x, g0y, g0z, g1x, g1y, g1z, g2x, g2y, g2z, g3x, g3y, g3z;
+    hash.grad(ix, iy, iz, g0x, g0y, g0z);
+    hash.grad(ix + i1x, iy + i1y, iz + i1z, g1x, g1y, g1z);
+    hash.grad(ix + i2x, iy + i2y, iz + i2z, g2x, g2y, g2z);
+    hash.grad(ix + 1.0f, iy + 1.0f, iz + 1.0f, g3x, g3y, g3z);
+
+// Mix final noise value
+    V m0 = max(0.5f - (x0x * x0x + x0y * x0y + x0z * x0z), V(0.0f));
+    V m1 = max(0.5f - (x1x * x1x + x1y * x1y + x1z * x1z), V(0.0f));
+    V m2 = max(0.5f - (x2x * x2x + x2y * x2y + x2z * x2z), V(0.0f));
+    V m3 = max(0.5f - (x3x * x3x + x3y * x3y + x3z * x3z), V(0.0f));
+    m0 = m0 * m0;
+    m1 = m1 * m1;
+    m2 = m2 * m2;
+    m3 = m3 * m3;
+    return 105.0f * (m0 * m0 * (g0x * x0x + g0y * x0y + g0z * x0z)
+                   + m1 * m1 * (g1x * x1x + g1y * x1y + g1z * x1z)
+                   + m2 * m2 * (g2x * x2x + g2y * x2y + g2z * x2z)
+                   + m3 * m3 * (g3x * x3x + g3y * x3y + g3z * x3z));
+}
+
+template <class V>
+static inline V snoise(V vx, V vy, V vz) {
+    return snoise(vx, vy, vz, PermuteHash<V>());
+}
+
+// The simplex of v, for the functions that compute several noise fields
+// from it: the vectors (x[c], y[c], z[c]) from its corners to v, the hash
+// p[c] of each corner as in PermuteHash, and the weights m^4 as in snoise()
+template <class V>
+static inline void simplex3(V vx, V vy, V vz, V x[4], V y[4], V z[4], V p[4], V m4[4]) {
+    const float Cx = 1.0f / 6.0f, Cy = 1.0f / 3.0f;
+
+// First corner
+    V s = vx * Cy + vy * Cy + vz * Cy;
+    V ix = floor(vx + s), iy = floor(vy + s), iz = floor(vz + s);
+    V t = ix * Cx + iy * Cx + iz * Cx;
+    V x0x = vx - ix + t, x0y = vy - iy + t, x0z = vz - iz + t;
+
+// Other corners
+    V gx = step(x0y, x0x), gy = step(x0z, x0y), gz = step(x0x, x0z);
+    V lx = 1.0f - gx, ly = 1.0f - gy, lz = 1.0f - gz;
+    V i1x = min(gx, lz), i1y = min(gy, lx), i1z = min(gz, ly);
+    V i2x = max(gx, lz), i2y = max(gy, lx), i2z = max(gz, ly);
+
+    x[0] = x0x; x[1] = x0x - i1x + Cx; x[2] = x0x - i2x + Cy; x[3] = x0x - 0.5f;
+    y[0] = x0y; y[1] = x0y - i1y + Cx; y[2] = x0y - i2y + Cy; y[3] = x0y - 0.5f;
+    z[0] = x0z; z[1] = x0z - i1z + Cx; z[2] = x0z - i2z + Cy; z[3] = x0z - 0.5f;
+
+// Permutations and weights
+    ix = mod289(ix);
+    iy = mod289(iy);
+    iz = mod289(iz);
+    V ox[4] = { V(0.0f), i1x, i2x, V(1.0f) };
+    V oy[4] = { V(0.0f), i1y, i2y, V(1.0f) };
+    V oz[4] = { V(0.0f), i1z, i2z, V(1.0f) };
+    for (int c = 0; c < 4; c++) {
+        p[c] = permute(permute(permute(iz + oz[c]) + iy + oy[c]) + ix + ox[c]);
+        V m = max(0.5f - (x[c] * x[c] + y[c] * y[c] + z[c] * z[c]), V(0.0f));
+        m = m * m;
+        m4[c] = m * m;
+    }
+}
+
+// N channels of 3D simplex noise into n[0 .. N-1], as snoise3v() (N = 3)
+// and snoise4v() (N = 4) in the shader. Channel 0 is snoise(), and the
+// others hash the corners to permute(p + seed) with their own seeds.
+template <int N, class V>
+static inline void snoisev(V vx, V vy, V vz, V n[N]) {
+    const float seed[4] = { 0.0f, 97.0f, 152.0f, 257.0f };
+    V x[4], y[4], z[4], p[4], m4[4];
+    simplex3(vx, vy, vz, x, y, z, p, m4);
+
+    for (int k = 0; k < N; k++) {
+        V t[4];
+        for (int c = 0; c < 4; c++) {
+            V gx, gy, gz;
+            grad3(k == 0 ? p[c] : permute(p[c] + seed[k]), gx, gy, gz);
+            t[c] = m4[c] * (gx * x[c] + gy * y[c] + gz * z[c]);
+        }
+        n[k] = 105.0f * (t[0] + t[1] + t[2] + t[3]);
+    }
+}
+
+}
+}
+
+#endif
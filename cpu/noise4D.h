@@ -0,0 +1,156 @@
+//
+// Description : C++ port of the GLSL 4D simplex noise function
+//               in ../src/noise4D.glsl, and of its variant with
+//               the gradient in ../src/noise4Dgrad.glsl.
+//      Author : Ian McEwan, Ashima Arts.
+//  Maintainer : stegu
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+
+#ifndef WEBGLNOISE_NOISE4D_H
+#define WEBGLNOISE_NOISE4D_H
+
+#include "helpers.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Gradients: 7x7x6 points over a cube, mapped onto a 4-cross polytope
+// 7*7*6 = 294, which is close to the ring size 17*17 = 289.
+// The gradient is returned normalised, as "p0 *= norm.x" in the shader.
+template <class V>
+static inline void grad4(V j, V &px, V &py, V &pz, V &pw) {
+    const float ipx = 1.0f / 294.0f, ipy = 1.0f / 49.0f, ipz = 1.0f / 7.0f;
+
+    px = floor(fract(j * ipx) * 7.0f) * ipz - 1.0f;
+    py = floor(fract(j * ipy) * 7.0f) * ipz - 1.0f;
+    pz = floor(fract(j * ipz) * 7.0f) * ipz - 1.0f;
+    pw = 1.5f - (abs(px) + abs(py) + abs(pz));
+    V sw = select(lessThan(pw, V(0.0f)), V(1.0f), V(0.0f));
+    px = px + (select(lessThan(px, V(0.0f)), V(2.0f), V(0.0f)) - 1.0f) * sw;
+    py = py + (select(lessThan(py, V(0.0f)), V(2.0f), V(0.0f)) - 1.0f) * sw;
+    pz = pz + (select(lessThan(pz, V(0.0f)), V(2.0f), V(0.0f)) - 1.0f) * sw;
+
+    V norm = taylorInvSqrt(px * px + py * py + pz * pz + pw * pw);
+    px *= norm;
+    py *= norm;
+    pz *= norm;
+    pw *= norm;
+}
+
+// The simplex of v: the vectors x[c] from its five corners to v, and the
+// normalised gradients p[c] of the corners. Components are [c][0 .. 3].
+template <class V>
+static inline void simplex4(V vx, V vy, V vz, V vw, V x[5][4], V p[5][4]) {
+    const float F4 = 0.309016994374947451f; // (sqrt(5) - 1)/4
+    const float Cx = 0.138196601125011f,  // (5 - sqrt(5))/20  G4
+                Cy = 0.276393202250021f,  // 2 * G4
+                Cz = 0.414589803375032f,  // 3 * G4
+                Cw = -0.447213595499958f; // -1 + 4 * G4
+
+// First corner
+    V s = vx * F4 + vy * F4 + vz * F4 + vw * F4;
+    V ix = floor(vx + s), iy = floor(vy + s), iz = floor(vz + s), iw = floor(vw + s);
+    V t = ix * Cx + iy * Cx + iz * Cx + iw * Cx;
+    V x0x = vx - ix + t, x0y = vy - iy + t, x0z = vz - iz + t, x0w = vw - iw + t;
+
+// Other corners
+
+// Rank sorting originally contributed by Bill Licea-Kane, AMD (formerly ATI)
+    V isXx = step(x0y, x0x), isXy = step(x0z, x0x), isXz = step(x0w, x0x);
+    V isYZx = step(x0z, x0y), isYZy = step(x0w, x0y), isYZz = step(x0w, x0z);
+    V i0x = isXx + isXy + isXz;
+    V i0y = 1.0f - isXx, i0z = 1.0f - isXy, i0w = 1.0f - isXz;
+    i0y += isYZx + isYZy;
+    i0z += 1.0f - isYZx;
+    i0w += 1.0f - isYZy;
+    i0z += isYZz;
+    i0w += 1.0f - isYZz;
+
+    // i0 now contains the unique values 0,1,2,3 in each channel
+    V i3x = clamp(i0x, V(0.0f), V(1.0f)), i3y = clamp(i0y, V(0.0f), V(1.0f));
+    V i3z = clamp(i0z, V(0.0f), V(1.0f)), i3w = clamp(i0w, V(0.0f), V(1.0f));
+    V i2x = clamp(i0x - 1.0f, V(0.0f), V(1.0f)), i2y = clamp(i0y - 1.0f, V(0.0f), V(1.0f));
+    V i2z = clamp(i0z - 1.0f, V(0.0f), V(1.0f)), i2w = clamp(i0w - 1.0f, V(0.0f), V(1.0f));
+    V i1x = clamp(i0x - 2.0f, V(0.0f), V(1.0f)), i1y = clamp(i0y - 2.0f, V(0.0f), V(1.0f));
+    V i1z = clamp(i0z - 2.0f, V(0.0f), V(1.0f)), i1w = clamp(i0w - 2.0f, V(0.0f), V(1.0f));
+
+    x[0][0] = x0x; x[0][1] = x0y; x[0][2] = x0z; x[0][3] = x0w;
+    x[1][0] = x0x - i1x + Cx; x[1][1] = x0y - i1y + Cx;
+    x[1][2] = x0z - i1z + Cx; x[1][3] = x0w - i1w + Cx;
+    x[2][0] = x0x - i2x + Cy; x[2][1] = x0y - i2y + Cy;
+    x[2][2] = x0z - i2z + Cy; x[2][3] = x0w - i2w + Cy;
+    x[3][0] = x0x - i3x + Cz; x[3][1] = x0y - i3y + Cz;
+    x[3][2] = x0z - i3z + Cz; x[3][3] = x0w - i3w + Cz;
+    x[4][0] = x0x + Cw; x[4][1] = x0y + Cw; x[4][2] = x0z + Cw; x[4][3] = x0w + Cw;
+
+// Permutations
+    ix = mod289(ix);
+    iy = mod289(iy);
+    iz = mod289(iz);
+    iw = mod289(iw);
+    V j0 = permute(permute(permute(permute(iw) + iz) + iy) + ix);
+    V j1 = permute(permute(permute(permute(iw + i1w) + iz + i1z) + iy + i1y) + ix + i1x);
+    V j2 = permute(permute(permute(permute(iw + i2w) + iz + i2z) + iy + i2y) + ix + i2x);
+    V j3 = permute(permute(permute(permute(iw + i3w) + iz + i3z) + iy + i3y) + ix + i3x);
+    V j4 = permute(permute(permute(permute(iw + 1.0f) + iz + 1.0f) + iy + 1.0f) + ix + 1.0f);
+
+// Normalised gradients
+    grad4(j0, p[0][0], p[0][1], p[0][2], p[0][3]);
+    grad4(j1, p[1][0], p[1][1], p[1][2], p[1][3]);
+    grad4(j2, p[2][0], p[2][1], p[2][2], p[2][3]);
+    grad4(j3, p[3][0], p[3][1], p[3][2], p[3][3]);
+    grad4(j4, p[4][0], p[4][1], p[4][2], p[4][3]);
+}
+
+template <class V>
+static inline V snoise(V vx, V vy, V vz, V vw) {
+    V x[5][4], p[5][4];
+    simplex4(vx, vy, vz, vw, x, p);
+
+// Mix contributions from the five corners
+    V t[5];
+    for (int c = 0; c < 5; c++) {
+        V m = max(0.6f - (x[c][0] * x[c][0] + x[c][1] * x[c][1]
+                        + x[c][2] * x[c][2] + x[c][3] * x[c][3]), V(0.0f));
+        m = m * m;
+        t[c] = m * m * (p[c][0] * x[c][0] + p[c][1] * x[c][1]
+                      + p[c][2] * x[c][2] + p[c][3] * x[c][3]);
+    }
+    return 49.0f * (t[0] + t[1] + t[2] + t[3] + t[4]);
+}
+
+// 4D simplex noise with its gradient in grad[0 .. 3], as snoise(vec4,
+// out vec4) in noise4Dgrad.glsl, from the same corners and weights
+template <class V>
+static inline V snoise_d(V vx, V vy, V vz, V vw, V grad[4]) {
+    V x[5][4], p[5][4];
+    simplex4(vx, vy, vz, vw, x, p);
+
+    V t[5];
+    for (int d = 0; d < 4; d++)
+        grad[d] = V(0.0f);
+    for (int c = 0; c < 5; c++) {
+        V m = max(0.6f - (x[c][0] * x[c][0] + x[c][1] * x[c][1]
+                        + x[c][2] * x[c][2] + x[c][3] * x[c][3]), V(0.0f));
+        V m2 = m * m;
+        V m4 = m2 * m2;
+        V pdotx = p[c][0] * x[c][0] + p[c][1] * x[c][1]
+                + p[c][2] * x[c][2] + p[c][3] * x[c][3];
+        V temp = -8.0f * m2 * m * pdotx;
+        for (int d = 0; d < 4; d++)
+            grad[d] += m4 * p[c][d] + temp * x[c][d];
+        t[c] = m4 * pdotx;
+    }
+    for (int d = 0; d < 4; d++)
+        grad[d] *= 49.0f;
+    return 49.0f * (t[0] + t[1] + t[2] + t[3] + t[4]);
+}
+
+}
+}
+
+#endif
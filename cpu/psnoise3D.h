@@ -0,0 +1,92 @@
+//
+// Description : C++ port of the GLSL periodic 3D simplex noise function
+//               in ../src/psnoise3D.glsl.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// As in noise3D.h, the code follows the shader line by line. The simplex
+// corners are computed from whole numbers and halves, so they are exact,
+// and wrapping them to the period is too.
+//
+
+#ifndef WEBGLNOISE_PSNOISE3D_H
+#define WEBGLNOISE_PSNOISE3D_H
+
+#include "noise3D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// Simplex corner (vx, vy, vz), wrapped to the period, mapped back to the
+// lattice coordinates uvw = M * v and hashed to a normalised gradient
+template <class V>
+static inline void pgrad3(V vx, V vy, V vz, V repx, V repy, V repz,
+                          V &gx, V &gy, V &gz) {
+    vx = mod(vx, repx);
+    vy = mod(vy, repy);
+    vz = mod(vz, repz);
+    V iu = mod289(floor(vy + vz + 0.5f));
+    V iv = mod289(floor(vx + vz + 0.5f));
+    V iw = mod289(floor(vx + vy + 0.5f));
+    grad3(permute(permute(permute(iw) + iv) + iu), gx, gy, gz);
+}
+
+// Periodic 3D simplex noise, with periods repx, repy and repz, positive
+// whole numbers
+template <class V>
+static inline V psnoise(V Px, V Py, V Pz, V repx, V repy, V repz) {
+// First corner, in uvw = M * P
+    V i0x = floor(Py + Pz), i0y = floor(Px + Pz), i0z = floor(Px + Py);
+    V f0x = fract(Py + Pz), f0y = fract(Px + Pz), f0z = fract(Px + Py);
+
+// Other corners, stepping first along the largest component of f0
+    V g_x = step(f0x, f0y), g_y = step(f0y, f0z), g_z = step(f0x, f0z);
+    V l_x = 1.0f - g_x, l_y = 1.0f - g_y, l_z = 1.0f - g_z;
+    V o1x = min(l_z, l_x), o1y = min(g_x, l_y), o1z = min(g_y, g_z);
+    V o2x = max(l_z, l_x), o2y = max(g_x, l_y), o2z = max(g_y, g_z);
+
+    // The corners in (x,y,z), v = Mi * i, with Mi = (J - 2I) / 2
+    auto corner = [](V ix, V iy, V iz, V &vx, V &vy, V &vz) {
+        V h = (ix + iy + iz) * 0.5f;
+        vx = h - ix;
+        vy = h - iy;
+        vz = h - iz;
+    };
+    V v0x, v0y, v0z, v1x, v1y, v1z, v2x, v2y, v2z, v3x, v3y, v3z;
+    corner(i0x, i0y, i0z, v0x, v0y, v0z);
+    corner(i0x + o1x, i0y + o1y, i0z + o1z, v1x, v1y, v1z);
+    corner(i0x + o2x, i0y + o2y, i0z + o2z, v2x, v2y, v2z);
+    corner(i0x + 1.0f, i0y + 1.0f, i0z + 1.0f, v3x, v3y, v3z);
+    V x0x = Px - v0x, x0y = Py - v0y, x0z = Pz - v0z;
+    V x1x = Px - v1x, x1y = Py - v1y, x1z = Pz - v1z;
+    V x2x = Px - v2x, x2y = Py - v2y, x2z = Pz - v2z;
+    V x3x = Px - v3x, x3y = Py - v3y, x3z = Pz - v3z;
+
+// Wrapped, hashed and normalised gradients
+    V g0x, g0y, g0z, g1x, g1y, g1z, g2x, g2y, g2z, g3x, g3y, g3z;
+    pgrad3(v0x, v0y, v0z, repx, repy, repz, g0x, g0y, g0z);
+    pgrad3(v1x, v1y, v1z, repx, repy, repz, g1x, g1y, g1z);
+    pgrad3(v2x, v2y, v2z, repx, repy, repz, g2x, g2y, g2z);
+    pgrad3(v3x, v3y, v3z, repx, repy, repz, g3x, g3y, g3z);
+
+// Mix final noise value
+    V m0 = max(0.5f - (x0x * x0x + x0y * x0y + x0z * x0z), V(0.0f));
+    V m1 = max(0.5f - (x1x * x1x + x1y * x1y + x1z * x1z), V(0.0f));
+    V m2 = max(0.5f - (x2x * x2x + x2y * x2y + x2z * x2z), V(0.0f));
+    V m3 = max(0.5f - (x3x * x3x + x3y * x3y + x3z * x3z), V(0.0f));
+    m0 = m0 * m0;
+    m1 = m1 * m1;
+    m2 = m2 * m2;
+    m3 = m3 * m3;
+    return 105.0f * (m0 * m0 * (g0x * x0x + g0y * x0y + g0z * x0z)
+                   + m1 * m1 * (g1x * x1x + g1y * x1y + g1z * x1z)
+                   + m2 * m2 * (g2x * x2x + g2y * x2y + g2z * x2z)
+                   + m3 * m3 * (g3x * x3x + g3y * x3y + g3z * x3z));
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,127 @@
+//
+// Description : C++ port of the GLSL periodic 4D simplex noise function
+//               in ../src/psnoise4D.glsl.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// As in noise4D.h, the code follows the shader line by line, with the
+// skew factors rounded to 1/4 and 1/8 as in the shader.
+//
+
+#ifndef WEBGLNOISE_PSNOISE4D_H
+#define WEBGLNOISE_PSNOISE4D_H
+
+#include "noise4D.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// The lattice point of the simplex corner at v, wrapped to the period,
+// as pwrap4() in the shader
+template <class V>
+static inline void pwrap4(V &vx, V &vy, V &vz, V &vw, V repx, V repy, V repz, V repw) {
+    vx = mod(vx, repx);
+    vy = mod(vy, repy);
+    vz = mod(vz, repz);
+    vw = mod(vw, repw);
+    V s = vx * 0.25f + vy * 0.25f + vz * 0.25f + vw * 0.25f;
+    vx = mod289(floor(vx + s + 0.5f));
+    vy = mod289(floor(vy + s + 0.5f));
+    vz = mod289(floor(vz + s + 0.5f));
+    vw = mod289(floor(vw + s + 0.5f));
+}
+
+// Periodic 4D simplex noise, with periods repx .. repw, positive
+// multiples of 4
+template <class V>
+static inline V psnoise(V vx, V vy, V vz, V vw, V repx, V repy, V repz, V repw) {
+    const float F4 = 0.25f;   // Rounded from (sqrt(5) - 1)/4
+    const float Cx = 0.125f,  // G4, rounded from (5 - sqrt(5))/20
+                Cy = 0.25f,   // 2 * G4
+                Cz = 0.375f,  // 3 * G4
+                Cw = -0.5f;   // -1 + 4 * G4
+
+// First corner
+    V s = vx * F4 + vy * F4 + vz * F4 + vw * F4;
+    V ix = floor(vx + s), iy = floor(vy + s), iz = floor(vz + s), iw = floor(vw + s);
+    V t = ix * Cx + iy * Cx + iz * Cx + iw * Cx;
+    V x0x = vx - ix + t, x0y = vy - iy + t, x0z = vz - iz + t, x0w = vw - iw + t;
+
+// Other corners
+
+// Rank sorting originally contributed by Bill Licea-Kane, AMD (formerly ATI)
+    V isXx = step(x0y, x0x), isXy = step(x0z, x0x), isXz = step(x0w, x0x);
+    V isYZx = step(x0z, x0y), isYZy = step(x0w, x0y), isYZz = step(x0w, x0z);
+    V i0x = isXx + isXy + isXz;
+    V i0y = 1.0f - isXx, i0z = 1.0f - isXy, i0w = 1.0f - isXz;
+    i0y += isYZx + isYZy;
+    i0z += 1.0f - isYZx;
+    i0w += 1.0f - isYZy;
+    i0z += isYZz;
+    i0w += 1.0f - isYZz;
+
+    // i0 now contains the unique values 0,1,2,3 in each channel
+    V i3x = clamp(i0x, V(0.0f), V(1.0f)), i3y = clamp(i0y, V(0.0f), V(1.0f));
+    V i3z = clamp(i0z, V(0.0f), V(1.0f)), i3w = clamp(i0w, V(0.0f), V(1.0f));
+    V i2x = clamp(i0x - 1.0f, V(0.0f), V(1.0f)), i2y = clamp(i0y - 1.0f, V(0.0f), V(1.0f));
+    V i2z = clamp(i0z - 1.0f, V(0.0f), V(1.0f)), i2w = clamp(i0w - 1.0f, V(0.0f), V(1.0f));
+    V i1x = clamp(i0x - 2.0f, V(0.0f), V(1.0f)), i1y = clamp(i0y - 2.0f, V(0.0f), V(1.0f));
+    V i1z = clamp(i0z - 2.0f, V(0.0f), V(1.0f)), i1w = clamp(i0w - 2.0f, V(0.0f), V(1.0f));
+
+    V x1x = x0x - i1x + Cx, x1y = x0y - i1y + Cx, x1z = x0z - i1z + Cx, x1w = x0w - i1w + Cx;
+    V x2x = x0x - i2x + Cy, x2y = x0y - i2y + Cy, x2z = x0z - i2z + Cy, x2w = x0w - i2w + Cy;
+    V x3x = x0x - i3x + Cz, x3y = x0y - i3y + Cz, x3z = x0z - i3z + Cz, x3w = x0w - i3w + Cz;
+    V x4x = x0x + Cw, x4y = x0y + Cw, x4z = x0z + Cw, x4w = x0w + Cw;
+
+// Wrap the corners to the period and hash them. The corners are exact,
+// as G4 is a power of two.
+    V v0x = ix - t, v0y = iy - t, v0z = iz - t, v0w = iw - t;
+    V k0x = v0x, k0y = v0y, k0z = v0z, k0w = v0w;
+    V k1x = v0x + i1x - Cx, k1y = v0y + i1y - Cx, k1z = v0z + i1z - Cx, k1w = v0w + i1w - Cx;
+    V k2x = v0x + i2x - Cy, k2y = v0y + i2y - Cy, k2z = v0z + i2z - Cy, k2w = v0w + i2w - Cy;
+    V k3x = v0x + i3x - Cz, k3y = v0y + i3y - Cz, k3z = v0z + i3z - Cz, k3w = v0w + i3w - Cz;
+    V k4x = v0x - Cw, k4y = v0y - Cw, k4z = v0z - Cw, k4w = v0w - Cw;
+    pwrap4(k0x, k0y, k0z, k0w, repx, repy, repz, repw);
+    pwrap4(k1x, k1y, k1z, k1w, repx, repy, repz, repw);
+    pwrap4(k2x, k2y, k2z, k2w, repx, repy, repz, repw);
+    pwrap4(k3x, k3y, k3z, k3w, repx, repy, repz, repw);
+    pwrap4(k4x, k4y, k4z, k4w, repx, repy, repz, repw);
+    V j0 = permute(permute(permute(permute(k0w) + k0z) + k0y) + k0x);
+    V j1 = permute(permute(permute(permute(k1w) + k1z) + k1y) + k1x);
+    V j2 = permute(permute(permute(permute(k2w) + k2z) + k2y) + k2x);
+    V j3 = permute(permute(permute(permute(k3w) + k3z) + k3y) + k3x);
+    V j4 = permute(permute(permute(permute(k4w) + k4z) + k4y) + k4x);
+
+// Normalised gradients
+    V p0x, p0y, p0z, p0w, p1x, p1y, p1z, p1w, p2x, p2y, p2z, p2w;
+    V p3x, p3y, p3z, p3w, p4x, p4y, p4z, p4w;
+    grad4(j0, p0x, p0y, p0z, p0w);
+    grad4(j1, p1x, p1y, p1z, p1w);
+    grad4(j2, p2x, p2y, p2z, p2w);
+    grad4(j3, p3x, p3y, p3z, p3w);
+    grad4(j4, p4x, p4y, p4z, p4w);
+
+// Mix contributions from the five corners
+    V m0 = max(0.6f - (x0x * x0x + x0y * x0y + x0z * x0z + x0w * x0w), V(0.0f));
+    V m1 = max(0.6f - (x1x * x1x + x1y * x1y + x1z * x1z + x1w * x1w), V(0.0f));
+    V m2 = max(0.6f - (x2x * x2x + x2y * x2y + x2z * x2z + x2w * x2w), V(0.0f));
+    V m3 = max(0.6f - (x3x * x3x + x3y * x3y + x3z * x3z + x3w * x3w), V(0.0f));
+    V m4 = max(0.6f - (x4x * x4x + x4y * x4y + x4z * x4z + x4w * x4w), V(0.0f));
+    m0 = m0 * m0;
+    m1 = m1 * m1;
+    m2 = m2 * m2;
+    m3 = m3 * m3;
+    m4 = m4 * m4;
+    return 49.0f * (m0 * m0 * (p0x * x0x + p0y * x0y + p0z * x0z + p0w * x0w)
+                  + m1 * m1 * (p1x * x1x + p1y * x1y + p1z * x1z + p1w * x1w)
+                  + m2 * m2 * (p2x * x2x + p2y * x2y + p2z * x2z + p2w * x2w)
+                  + m3 * m3 * (p3x * x3x + p3y * x3y + p3z * x3z + p3w * x3w)
+                  + m4 * m4 * (p4x * x4x + p4y * x4y + p4z * x4z + p4w * x4w));
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,136 @@
+//
+// Description : C++ port of the GLSL 3D tiling simplex noise with rotating
+//               gradients and analytic derivatives in ../src/psrdnoise3D.glsl.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// The simplex grid is that of psnoise3D.h. The period and the rotation
+// are the same for all points of a call, so the shader's branches on them
+// stay branches here, and sin() and cos() of the rotation are taken once.
+//
+
+#ifndef WEBGLNOISE_PSRDNOISE3D_H
+#define WEBGLNOISE_PSRDNOISE3D_H
+
+#include "helpers.h"
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+// The simplex of P: the vectors (x[c], y[c], z[c]) from its corners to P,
+// and the hash h[c] of each corner, wrapped to the period along the axes
+// where it is not 0, as psrd3_simplex() in the shader
+template <class V>
+static inline void psrd3_simplex(V Px, V Py, V Pz, float perx, float pery, float perz,
+                                 V (&x)[4], V (&y)[4], V (&z)[4], V (&h)[4]) {
+// First corner, in uvw = M * P
+    V i0x = floor(Py + Pz), i0y = floor(Px + Pz), i0z = floor(Px + Py);
+    V f0x = fract(Py + Pz), f0y = fract(Px + Pz), f0z = fract(Px + Py);
+
+// Other corners, stepping first along the largest component of f0
+    V g_x = step(f0x, f0y), g_y = step(f0y, f0z), g_z = step(f0x, f0z);
+    V l_x = 1.0f - g_x, l_y = 1.0f - g_y, l_z = 1.0f - g_z;
+    V ix[4] = { i0x, i0x + min(l_z, l_x), i0x + max(l_z, l_x), i0x + 1.0f };
+    V iy[4] = { i0y, i0y + min(g_x, l_y), i0y + max(g_x, l_y), i0y + 1.0f };
+    V iz[4] = { i0z, i0z + min(g_y, g_z), i0z + max(g_y, g_z), i0z + 1.0f };
+
+    for (int c = 0; c < 4; c++) {
+        // The corner in (x,y,z), v = Mi * i, with Mi = (J - 2I) / 2
+        V hc = (ix[c] + iy[c] + iz[c]) * 0.5f;
+        V vx = hc - ix[c], vy = hc - iy[c], vz = hc - iz[c];
+        x[c] = Px - vx;
+        y[c] = Py - vy;
+        z[c] = Pz - vz;
+
+        // Wrapped where there is a period, and mapped back to uvw
+        if (perx > 0.0f) vx = mod(vx, V(perx));
+        if (pery > 0.0f) vy = mod(vy, V(pery));
+        if (perz > 0.0f) vz = mod(vz, V(perz));
+        V iu = mod289(floor(vy + vz + 0.5f));
+        V iv = mod289(floor(vx + vz + 0.5f));
+        V iw = mod289(floor(vx + vy + 0.5f));
+        h[c] = permute(permute(permute(iw) + iv) + iu);
+    }
+}
+
+// The gradient for hash h, a point on a Fibonacci spiral on the unit
+// sphere, rotated by the angle with sine Sa and cosine Ca around an axis
+// perpendicular to it, as rgrad3() in the shader
+template <class V>
+static inline void rgrad3(V h, bool rotate, V Sa, V Ca, V &gx, V &gy, V &gz) {
+    V theta = h * 3.883222077f;             // 2*pi/golden ratio
+    V sz = h * -0.006920415f + 0.996539792f; // 1-(hash+0.5)*2/289
+    V St, Ct;
+    sincos(theta, St, Ct);
+    V sz_prime = sqrt(1.0f - sz * sz);
+    V px = Ct * sz_prime, py = St * sz_prime, pz = sz;
+    if (!rotate) {
+        gx = px;
+        gy = py;
+        gz = pz;
+        return;
+    }
+    V Sp, Cp;
+    sincos(h * 0.108705628f, Sp, Cp);       // psi = 10*pi/289 * hash
+    V Ctp = St * Sp - Ct * Cp;
+    V qx = mix(Ctp * St, Sp, sz);
+    V qy = mix(-Ctp * Ct, Cp, sz);
+    V qz = -(py * Cp + px * Sp);
+    gx = Ca * px + Sa * qx;
+    gy = Ca * py + Sa * qy;
+    gz = Ca * pz + Sa * qz;
+}
+
+// 3D tiling simplex noise with rotating gradients, and its gradient in
+// (dx, dy, dz). Sa and Ca are the sine and cosine of the rotation, which
+// is skipped unless rotate is set.
+template <class V>
+static inline V psrdnoise(V Px, V Py, V Pz, float perx, float pery, float perz,
+                          bool rotate, V Sa, V Ca, V &dx, V &dy, V &dz) {
+    V x[4], y[4], z[4], h[4];
+    psrd3_simplex(Px, Py, Pz, perx, pery, perz, x, y, z, h);
+
+    V n = V(0.0f);
+    dx = dy = dz = V(0.0f);
+    for (int c = 0; c < 4; c++) {
+        V gx, gy, gz;
+        rgrad3(h[c], rotate, Sa, Ca, gx, gy, gz);
+        V w = max(0.5f - (x[c] * x[c] + y[c] * y[c] + z[c] * z[c]), V(0.0f));
+        V w2 = w * w;
+        V w3 = w2 * w;
+        V gdotx = gx * x[c] + gy * y[c] + gz * z[c];
+        n += w3 * gdotx;
+        V dw = -6.0f * w2 * gdotx;
+        dx += w3 * gx + dw * x[c];
+        dy += w3 * gy + dw * y[c];
+        dz += w3 * gz + dw * z[c];
+    }
+    dx *= 39.5f;
+    dy *= 39.5f;
+    dz *= 39.5f;
+    return 39.5f * n;
+}
+
+// The same without the gradient, as psrnoise() in the shader
+template <class V>
+static inline V psrnoise(V Px, V Py, V Pz, float perx, float pery, float perz,
+                         bool rotate, V Sa, V Ca) {
+    V x[4], y[4], z[4], h[4];
+    psrd3_simplex(Px, Py, Pz, perx, pery, perz, x, y, z, h);
+
+    V n = V(0.0f);
+    for (int c = 0; c < 4; c++) {
+        V gx, gy, gz;
+        rgrad3(h[c], rotate, Sa, Ca, gx, gy, gz);
+        V w = max(0.5f - (x[c] * x[c] + y[c] * y[c] + z[c] * z[c]), V(0.0f));
+        n += w * w * w * (gx * x[c] + gy * y[c] + gz * z[c]);
+    }
+    return 39.5f * n;
+}
+
+}
+}
+
+#endif
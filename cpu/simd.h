@@ -0,0 +1,296 @@
+//
+// Description : SIMD vector type for the CPU noise kernels, with the
+//               GLSL built-in functions they use.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// A vfloat holds one float per point ("vertical" SIMD), so a kernel
+// reads like the GLSL code with every vecN written out as N vfloats.
+// Comparisons give a vmask, which select() uses like GLSL's ?:, and
+// any() tests for any lane set, like GLSL's any().
+// The built-ins with no single instruction, such as fract(), mod() and
+// sincos(), are written once at the end in terms of the others.
+// A vuint holds 32-bit unsigned integers, for integer hashing, and
+// gather() looks up one table entry per lane. lookup64() does the same
+// in a table of 64 entries, which AVX-512 can keep in registers.
+// The widest instruction set enabled for the translation unit decides
+// the width: AVX-512 (16 lanes), AVX2 with FMA (8 lanes), SSE4.1
+// (4 lanes) or scalar code.
+//
+// Everything is put in a namespace named by WEBGLNOISE_ISA, so that
+// the same kernels can be compiled once per instruction set and linked
+// into one library without clashes, see kernels.cpp.
+//
+
+#ifndef WEBGLNOISE_SIMD_H
+#define WEBGLNOISE_SIMD_H
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#else
+#include <math.h>
+#endif
+
+namespace webglnoise {
+namespace WEBGLNOISE_ISA {
+
+#if defined(__AVX512F__)
+
+struct vfloat {
+    enum { width = 16 };
+    __m512 v;
+    vfloat() {}
+    vfloat(__m512 a) : v(a) {}
+    vfloat(float a) : v(_mm512_set1_ps(a)) {}
+};
+
+struct vmask {
+    __mmask16 v;
+    vmask(__mmask16 a) : v(a) {}
+};
+
+static inline vfloat load(const float *p) { return _mm512_loadu_ps(p); }
+static inline void store(float *p, vfloat a) { _mm512_storeu_ps(p, a.v); }
+
+static inline vfloat operator+(vfloat a, vfloat b) { return _mm512_add_ps(a.v, b.v); }
+static inline vfloat operator-(vfloat a, vfloat b) { return _mm512_sub_ps(a.v, b.v); }
+static inline vfloat operator*(vfloat a, vfloat b) { return _mm512_mul_ps(a.v, b.v); }
+static inline vfloat operator/(vfloat a, vfloat b) { return _mm512_div_ps(a.v, b.v); }
+static inline vfloat operator-(vfloat a) { return _mm512_sub_ps(_mm512_setzero_ps(), a.v); }
+
+static inline vfloat floor(vfloat a) { return _mm512_floor_ps(a.v); }
+static inline vfloat abs(vfloat a) { return _mm512_abs_ps(a.v); }
+// The zero-masked forms with a full mask are the same instructions, but
+// avoid spurious -Wuninitialized warnings from the headers of GCC 12
+static inline vfloat min(vfloat a, vfloat b) { return _mm512_maskz_min_ps(0xffff, a.v, b.v); }
+static inline vfloat max(vfloat a, vfloat b) { return _mm512_maskz_max_ps(0xffff, a.v, b.v); }
+static inline vfloat sqrt(vfloat a) { return _mm512_maskz_sqrt_ps(0xffff, a.v); }
+
+static inline vmask lessThan(vfloat a, vfloat b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ); }
+static inline vfloat select(vmask m, vfloat a, vfloat b) { return _mm512_mask_blend_ps(m.v, b.v, a.v); }
+static inline bool any(vmask m) { return m.v != 0; }
+
+struct vuint {
+    __m512i v;
+    vuint(__m512i a) : v(a) {}
+    vuint(unsigned a) : v(_mm512_set1_epi32((int)a)) {}
+};
+
+static inline vuint toUint(vfloat a) { return _mm512_maskz_cvttps_epi32(0xffff, a.v); }
+static inline vuint operator+(vuint a, vuint b) { return _mm512_add_epi32(a.v, b.v); }
+static inline vuint operator*(vuint a, vuint b) { return _mm512_mullo_epi32(a.v, b.v); }
+static inline vuint operator^(vuint a, vuint b) { return _mm512_xor_si512(a.v, b.v); }
+static inline vuint operator>>(vuint a, int n) {
+    return _mm512_maskz_srl_epi32(0xffff, a.v, _mm_cvtsi32_si128(n));
+}
+static inline vfloat gather(const float *table, vuint i) {
+    return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff, i.v, table, 4);
+}
+// Two vpermt2ps on the 32-entry halves, picked by bit 5 of the index
+static inline vfloat lookup64(const float *table, vuint i) {
+    __m512 lo = _mm512_permutex2var_ps(_mm512_loadu_ps(table), i.v,
+                                       _mm512_loadu_ps(table + 16));
+    __m512 hi = _mm512_permutex2var_ps(_mm512_loadu_ps(table + 32), i.v,
+                                       _mm512_loadu_ps(table + 48));
+    __mmask16 m = _mm512_test_epi32_mask(i.v, _mm512_set1_epi32(32));
+    return _mm512_mask_blend_ps(m, lo, hi);
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+struct vfloat {
+    enum { width = 8 };
+    __m256 v;
+    vfloat() {}
+    vfloat(__m256 a) : v(a) {}
+    vfloat(float a) : v(_mm256_set1_ps(a)) {}
+};
+
+struct vmask {
+    __m256 v;
+    vmask(__m256 a) : v(a) {}
+};
+
+static inline vfloat load(const float *p) { return _mm256_loadu_ps(p); }
+static inline void store(float *p, vfloat a) { _mm256_storeu_ps(p, a.v); }
+
+static inline vfloat operator+(vfloat a, vfloat b) { return _mm256_add_ps(a.v, b.v); }
+static inline vfloat operator-(vfloat a, vfloat b) { return _mm256_sub_ps(a.v, b.v); }
+static inline vfloat operator*(vfloat a, vfloat b) { return _mm256_mul_ps(a.v, b.v); }
+static inline vfloat operator/(vfloat a, vfloat b) { return _mm256_div_ps(a.v, b.v); }
+static inline vfloat operator-(vfloat a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+
+static inline vfloat floor(vfloat a) { return _mm256_floor_ps(a.v); }
+static inline vfloat abs(vfloat a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+static inline vfloat min(vfloat a, vfloat b) { return _mm256_min_ps(a.v, b.v); }
+static inline vfloat max(vfloat a, vfloat b) { return _mm256_max_ps(a.v, b.v); }
+static inline vfloat sqrt(vfloat a) { return _mm256_sqrt_ps(a.v); }
+
+static inline vmask lessThan(vfloat a, vfloat b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+static inline vfloat select(vmask m, vfloat a, vfloat b) { return _mm256_blendv_ps(b.v, a.v, m.v); }
+static inline bool any(vmask m) { return _mm256_movemask_ps(m.v) != 0; }
+
+struct vuint {
+    __m256i v;
+    vuint(__m256i a) : v(a) {}
+    vuint(unsigned a) : v(_mm256_set1_epi32((int)a)) {}
+};
+
+static inline vuint toUint(vfloat a) { return _mm256_cvttps_epi32(a.v); }
+static inline vuint operator+(vuint a, vuint b) { return _mm256_add_epi32(a.v, b.v); }
+static inline vuint operator*(vuint a, vuint b) { return _mm256_mullo_epi32(a.v, b.v); }
+static inline vuint operator^(vuint a, vuint b) { return _mm256_xor_si256(a.v, b.v); }
+static inline vuint operator>>(vuint a, int n) { return _mm256_srl_epi32(a.v, _mm_cvtsi32_si128(n)); }
+// Eight scalar loads, as the gather instructions are no faster than that
+// on many CPUs (microcoded on AMD, and slowed down by the mitigation for
+// "Downfall" on Intel)
+static inline vfloat gather(const float *table, vuint i) {
+    alignas(32) int k[8];
+    _mm256_store_si256((__m256i *)k, i.v);
+    return _mm256_setr_ps(table[k[0]], table[k[1]], table[k[2]], table[k[3]],
+                          table[k[4]], table[k[5]], table[k[6]], table[k[7]]);
+}
+
+#elif defined(__SSE4_1__)
+
+struct vfloat {
+    enum { width = 4 };
+    __m128 v;
+    vfloat() {}
+    vfloat(__m128 a) : v(a) {}
+    vfloat(float a) : v(_mm_set1_ps(a)) {}
+};
+
+struct vmask {
+    __m128 v;
+    vmask(__m128 a) : v(a) {}
+};
+
+static inline vfloat load(const float *p) { return _mm_loadu_ps(p); }
+static inline void store(float *p, vfloat a) { _mm_storeu_ps(p, a.v); }
+
+static inline vfloat operator+(vfloat a, vfloat b) { return _mm_add_ps(a.v, b.v); }
+static inline vfloat operator-(vfloat a, vfloat b) { return _mm_sub_ps(a.v, b.v); }
+static inline vfloat operator*(vfloat a, vfloat b) { return _mm_mul_ps(a.v, b.v); }
+static inline vfloat operator/(vfloat a, vfloat b) { return _mm_div_ps(a.v, b.v); }
+static inline vfloat operator-(vfloat a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+
+static inline vfloat floor(vfloat a) { return _mm_floor_ps(a.v); }
+static inline vfloat abs(vfloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+static inline vfloat min(vfloat a, vfloat b) { return _mm_min_ps(a.v, b.v); }
+static inline vfloat max(vfloat a, vfloat b) { return _mm_max_ps(a.v, b.v); }
+static inline vfloat sqrt(vfloat a) { return _mm_sqrt_ps(a.v); }
+
+static inline vmask lessThan(vfloat a, vfloat b) { return _mm_cmplt_ps(a.v, b.v); }
+static inline vfloat select(vmask m, vfloat a, vfloat b) { return _mm_blendv_ps(b.v, a.v, m.v); }
+static inline bool any(vmask m) { return _mm_movemask_ps(m.v) != 0; }
+
+struct vuint {
+    __m128i v;
+    vuint(__m128i a) : v(a) {}
+    vuint(unsigned a) : v(_mm_set1_epi32((int)a)) {}
+};
+
+static inline vuint toUint(vfloat a) { return _mm_cvttps_epi32(a.v); }
+static inline vuint operator+(vuint a, vuint b) { return _mm_add_epi32(a.v, b.v); }
+static inline vuint operator*(vuint a, vuint b) { return _mm_mullo_epi32(a.v, b.v); }
+static inline vuint operator^(vuint a, vuint b) { return _mm_xor_si128(a.v, b.v); }
+static inline vuint operator>>(vuint a, int n) { return _mm_srl_epi32(a.v, _mm_cvtsi32_si128(n)); }
+static inline vfloat gather(const float *table, vuint i) {
+    return _mm_setr_ps(table[_mm_extract_epi32(i.v, 0)], table[_mm_extract_epi32(i.v, 1)],
+                       table[_mm_extract_epi32(i.v, 2)], table[_mm_extract_epi32(i.v, 3)]);
+}
+
+#else
+
+struct vfloat {
+    enum { width = 1 };
+    float v;
+    vfloat() {}
+    vfloat(float a) : v(a) {}
+};
+
+struct vmask {
+    bool v;
+    vmask(bool a) : v(a) {}
+};
+
+static inline vfloat load(const float *p) { return *p; }
+static inline void store(float *p, vfloat a) { *p = a.v; }
+
+static inline vfloat operator+(vfloat a, vfloat b) { return a.v + b.v; }
+static inline vfloat operator-(vfloat a, vfloat b) { return a.v - b.v; }
+static inline vfloat operator*(vfloat a, vfloat b) { return a.v * b.v; }
+static inline vfloat operator/(vfloat a, vfloat b) { return a.v / b.v; }
+static inline vfloat operator-(vfloat a) { return -a.v; }
+
+static inline vfloat floor(vfloat a) { return floorf(a.v); }
+static inline vfloat abs(vfloat a) { return fabsf(a.v); }
+static inline vfloat min(vfloat a, vfloat b) { return b.v < a.v ? b.v : a.v; }
+static inline vfloat max(vfloat a, vfloat b) { return a.v < b.v ? b.v : a.v; }
+static inline vfloat sqrt(vfloat a) { return sqrtf(a.v); }
+
+static inline vmask lessThan(vfloat a, vfloat b) { return a.v < b.v; }
+static inline vfloat select(vmask m, vfloat a, vfloat b) { return m.v ? a : b; }
+static inline bool any(vmask m) { return m.v; }
+
+struct vuint {
+    unsigned v;
+    vuint(unsigned a) : v(a) {}
+};
+
+static inline vuint toUint(vfloat a) { return (unsigned)(int)a.v; }
+static inline vuint operator+(vuint a, vuint b) { return a.v + b.v; }
+static inline vuint operator*(vuint a, vuint b) { return a.v * b.v; }
+static inline vuint operator^(vuint a, vuint b) { return a.v ^ b.v; }
+static inline vuint operator>>(vuint a, int n) { return a.v >> n; }
+static inline vfloat gather(const float *table, vuint i) { return table[i.v]; }
+
+#endif
+
+#if !defined(__AVX512F__)
+static inline vfloat lookup64(const float *table, vuint i) { return gather(table, i); }
+#endif
+
+static inline vfloat &operator+=(vfloat &a, vfloat b) { return a = a + b; }
+static inline vfloat &operator-=(vfloat &a, vfloat b) { return a = a - b; }
+static inline vfloat &operator*=(vfloat &a, vfloat b) { return a = a * b; }
+
+// The remaining GLSL built-ins, written in terms of the ones above
+
+static inline vfloat fract(vfloat x) { return x - floor(x); }
+static inline vfloat step(vfloat edge, vfloat x) { return select(lessThan(x, edge), 0.0f, 1.0f); }
+static inline vfloat clamp(vfloat x, vfloat lo, vfloat hi) { return min(max(x, lo), hi); }
+static inline vfloat mix(vfloat a, vfloat b, vfloat t) { return a + (b - a) * t; }
+static inline vfloat mod(vfloat x, vfloat y) { return x - y * floor(x / y); }
+
+// sin(x) and cos(x) together, to within a few ulp for |x| < 8192.
+// x is reduced to r in [-pi/4, pi/4] by a multiple q of pi/2, with pi/2
+// split in three parts so that q * part is exact, and the polynomials
+// for r are those of the Cephes library. The quadrant q mod 4 then swaps
+// the two and sets the signs.
+static inline void sincos(vfloat x, vfloat &s, vfloat &c) {
+    vfloat q = floor(x * 0.636619772f + 0.5f);
+    vfloat r = x - q * 1.5703125f - q * 4.837512969970703125e-4f
+                 - q * 7.54978995489188216e-8f;
+    vfloat r2 = r * r;
+    vfloat sr = r + r * r2 * (-1.6666654611e-1f
+                + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    vfloat cr = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f
+                + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+    vfloat qm = mod(q, 4.0f);
+    vfloat odd = mod(qm, 2.0f);     // Quadrants 1 and 3 swap sin and cos
+    vfloat half = floor(qm * 0.5f); // Quadrants 2 and 3 negate sin
+    vmask swap = lessThan(0.5f, odd);
+    s = select(swap, cr, sr) * (1.0f - 2.0f * half);
+    c = select(swap, sr, cr) * (1.0f - 2.0f * abs(odd - half));
+}
+
+}
+}
+
+#endif
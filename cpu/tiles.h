@@ -0,0 +1,45 @@
+//
+// Description : Multi-threaded tile scheduler with work stealing,
+//               used by the image and volume generators.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+
+#ifndef WEBGLNOISE_TILES_H
+#define WEBGLNOISE_TILES_H
+
+#include "webglnoise.h"
+
+namespace webglnoise {
+
+// A box of samples [x0, x1) x [y0, y1) x [z0, z1)
+struct Tile {
+    int x0, y0, z0, x1, y1, z1;
+};
+
+// Split the image into tiles of at most sx * sy * sz samples and call
+// fn once for every tile, from the given number of threads (one per
+// core if 0). sx is rounded up to a multiple of 16 floats, so tiles
+// never share a cache line if the image is laid out as recommended.
+void for_each_tile(const Image &image, int sx, int sy, int sz, int threads,
+                   const std::function<void(const Tile &)> &fn);
+
+// Coordinate i of a grid along axis d, origin[d] + i * step[d]. All
+// generators compute the coordinates here, without fused multiply-adds,
+// so that they sample at exactly the same points.
+float grid_line(const Grid &grid, int d, int i);
+
+// Fill a tile by evaluating a noise function at every grid point. The
+// function is a plain one, with a context pointer, rather than a Noise3:
+// the kernels call this, and a std::function built in them would have
+// members shared by all the instruction sets (see buffer.h).
+typedef void (*TileNoise)(const void *context, const float *x, const float *y,
+                          const float *z, float *out, size_t n);
+void sample_tile(TileNoise noise, const void *context, const Image &image,
+                 const Grid &grid, const Tile &tile);
+
+}
+
+#endif
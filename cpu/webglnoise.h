@@ -0,0 +1,281 @@
+//
+// Description : C++ ports of the GLSL noise functions in ../src,
+//               for evaluating the same noise without a GPU.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// All functions work on whole arrays of points at a time, in
+// structure-of-arrays form: point k is (x[k], y[k], z[k]), and its
+// noise value is written to out[k]. The input and output arrays
+// may be of any length and alignment, but must not overlap.
+//
+
+#ifndef WEBGLNOISE_H
+#define WEBGLNOISE_H
+
+#include <stddef.h>
+#include <functional>
+
+namespace webglnoise {
+
+// 2D simplex noise, snoise(vec2) from noise2D.glsl
+void snoise2(const float *x, const float *y, float *out, size_t n);
+
+// 3D simplex noise, snoise(vec3) from noise3D.glsl
+void snoise3(const float *x, const float *y, const float *z,
+             float *out, size_t n);
+
+// Lattice hashes for snoise3_hash()
+enum Hash {
+    HASH_PERMUTE, // The shader's permutation polynomial (as above)
+    HASH_TABLE,   // The same, from lookup tables: same results
+    HASH_INT32    // 32-bit integer hash: other noise, no period of 289
+};
+
+// 3D simplex noise with the given lattice hash. HASH_PERMUTE and
+// HASH_TABLE give the same noise as the shader, HASH_INT32 a noise with
+// the same character but a different pattern, which does not repeat
+// every 289 units.
+void snoise3_hash(const float *x, const float *y, const float *z,
+                  float *out, size_t n, Hash hash);
+
+// Three and four channels of 3D simplex noise, snoise3v() and snoise4v()
+// from noise3D.glsl, e.g. for displacements and colour noise. The
+// channels share one pass over the simplex lattice but have independent
+// gradients. outx is the same as the output of snoise3.
+void snoise3v(const float *x, const float *y, const float *z,
+              float *outx, float *outy, float *outz, size_t n);
+void snoise4v(const float *x, const float *y, const float *z,
+              float *outx, float *outy, float *outz, float *outw, size_t n);
+
+// 4D simplex noise, snoise(vec4) from noise4D.glsl
+void snoise4(const float *x, const float *y, const float *z,
+             const float *w, float *out, size_t n);
+
+// 4D simplex noise with its gradient, snoise(vec4, out vec4) from
+// noise4Dgrad.glsl. The noise goes to out, the same as from snoise4,
+// and its partial derivatives to dx, dy, dz and dw.
+void snoise4_d(const float *x, const float *y, const float *z,
+               const float *w, float *out, float *dx, float *dy,
+               float *dz, float *dw, size_t n);
+
+// 2D, 3D and 4D classic Perlin noise, cnoise() from classicnoise*D.glsl
+void cnoise2(const float *x, const float *y, float *out, size_t n);
+void cnoise3(const float *x, const float *y, const float *z,
+             float *out, size_t n);
+void cnoise4(const float *x, const float *y, const float *z,
+             const float *w, float *out, size_t n);
+
+// Periodic classic Perlin noise, pnoise() from classicnoise*D.glsl,
+// with the period "rep" given per axis
+void pnoise2(const float *x, const float *y, float *out, size_t n,
+             float repx, float repy);
+void pnoise3(const float *x, const float *y, const float *z,
+             float *out, size_t n, float repx, float repy, float repz);
+void pnoise4(const float *x, const float *y, const float *z,
+             const float *w, float *out, size_t n,
+             float repx, float repy, float repz, float repw);
+
+// Classic and periodic Perlin noise with their gradients, cnoise_d()
+// and pnoise_d() from classicnoise*D.glsl. The noise goes to out and its
+// partial derivatives to dx, dy, ..., from one pass over the lattice
+// cell, which costs much less than finite differences with cnoise.
+void cnoise2_d(const float *x, const float *y, float *out,
+               float *dx, float *dy, size_t n);
+void cnoise3_d(const float *x, const float *y, const float *z,
+               float *out, float *dx, float *dy, float *dz, size_t n);
+void cnoise4_d(const float *x, const float *y, const float *z,
+               const float *w, float *out, float *dx, float *dy,
+               float *dz, float *dw, size_t n);
+void pnoise2_d(const float *x, const float *y, float *out,
+               float *dx, float *dy, size_t n, float repx, float repy);
+void pnoise3_d(const float *x, const float *y, const float *z,
+               float *out, float *dx, float *dy, float *dz, size_t n,
+               float repx, float repy, float repz);
+void pnoise4_d(const float *x, const float *y, const float *z,
+               const float *w, float *out, float *dx, float *dy,
+               float *dz, float *dw, size_t n,
+               float repx, float repy, float repz, float repw);
+
+// Periodic simplex noise, psnoise() from psnoise3D.glsl and
+// psnoise4D.glsl, with the period "rep" given per axis. The periods
+// must be whole numbers in 3D, and multiples of 4 in 4D. Much cheaper
+// than pnoise3 and pnoise4, e.g. for tiling volumes, or for looping
+// animations of a tiling image with 4D noise and time as w.
+void psnoise3(const float *x, const float *y, const float *z,
+              float *out, size_t n, float repx, float repy, float repz);
+void psnoise4(const float *x, const float *y, const float *z,
+              const float *w, float *out, size_t n,
+              float repx, float repy, float repz, float repw);
+
+// 3D tiling simplex noise with rotating gradients, psrdnoise() and
+// psrnoise() from psrdnoise3D.glsl. The period "per" is a whole number
+// per axis, or 0 for no tiling along that axis, and "rot" rotates the
+// gradients, in turns. psrdnoise3 also writes the analytic gradient of
+// the noise to dx, dy and dz. The other variants of the shader are
+// these with periods of 0 (srdnoise, srnoise), a rotation of 0
+// (psdnoise) or both (sdnoise, snoise). Its psnoise() is psnoise3.
+void psrdnoise3(const float *x, const float *y, const float *z,
+                float *out, float *dx, float *dy, float *dz, size_t n,
+                float perx = 0.0f, float pery = 0.0f, float perz = 0.0f,
+                float rot = 0.0f);
+void psrnoise3(const float *x, const float *y, const float *z,
+               float *out, size_t n, float perx = 0.0f, float pery = 0.0f,
+               float perz = 0.0f, float rot = 0.0f);
+
+// Curl noise, curlnoise() from curlnoise3D.glsl: a divergence-free
+// vector field (cx, cy, cz), the curl of a potential of three simplex
+// noise fields, for example as the velocity of particles. The fields
+// share one pass over the simplex lattice.
+void curlnoise3(const float *x, const float *y, const float *z,
+                float *cx, float *cy, float *cz, size_t n);
+
+// Cellular noise: cellular() from cellular2D.glsl and cellular3D.glsl,
+// which search 3x3 and 3x3x3 cells, and the faster cellular2x2x2() from
+// cellular2x2x2.glsl, which searches 2x2x2 cells and has a less reliable
+// F2. The distances to the nearest and second nearest feature points are
+// written to f1[k] and f2[k]. With squared set, they are squared
+// distances, which saves the square roots when the distances are only
+// compared.
+void cellular2(const float *x, const float *y, float *f1, float *f2, size_t n,
+               bool squared = false);
+void cellular3(const float *x, const float *y, const float *z,
+               float *f1, float *f2, size_t n, bool squared = false);
+void cellular2x2x2(const float *x, const float *y, const float *z,
+                   float *f1, float *f2, size_t n, bool squared = false);
+
+// Periodic cellular noise, pcellular() from cellular2D.glsl and
+// cellular3D.glsl, with the period "rep" given per axis, as whole
+// numbers. The pattern tiles seamlessly, e.g. for baking tileable
+// textures at their own size.
+void pcellular2(const float *x, const float *y, float *f1, float *f2, size_t n,
+                float repx, float repy, bool squared = false);
+void pcellular3(const float *x, const float *y, const float *z,
+                float *f1, float *f2, size_t n,
+                float repx, float repy, float repz, bool squared = false);
+
+// Cellular noise with the Voronoi cell of each point, cellular_voronoi()
+// from cellular2D.glsl and cellular3D.glsl, all from one 3x3 or 3x3x3
+// search: F1 and F2 as from cellular2 and cellular3, the hash (0 to 288)
+// of the cell that holds the nearest feature point, which identifies the
+// Voronoi cell, the vector from the point to that feature point, and the
+// distance to the nearest edge or face of the Voronoi cell, measured
+// perpendicular to it. Unlike F2 - F1, that is a true distance, which
+// gives borders of constant width.
+void cellular2_voronoi(const float *x, const float *y, float *f1, float *f2,
+                       float *id, float *fx, float *fy, float *border, size_t n);
+void cellular3_voronoi(const float *x, const float *y, const float *z,
+                       float *f1, float *f2, float *id, float *fx, float *fy,
+                       float *fz, float *border, size_t n);
+
+// Fractal sum of 3D simplex noise, fbm() from fbm3D.glsl: the sum over
+// octaves o = 0 .. octaves-1 of gain^o * snoise(p * lacunarity^o).
+// Faster than calling snoise3 once per octave, as each point is loaded
+// once and its octaves are evaluated together.
+void fbm3(const float *x, const float *y, const float *z,
+          float *out, size_t n, int octaves, float lacunarity, float gain);
+
+// Instruction sets the functions above have kernels for. The best
+// one the CPU supports is picked when the library is loaded.
+enum Isa {
+    ISA_SCALAR, // Plain C++, one point at a time
+    ISA_SSE41,  // 4 points at a time
+    ISA_AVX2,   // 8 points at a time, using AVX2 and FMA
+    ISA_AVX512  // 16 points at a time, using AVX-512F and FMA
+};
+
+// The instruction set in use
+Isa isa();
+const char *isa_name(Isa isa);
+bool isa_supported(Isa isa);
+
+// Switch to another instruction set, e.g. for benchmarking.
+// Returns false, and changes nothing, if the CPU lacks support.
+bool set_isa(Isa isa);
+
+//
+// Image and volume generation
+//
+
+// A batch noise function of 2 or 3 coordinates, like the ones above.
+// (Use a lambda to pass pnoise3 with its period, or a noise function
+// of your own.)
+typedef std::function<void(const float *x, const float *y,
+                           float *out, size_t n)> Noise2;
+typedef std::function<void(const float *x, const float *y, const float *z,
+                           float *out, size_t n)> Noise3;
+
+// An image (depth 1) or volume of floats. Sample (i, j, k) is stored
+// at data[i + j * pitch + k * pitch * height].
+//
+// The generators split the output into tiles whose rows start and end
+// on 64 byte cache line boundaries, so that no two threads ever write
+// to the same cache line. That requires data to be 64 byte aligned and
+// pitch to be a multiple of 16, as given by image_pitch(). Other
+// layouts work too, but threads may then share a cache line at the
+// edges of tiles.
+struct Image {
+    float *data;
+    int width, height, depth;
+    size_t pitch;
+};
+
+size_t image_pitch(int width);
+
+// The coordinates of sample (i, j, k) are origin + (i, j, k) * step
+struct Grid {
+    float origin[3];
+    float step[3];
+};
+
+// Fill an image or volume with noise, using the given number of
+// threads, or one per core if threads is 0. 2D noise is evaluated
+// at (x, y) for every slice of a volume.
+void generate(const Noise2 &noise, const Image &image, const Grid &grid,
+              int threads = 0);
+void generate(const Noise3 &noise, const Image &image, const Grid &grid,
+              int threads = 0);
+
+// The same as generate(snoise3, image, grid, threads), to within a few
+// ULP, but much faster for dense grids, with steps well below 1. Instead
+// of finding the simplex around every grid point, this goes through the
+// lattice vertices near each brick of the volume, and adds the kernel of
+// each vertex to all grid points within its radius.
+// The exception is grid points on the main diagonal of a lattice cube,
+// where x - y and y - z are whole numbers. There snoise() takes a flat
+// simplex and is discontinuous, and this gives the continuous value
+// instead, e.g. 0 rather than -0.436 at (0, 0, 0). With an origin of 0
+// and equal steps, that is every sample (i, i, i). An origin whose
+// components do not differ by multiples of the step, like (0.123,
+// 0.456, 0.789) with a step of 0.01, keeps all samples off it.
+void generate_snoise3(const Image &image, const Grid &grid, int threads = 0);
+
+// The same as generate() with cnoise2, cnoise3, pnoise2 or pnoise3, to
+// within a few ULP, but much faster for dense grids. Classic noise is
+// separable on a grid: the fade weights and lattice coordinates are
+// computed once per grid line and axis, the corner gradients once per
+// lattice cell, and each sample is a blend of a few precomputed terms.
+// The 2D variants evaluate (x, y) for every slice of a volume.
+void generate_cnoise2(const Image &image, const Grid &grid, int threads = 0);
+void generate_cnoise3(const Image &image, const Grid &grid, int threads = 0);
+void generate_pnoise2(const Image &image, const Grid &grid, float repx, float repy,
+                      int threads = 0);
+void generate_pnoise3(const Image &image, const Grid &grid, float repx, float repy,
+                      float repz, int threads = 0);
+
+// The same as cellular2 or cellular3 at every point of a grid, bit for
+// bit, but much faster for dense grids. The feature points of all cells
+// near a brick are computed once, and each sample only measures the
+// distances to its neighbouring feature points. F1 is written to f1,
+// and F2 to f2, which must have the same size, unless f2.data is null.
+// cellular2 is evaluated at (x, y) for every slice of a volume.
+void generate_cellular2(const Image &f1, const Image &f2, const Grid &grid,
+                        bool squared = false, int threads = 0);
+void generate_cellular3(const Image &f1, const Image &f2, const Grid &grid,
+                        bool squared = false, int threads = 0);
+
+}
+
+#endif
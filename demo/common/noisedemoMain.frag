@@ -13,9 +13,7 @@ void main( void )
 {
 #if (1)
   // Perturb the texcoords with three components of noise
-  vec3 uvw = v_texCoord3D + 0.1*vec3(snoise(v_texCoord3D + vec3(0.0, 0.0, time)),
-    snoise(v_texCoord3D + vec3(43.0, 17.0, time)),
-	snoise(v_texCoord3D + vec3(-17.0, -43.0, time)));
+  vec3 uvw = v_texCoord3D + 0.1*snoise3v(v_texCoord3D + vec3(0.0, 0.0, time));
   // Six components of noise in a fractal sum
   float n = snoise(uvw - vec3(0.0, 0.0, time));
   n += 0.5 * snoise(uvw * 2.0 - vec3(0.0, 0.0, time*1.4)); 
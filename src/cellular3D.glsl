@@ -18,7 +18,7 @@ vec3 mod7(vec3 x) {
 
 // Permutation polynomial: (34x^2 + 6x) mod 289
 vec3 permute(vec3 x) {
-  return mod289((34.0 * x + 10.0) * x);
+  return mod289(((x*34.0)+10.0)*x);
 }
 
 // Cellular noise, returning F1 and F2 in a vec2.
@@ -185,3 +185,350 @@ vec2 cellular(vec3 P) {
 	return sqrt(d11.xy); // F1, F2
 #endif
 }
+
+// Cellular noise, periodic variant, with the period "rep" along each
+// axis, which should be a whole number. The lattice coordinates of the
+// cells are wrapped to the period before they are hashed, so the
+// pattern tiles seamlessly.
+vec2 pcellular(vec3 P, vec3 rep) {
+	vec3 Pi = floor(P);
+	vec3 Pf = fract(P) - 0.5;
+
+	vec3 Pfx = Pf.x + vec3(1.0, 0.0, -1.0);
+	vec3 Pfy = Pf.y + vec3(1.0, 0.0, -1.0);
+	vec3 Pfz = Pf.z + vec3(1.0, 0.0, -1.0);
+
+	// Lattice coordinates of the cells, modulo period
+	vec3 ix = mod289(mod(Pi.x + vec3(-1.0, 0.0, 1.0), rep.x));
+	vec3 iy = mod289(mod(Pi.y + vec3(-1.0, 0.0, 1.0), rep.y));
+	vec3 iz = mod289(mod(Pi.z + vec3(-1.0, 0.0, 1.0), rep.z));
+
+	vec3 p = permute(ix);
+	vec3 p1 = permute(p + iy.x);
+	vec3 p2 = permute(p + iy.y);
+	vec3 p3 = permute(p + iy.z);
+
+	vec3 p11 = permute(p1 + iz.x);
+	vec3 p12 = permute(p1 + iz.y);
+	vec3 p13 = permute(p1 + iz.z);
+
+	vec3 p21 = permute(p2 + iz.x);
+	vec3 p22 = permute(p2 + iz.y);
+	vec3 p23 = permute(p2 + iz.z);
+
+	vec3 p31 = permute(p3 + iz.x);
+	vec3 p32 = permute(p3 + iz.y);
+	vec3 p33 = permute(p3 + iz.z);
+
+	vec3 ox11 = fract(p11*K) - Ko;
+	vec3 oy11 = mod7(floor(p11*K))*K - Ko;
+	vec3 oz11 = floor(p11*K2)*Kz - Kzo; // p11 < 289 guaranteed
+
+	vec3 ox12 = fract(p12*K) - Ko;
+	vec3 oy12 = mod7(floor(p12*K))*K - Ko;
+	vec3 oz12 = floor(p12*K2)*Kz - Kzo;
+
+	vec3 ox13 = fract(p13*K) - Ko;
+	vec3 oy13 = mod7(floor(p13*K))*K - Ko;
+	vec3 oz13 = floor(p13*K2)*Kz - Kzo;
+
+	vec3 ox21 = fract(p21*K) - Ko;
+	vec3 oy21 = mod7(floor(p21*K))*K - Ko;
+	vec3 oz21 = floor(p21*K2)*Kz - Kzo;
+
+	vec3 ox22 = fract(p22*K) - Ko;
+	vec3 oy22 = mod7(floor(p22*K))*K - Ko;
+	vec3 oz22 = floor(p22*K2)*Kz - Kzo;
+
+	vec3 ox23 = fract(p23*K) - Ko;
+	vec3 oy23 = mod7(floor(p23*K))*K - Ko;
+	vec3 oz23 = floor(p23*K2)*Kz - Kzo;
+
+	vec3 ox31 = fract(p31*K) - Ko;
+	vec3 oy31 = mod7(floor(p31*K))*K - Ko;
+	vec3 oz31 = floor(p31*K2)*Kz - Kzo;
+
+	vec3 ox32 = fract(p32*K) - Ko;
+	vec3 oy32 = mod7(floor(p32*K))*K - Ko;
+	vec3 oz32 = floor(p32*K2)*Kz - Kzo;
+
+	vec3 ox33 = fract(p33*K) - Ko;
+	vec3 oy33 = mod7(floor(p33*K))*K - Ko;
+	vec3 oz33 = floor(p33*K2)*Kz - Kzo;
+
+	vec3 dx11 = Pfx + jitter*ox11;
+	vec3 dy11 = Pfy.x + jitter*oy11;
+	vec3 dz11 = Pfz.x + jitter*oz11;
+
+	vec3 dx12 = Pfx + jitter*ox12;
+	vec3 dy12 = Pfy.x + jitter*oy12;
+	vec3 dz12 = Pfz.y + jitter*oz12;
+
+	vec3 dx13 = Pfx + jitter*ox13;
+	vec3 dy13 = Pfy.x + jitter*oy13;
+	vec3 dz13 = Pfz.z + jitter*oz13;
+
+	vec3 dx21 = Pfx + jitter*ox21;
+	vec3 dy21 = Pfy.y + jitter*oy21;
+	vec3 dz21 = Pfz.x + jitter*oz21;
+
+	vec3 dx22 = Pfx + jitter*ox22;
+	vec3 dy22 = Pfy.y + jitter*oy22;
+	vec3 dz22 = Pfz.y + jitter*oz22;
+
+	vec3 dx23 = Pfx + jitter*ox23;
+	vec3 dy23 = Pfy.y + jitter*oy23;
+	vec3 dz23 = Pfz.z + jitter*oz23;
+
+	vec3 dx31 = Pfx + jitter*ox31;
+	vec3 dy31 = Pfy.z + jitter*oy31;
+	vec3 dz31 = Pfz.x + jitter*oz31;
+
+	vec3 dx32 = Pfx + jitter*ox32;
+	vec3 dy32 = Pfy.z + jitter*oy32;
+	vec3 dz32 = Pfz.y + jitter*oz32;
+
+	vec3 dx33 = Pfx + jitter*ox33;
+	vec3 dy33 = Pfy.z + jitter*oy33;
+	vec3 dz33 = Pfz.z + jitter*oz33;
+
+	vec3 d11 = dx11 * dx11 + dy11 * dy11 + dz11 * dz11;
+	vec3 d12 = dx12 * dx12 + dy12 * dy12 + dz12 * dz12;
+	vec3 d13 = dx13 * dx13 + dy13 * dy13 + dz13 * dz13;
+	vec3 d21 = dx21 * dx21 + dy21 * dy21 + dz21 * dz21;
+	vec3 d22 = dx22 * dx22 + dy22 * dy22 + dz22 * dz22;
+	vec3 d23 = dx23 * dx23 + dy23 * dy23 + dz23 * dz23;
+	vec3 d31 = dx31 * dx31 + dy31 * dy31 + dz31 * dz31;
+	vec3 d32 = dx32 * dx32 + dy32 * dy32 + dz32 * dz32;
+	vec3 d33 = dx33 * dx33 + dy33 * dy33 + dz33 * dz33;
+
+	// Sort out the two smallest distances (F1, F2)
+	vec3 d1a = min(d11, d12);
+	d12 = max(d11, d12);
+	d11 = min(d1a, d13); // Smallest now not in d12 or d13
+	d13 = max(d1a, d13);
+	d12 = min(d12, d13); // 2nd smallest now not in d13
+	vec3 d2a = min(d21, d22);
+	d22 = max(d21, d22);
+	d21 = min(d2a, d23); // Smallest now not in d22 or d23
+	d23 = max(d2a, d23);
+	d22 = min(d22, d23); // 2nd smallest now not in d23
+	vec3 d3a = min(d31, d32);
+	d32 = max(d31, d32);
+	d31 = min(d3a, d33); // Smallest now not in d32 or d33
+	d33 = max(d3a, d33);
+	d32 = min(d32, d33); // 2nd smallest now not in d33
+	vec3 da = min(d11, d21);
+	d21 = max(d11, d21);
+	d11 = min(da, d31); // Smallest now in d11
+	d31 = max(da, d31); // 2nd smallest now not in d31
+	d11.xy = (d11.x < d11.y) ? d11.xy : d11.yx;
+	d11.xz = (d11.x < d11.z) ? d11.xz : d11.zx; // d11.x now smallest
+	d12 = min(d12, d21); // 2nd smallest now not in d21
+	d12 = min(d12, d22); // nor in d22
+	d12 = min(d12, d31); // nor in d31
+	d12 = min(d12, d32); // nor in d32
+	d11.yz = min(d11.yz,d12.xy); // nor in d12.yz
+	d11.y = min(d11.y,d12.z); // Only two more to go
+	d11.y = min(d11.y,d11.z); // Done! (Phew!)
+	return sqrt(d11.xy); // F1, F2
+}
+
+// The squared distances from P to the bisectors between the nearest
+// feature point, at a from P, and the feature points at (dx, dy, dz),
+// at squared distances d, times 4. F1 is the squared distance of a.
+// Feature points of different cells are at least 1/7 apart, so a much
+// smaller |b - a| is a itself, which gets 1e30 instead.
+vec3 cellular_bisector(vec3 dx, vec3 dy, vec3 dz, vec3 d, vec3 a, float F1) {
+	dx -= a.x;
+	dy -= a.y;
+	dz -= a.z;
+	vec3 e = dx * dx + dy * dy + dz * dz; // |b - a|^2
+	vec3 self = step(e, vec3(0.01));
+	vec3 n = d - F1;
+	return n * n / (e + self) + 1e30 * self;
+}
+
+// Cellular noise with the Voronoi cell of P, from the same 3x3x3 search
+// and the same distances as cellular(). Returns vec4(F1, F2, border, id),
+// and the vector from P to the nearest feature point in "offset".
+// id is the hash (0 to 288) of the cell that holds the nearest feature
+// point, the same for all of the Voronoi cell. border is the distance
+// from P to the nearest face of its Voronoi cell, perpendicular to the
+// face: the least (d^2 - F1^2) / (2 |b - a|) over the other feature
+// points b, at distances d, a being the nearest.
+vec4 cellular_voronoi(vec3 P, out vec3 offset) {
+	vec3 Pi = mod289(floor(P));
+	vec3 Pf = fract(P) - 0.5;
+
+	vec3 Pfx = Pf.x + vec3(1.0, 0.0, -1.0);
+	vec3 Pfy = Pf.y + vec3(1.0, 0.0, -1.0);
+	vec3 Pfz = Pf.z + vec3(1.0, 0.0, -1.0);
+
+	vec3 p = permute(Pi.x + vec3(-1.0, 0.0, 1.0));
+	vec3 p1 = permute(p + Pi.y - 1.0);
+	vec3 p2 = permute(p + Pi.y);
+	vec3 p3 = permute(p + Pi.y + 1.0);
+
+	vec3 p11 = permute(p1 + Pi.z - 1.0);
+	vec3 p12 = permute(p1 + Pi.z);
+	vec3 p13 = permute(p1 + Pi.z + 1.0);
+
+	vec3 p21 = permute(p2 + Pi.z - 1.0);
+	vec3 p22 = permute(p2 + Pi.z);
+	vec3 p23 = permute(p2 + Pi.z + 1.0);
+
+	vec3 p31 = permute(p3 + Pi.z - 1.0);
+	vec3 p32 = permute(p3 + Pi.z);
+	vec3 p33 = permute(p3 + Pi.z + 1.0);
+
+	vec3 ox11 = fract(p11*K) - Ko;
+	vec3 oy11 = mod7(floor(p11*K))*K - Ko;
+	vec3 oz11 = floor(p11*K2)*Kz - Kzo; // p11 < 289 guaranteed
+
+	vec3 ox12 = fract(p12*K) - Ko;
+	vec3 oy12 = mod7(floor(p12*K))*K - Ko;
+	vec3 oz12 = floor(p12*K2)*Kz - Kzo;
+
+	vec3 ox13 = fract(p13*K) - Ko;
+	vec3 oy13 = mod7(floor(p13*K))*K - Ko;
+	vec3 oz13 = floor(p13*K2)*Kz - Kzo;
+
+	vec3 ox21 = fract(p21*K) - Ko;
+	vec3 oy21 = mod7(floor(p21*K))*K - Ko;
+	vec3 oz21 = floor(p21*K2)*Kz - Kzo;
+
+	vec3 ox22 = fract(p22*K) - Ko;
+	vec3 oy22 = mod7(floor(p22*K))*K - Ko;
+	vec3 oz22 = floor(p22*K2)*Kz - Kzo;
+
+	vec3 ox23 = fract(p23*K) - Ko;
+	vec3 oy23 = mod7(floor(p23*K))*K - Ko;
+	vec3 oz23 = floor(p23*K2)*Kz - Kzo;
+
+	vec3 ox31 = fract(p31*K) - Ko;
+	vec3 oy31 = mod7(floor(p31*K))*K - Ko;
+	vec3 oz31 = floor(p31*K2)*Kz - Kzo;
+
+	vec3 ox32 = fract(p32*K) - Ko;
+	vec3 oy32 = mod7(floor(p32*K))*K - Ko;
+	vec3 oz32 = floor(p32*K2)*Kz - Kzo;
+
+	vec3 ox33 = fract(p33*K) - Ko;
+	vec3 oy33 = mod7(floor(p33*K))*K - Ko;
+	vec3 oz33 = floor(p33*K2)*Kz - Kzo;
+
+	vec3 dx11 = Pfx + jitter*ox11;
+	vec3 dy11 = Pfy.x + jitter*oy11;
+	vec3 dz11 = Pfz.x + jitter*oz11;
+
+	vec3 dx12 = Pfx + jitter*ox12;
+	vec3 dy12 = Pfy.x + jitter*oy12;
+	vec3 dz12 = Pfz.y + jitter*oz12;
+
+	vec3 dx13 = Pfx + jitter*ox13;
+	vec3 dy13 = Pfy.x + jitter*oy13;
+	vec3 dz13 = Pfz.z + jitter*oz13;
+
+	vec3 dx21 = Pfx + jitter*ox21;
+	vec3 dy21 = Pfy.y + jitter*oy21;
+	vec3 dz21 = Pfz.x + jitter*oz21;
+
+	vec3 dx22 = Pfx + jitter*ox22;
+	vec3 dy22 = Pfy.y + jitter*oy22;
+	vec3 dz22 = Pfz.y + jitter*oz22;
+
+	vec3 dx23 = Pfx + jitter*ox23;
+	vec3 dy23 = Pfy.y + jitter*oy23;
+	vec3 dz23 = Pfz.z + jitter*oz23;
+
+	vec3 dx31 = Pfx + jitter*ox31;
+	vec3 dy31 = Pfy.z + jitter*oy31;
+	vec3 dz31 = Pfz.x + jitter*oz31;
+
+	vec3 dx32 = Pfx + jitter*ox32;
+	vec3 dy32 = Pfy.z + jitter*oy32;
+	vec3 dz32 = Pfz.y + jitter*oz32;
+
+	vec3 dx33 = Pfx + jitter*ox33;
+	vec3 dy33 = Pfy.z + jitter*oy33;
+	vec3 dz33 = Pfz.z + jitter*oz33;
+
+	vec3 d11 = dx11 * dx11 + dy11 * dy11 + dz11 * dz11;
+	vec3 d12 = dx12 * dx12 + dy12 * dy12 + dz12 * dz12;
+	vec3 d13 = dx13 * dx13 + dy13 * dy13 + dz13 * dz13;
+	vec3 d21 = dx21 * dx21 + dy21 * dy21 + dz21 * dz21;
+	vec3 d22 = dx22 * dx22 + dy22 * dy22 + dz22 * dz22;
+	vec3 d23 = dx23 * dx23 + dy23 * dy23 + dz23 * dz23;
+	vec3 d31 = dx31 * dx31 + dy31 * dy31 + dz31 * dz31;
+	vec3 d32 = dx32 * dx32 + dy32 * dy32 + dz32 * dz32;
+	vec3 d33 = dx33 * dx33 + dy33 * dy33 + dz33 * dz33;
+
+	// F1 and F2 in each component, the nearest and second nearest of its
+	// 9 cells, by min() and max() as in cellular(). The vector
+	// to the nearest feature point and its hash ride along, picked
+	// with step() and mix() where the nearest changes.
+	vec3 s = step(d11, d12); // 1 where the nearest stays
+	vec3 F1 = min(d11, d12);
+	vec3 F2 = max(d11, d12);
+	vec3 ax = mix(dx12, dx11, s);
+	vec3 ay = mix(dy12, dy11, s);
+	vec3 az = mix(dz12, dz11, s);
+	vec3 aq = mix(p12, p11, s);
+	s = step(F1, d13);
+	F2 = min(F2, max(F1, d13));
+	F1 = min(F1, d13);
+	ax = mix(dx13, ax, s); ay = mix(dy13, ay, s); az = mix(dz13, az, s);
+	aq = mix(p13, aq, s);
+	s = step(F1, d21);
+	F2 = min(F2, max(F1, d21));
+	F1 = min(F1, d21);
+	ax = mix(dx21, ax, s); ay = mix(dy21, ay, s); az = mix(dz21, az, s);
+	aq = mix(p21, aq, s);
+	s = step(F1, d22);
+	F2 = min(F2, max(F1, d22));
+	F1 = min(F1, d22);
+	ax = mix(dx22, ax, s); ay = mix(dy22, ay, s); az = mix(dz22, az, s);
+	aq = mix(p22, aq, s);
+	s = step(F1, d23);
+	F2 = min(F2, max(F1, d23));
+	F1 = min(F1, d23);
+	ax = mix(dx23, ax, s); ay = mix(dy23, ay, s); az = mix(dz23, az, s);
+	aq = mix(p23, aq, s);
+	s = step(F1, d31);
+	F2 = min(F2, max(F1, d31));
+	F1 = min(F1, d31);
+	ax = mix(dx31, ax, s); ay = mix(dy31, ay, s); az = mix(dz31, az, s);
+	aq = mix(p31, aq, s);
+	s = step(F1, d32);
+	F2 = min(F2, max(F1, d32));
+	F1 = min(F1, d32);
+	ax = mix(dx32, ax, s); ay = mix(dy32, ay, s); az = mix(dz32, az, s);
+	aq = mix(p32, aq, s);
+	s = step(F1, d33);
+	F2 = min(F2, max(F1, d33));
+	F1 = min(F1, d33);
+	ax = mix(dx33, ax, s); ay = mix(dy33, ay, s); az = mix(dz33, az, s);
+	aq = mix(p33, aq, s);
+	// The same across the three components
+	vec4 a = vec4(ax.x, ay.x, az.x, aq.x);
+	vec2 F = vec2(F1.x, min(min(F2.x, F2.y), F2.z));
+	float t = step(F.x, F1.y);
+	F = vec2(min(F.x, F1.y), min(F.y, max(F.x, F1.y)));
+	a = mix(vec4(ax.y, ay.y, az.y, aq.y), a, t);
+	t = step(F.x, F1.z);
+	F = vec2(min(F.x, F1.z), min(F.y, max(F.x, F1.z)));
+	a = mix(vec4(ax.z, ay.z, az.z, aq.z), a, t);
+	// The nearest bisector, from the same 27 vectors
+	vec3 b = min(cellular_bisector(dx11, dy11, dz11, d11, a.xyz, F.x),
+	             cellular_bisector(dx12, dy12, dz12, d12, a.xyz, F.x));
+	b = min(b, cellular_bisector(dx13, dy13, dz13, d13, a.xyz, F.x));
+	b = min(b, cellular_bisector(dx21, dy21, dz21, d21, a.xyz, F.x));
+	b = min(b, cellular_bisector(dx22, dy22, dz22, d22, a.xyz, F.x));
+	b = min(b, cellular_bisector(dx23, dy23, dz23, d23, a.xyz, F.x));
+	b = min(b, cellular_bisector(dx31, dy31, dz31, d31, a.xyz, F.x));
+	b = min(b, cellular_bisector(dx32, dy32, dz32, d32, a.xyz, F.x));
+	b = min(b, cellular_bisector(dx33, dy33, dz33, d33, a.xyz, F.x));
+	offset = -a.xyz;
+	return vec4(sqrt(F), 0.5 * sqrt(min(min(b.x, b.y), b.z)), a.w);
+}
@@ -1,6 +1,7 @@
 //
 // GLSL textureless classic 2D noise "cnoise",
-// with an RSL-style periodic variant "pnoise".
+// with an RSL-style periodic variant "pnoise",
+// and variants "cnoise_d" and "pnoise_d" that also return the gradient.
 // Author:  Stefan Gustavson (stefan.gustavson@liu.se)
 // Version: 2024-11-07
 //
@@ -31,6 +32,11 @@ vec2 fade(vec2 t) {
   return t*t*t*(t*(t*6.0-15.0)+10.0);
 }
 
+// Derivative of fade()
+vec2 fade_d(vec2 t) {
+  return t*t*(t*(t*30.0-60.0)+30.0);
+}
+
 // Classic Perlin noise
 float cnoise(vec2 P)
 {
@@ -103,3 +109,65 @@ float pnoise(vec2 P, vec2 rep)
   float n_xy = mix(n_x.x, n_x.y, fade_xy.y);
   return 2.3 * n_xy;
 }
+
+// Classic Perlin noise and its gradient, from the integer corners Pi
+// (already wrapped to the period for pnoise_d) and the fractional parts Pf
+float classic_d(vec4 Pi, vec4 Pf, out vec2 gradient)
+{
+  Pi = mod289(Pi);        // To avoid truncation effects in permutation
+  vec4 ix = Pi.xzxz;
+  vec4 iy = Pi.yyww;
+  vec4 fx = Pf.xzxz;
+  vec4 fy = Pf.yyww;
+
+  vec4 i = permute(permute(ix) + iy);
+
+  vec4 gx = fract(i * (1.0 / 41.0)) * 2.0 - 1.0 ;
+  vec4 gy = abs(gx) - 0.5 ;
+  vec4 tx = floor(gx + 0.5);
+  gx = gx - tx;
+
+  vec2 g00 = vec2(gx.x,gy.x);
+  vec2 g10 = vec2(gx.y,gy.y);
+  vec2 g01 = vec2(gx.z,gy.z);
+  vec2 g11 = vec2(gx.w,gy.w);
+
+  vec4 norm = taylorInvSqrt(vec4(dot(g00, g00), dot(g01, g01), dot(g10, g10), dot(g11, g11)));
+
+  float n00 = norm.x * dot(g00, vec2(fx.x, fy.x));
+  float n10 = norm.y * dot(g10, vec2(fx.y, fy.y));
+  float n01 = norm.z * dot(g01, vec2(fx.z, fy.z));
+  float n11 = norm.w * dot(g11, vec2(fx.w, fy.w));
+
+  vec2 fade_xy = fade(Pf.xy);
+  vec2 n_x = mix(vec2(n00, n01), vec2(n10, n11), fade_xy.x);
+  float n_xy = mix(n_x.x, n_x.y, fade_xy.y);
+
+  // The gradient is the blend of the corner gradients, with the same
+  // weights as the values n00 .. n11, plus the derivative of the fade
+  // curve times the difference across the cell along each axis
+  vec2 fade_x = vec2(1.0 - fade_xy.x, fade_xy.x);
+  vec4 w = fade_x.xyxy * vec4(1.0 - fade_xy.yy, fade_xy.yy) * norm;
+  gradient = vec2(dot(w, gx), dot(w, gy))
+           + fade_d(Pf.xy) * vec2(mix(n10 - n00, n11 - n01, fade_xy.y),
+                                  n_x.y - n_x.x);
+  gradient *= 2.3;
+  return 2.3 * n_xy;
+}
+
+// Classic Perlin noise, with its gradient
+float cnoise_d(vec2 P, out vec2 gradient)
+{
+  vec4 Pi = floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+  return classic_d(Pi, Pf, gradient);
+}
+
+// Classic Perlin noise, periodic variant, with its gradient
+float pnoise_d(vec2 P, vec2 rep, out vec2 gradient)
+{
+  vec4 Pi = floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+  Pi = mod(Pi, rep.xyxy); // To create noise with explicit period
+  return classic_d(Pi, Pf, gradient);
+}
@@ -1,6 +1,7 @@
 //
 // GLSL textureless classic 3D noise "cnoise",
-// with an RSL-style periodic variant "pnoise".
+// with an RSL-style periodic variant "pnoise",
+// and variants "cnoise_d" and "pnoise_d" that also return the gradient.
 // Author:  Stefan Gustavson (stefan.gustavson@liu.se)
 // Version: 2024-11-07
 //
@@ -36,6 +37,11 @@ vec3 fade(vec3 t) {
   return t*t*t*(t*(t*6.0-15.0)+10.0);
 }
 
+// Derivative of fade()
+vec3 fade_d(vec3 t) {
+  return t*t*(t*(t*30.0-60.0)+30.0);
+}
+
 // Classic Perlin noise
 float cnoise(vec3 P)
 {
@@ -159,3 +165,98 @@ float pnoise(vec3 P, vec3 rep)
   float n_xyz = mix(n_yz.x, n_yz.y, fade_xyz.x); 
   return 2.2 * n_xyz;
 }
+
+// Classic Perlin noise and its gradient, from the integer corners Pi0
+// and Pi1 (already wrapped to the period for pnoise_d) and the
+// fractional part Pf0
+float classic_d(vec3 Pi0, vec3 Pi1, vec3 Pf0, out vec3 gradient)
+{
+  Pi0 = mod289(Pi0);
+  Pi1 = mod289(Pi1);
+  vec3 Pf1 = Pf0 - vec3(1.0); // Fractional part - 1.0
+  vec4 ix = vec4(Pi0.x, Pi1.x, Pi0.x, Pi1.x);
+  vec4 iy = vec4(Pi0.yy, Pi1.yy);
+  vec4 iz0 = Pi0.zzzz;
+  vec4 iz1 = Pi1.zzzz;
+
+  vec4 ixy = permute(permute(ix) + iy);
+  vec4 ixy0 = permute(ixy + iz0);
+  vec4 ixy1 = permute(ixy + iz1);
+
+  vec4 gx0 = ixy0 * (1.0 / 7.0);
+  vec4 gy0 = fract(floor(gx0) * (1.0 / 7.0)) - 0.5;
+  gx0 = fract(gx0);
+  vec4 gz0 = vec4(0.5) - abs(gx0) - abs(gy0);
+  vec4 sz0 = step(gz0, vec4(0.0));
+  gx0 -= sz0 * (step(0.0, gx0) - 0.5);
+  gy0 -= sz0 * (step(0.0, gy0) - 0.5);
+
+  vec4 gx1 = ixy1 * (1.0 / 7.0);
+  vec4 gy1 = fract(floor(gx1) * (1.0 / 7.0)) - 0.5;
+  gx1 = fract(gx1);
+  vec4 gz1 = vec4(0.5) - abs(gx1) - abs(gy1);
+  vec4 sz1 = step(gz1, vec4(0.0));
+  gx1 -= sz1 * (step(0.0, gx1) - 0.5);
+  gy1 -= sz1 * (step(0.0, gy1) - 0.5);
+
+  vec3 g000 = vec3(gx0.x,gy0.x,gz0.x);
+  vec3 g100 = vec3(gx0.y,gy0.y,gz0.y);
+  vec3 g010 = vec3(gx0.z,gy0.z,gz0.z);
+  vec3 g110 = vec3(gx0.w,gy0.w,gz0.w);
+  vec3 g001 = vec3(gx1.x,gy1.x,gz1.x);
+  vec3 g101 = vec3(gx1.y,gy1.y,gz1.y);
+  vec3 g011 = vec3(gx1.z,gy1.z,gz1.z);
+  vec3 g111 = vec3(gx1.w,gy1.w,gz1.w);
+
+  vec4 norm0 = taylorInvSqrt(vec4(dot(g000, g000), dot(g010, g010), dot(g100, g100), dot(g110, g110)));
+  vec4 norm1 = taylorInvSqrt(vec4(dot(g001, g001), dot(g011, g011), dot(g101, g101), dot(g111, g111)));
+
+  float n000 = norm0.x * dot(g000, Pf0);
+  float n010 = norm0.y * dot(g010, vec3(Pf0.x, Pf1.y, Pf0.z));
+  float n100 = norm0.z * dot(g100, vec3(Pf1.x, Pf0.yz));
+  float n110 = norm0.w * dot(g110, vec3(Pf1.xy, Pf0.z));
+  float n001 = norm1.x * dot(g001, vec3(Pf0.xy, Pf1.z));
+  float n011 = norm1.y * dot(g011, vec3(Pf0.x, Pf1.yz));
+  float n101 = norm1.z * dot(g101, vec3(Pf1.x, Pf0.y, Pf1.z));
+  float n111 = norm1.w * dot(g111, Pf1);
+
+  vec3 fade_xyz = fade(Pf0);
+  vec4 n_z0 = vec4(n000, n100, n010, n110);
+  vec4 n_z1 = vec4(n001, n101, n011, n111);
+  vec4 n_z = mix(n_z0, n_z1, fade_xyz.z);
+  vec2 n_yz = mix(n_z.xy, n_z.zw, fade_xyz.y);
+  float n_xyz = mix(n_yz.x, n_yz.y, fade_xyz.x);
+
+  // The gradient is the blend of the corner gradients, with the same
+  // weights as the values n000 .. n111, plus the derivative of the fade
+  // curve times the difference across the cell along each axis
+  vec2 fade_x = vec2(1.0 - fade_xyz.x, fade_xyz.x);
+  vec4 w_xy = fade_x.xyxy * vec4(1.0 - fade_xyz.yy, fade_xyz.yy);
+  vec4 w0 = w_xy * (1.0 - fade_xyz.z) * norm0.xzyw;
+  vec4 w1 = w_xy * fade_xyz.z * norm1.xzyw;
+  vec2 dn_y = n_z.zw - n_z.xy;
+  gradient = vec3(dot(w0, gx0) + dot(w1, gx1),
+                  dot(w0, gy0) + dot(w1, gy1),
+                  dot(w0, gz0) + dot(w1, gz1))
+           + fade_d(Pf0) * vec3(n_yz.y - n_yz.x,
+                                mix(dn_y.x, dn_y.y, fade_xyz.x),
+                                dot(w_xy, n_z1 - n_z0));
+  gradient *= 2.2;
+  return 2.2 * n_xyz;
+}
+
+// Classic Perlin noise, with its gradient
+float cnoise_d(vec3 P, out vec3 gradient)
+{
+  vec3 Pi0 = floor(P); // Integer part for indexing
+  vec3 Pi1 = Pi0 + vec3(1.0); // Integer part + 1
+  return classic_d(Pi0, Pi1, fract(P), gradient);
+}
+
+// Classic Perlin noise, periodic variant, with its gradient
+float pnoise_d(vec3 P, vec3 rep, out vec3 gradient)
+{
+  vec3 Pi0 = mod(floor(P), rep); // Integer part, modulo period
+  vec3 Pi1 = mod(Pi0 + vec3(1.0), rep); // Integer part + 1, mod period
+  return classic_d(Pi0, Pi1, fract(P), gradient);
+}
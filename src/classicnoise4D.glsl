@@ -1,6 +1,7 @@
 //
 // GLSL textureless classic 4D noise "cnoise",
-// with an RSL-style periodic variant "pnoise".
+// with an RSL-style periodic variant "pnoise",
+// and variants "cnoise_d" and "pnoise_d" that also return the gradient.
 // Author:  Stefan Gustavson (stefan.gustavson@liu.se)
 // Version: 2011-08-22
 //
@@ -31,6 +32,11 @@ vec4 fade(vec4 t) {
   return t*t*t*(t*(t*6.0-15.0)+10.0);
 }
 
+// Derivative of fade()
+vec4 fade_d(vec4 t) {
+  return t*t*(t*(t*30.0-60.0)+30.0);
+}
+
 // Classic Perlin noise
 float cnoise(vec4 P)
 {
@@ -262,3 +268,160 @@ float pnoise(vec4 P, vec4 rep)
   float n_xyzw = mix(n_yzw.x, n_yzw.y, fade_xyzw.x);
   return 2.2 * n_xyzw;
 }
+
+// Classic Perlin noise and its gradient, from the integer corners Pi0
+// and Pi1 (already wrapped to the period for pnoise_d) and the
+// fractional part Pf0
+float classic_d(vec4 Pi0, vec4 Pi1, vec4 Pf0, out vec4 gradient)
+{
+  Pi0 = mod289(Pi0);
+  Pi1 = mod289(Pi1);
+  vec4 Pf1 = Pf0 - 1.0; // Fractional part - 1.0
+  vec4 ix = vec4(Pi0.x, Pi1.x, Pi0.x, Pi1.x);
+  vec4 iy = vec4(Pi0.yy, Pi1.yy);
+  vec4 iz0 = vec4(Pi0.zzzz);
+  vec4 iz1 = vec4(Pi1.zzzz);
+  vec4 iw0 = vec4(Pi0.wwww);
+  vec4 iw1 = vec4(Pi1.wwww);
+
+  vec4 ixy = permute(permute(ix) + iy);
+  vec4 ixy0 = permute(ixy + iz0);
+  vec4 ixy1 = permute(ixy + iz1);
+  vec4 ixy00 = permute(ixy0 + iw0);
+  vec4 ixy01 = permute(ixy0 + iw1);
+  vec4 ixy10 = permute(ixy1 + iw0);
+  vec4 ixy11 = permute(ixy1 + iw1);
+
+  vec4 gx00 = ixy00 * (1.0 / 7.0);
+  vec4 gy00 = floor(gx00) * (1.0 / 7.0);
+  vec4 gz00 = floor(gy00) * (1.0 / 6.0);
+  gx00 = fract(gx00) - 0.5;
+  gy00 = fract(gy00) - 0.5;
+  gz00 = fract(gz00) - 0.5;
+  vec4 gw00 = vec4(0.75) - abs(gx00) - abs(gy00) - abs(gz00);
+  vec4 sw00 = step(gw00, vec4(0.0));
+  gx00 -= sw00 * (step(0.0, gx00) - 0.5);
+  gy00 -= sw00 * (step(0.0, gy00) - 0.5);
+
+  vec4 gx01 = ixy01 * (1.0 / 7.0);
+  vec4 gy01 = floor(gx01) * (1.0 / 7.0);
+  vec4 gz01 = floor(gy01) * (1.0 / 6.0);
+  gx01 = fract(gx01) - 0.5;
+  gy01 = fract(gy01) - 0.5;
+  gz01 = fract(gz01) - 0.5;
+  vec4 gw01 = vec4(0.75) - abs(gx01) - abs(gy01) - abs(gz01);
+  vec4 sw01 = step(gw01, vec4(0.0));
+  gx01 -= sw01 * (step(0.0, gx01) - 0.5);
+  gy01 -= sw01 * (step(0.0, gy01) - 0.5);
+
+  vec4 gx10 = ixy10 * (1.0 / 7.0);
+  vec4 gy10 = floor(gx10) * (1.0 / 7.0);
+  vec4 gz10 = floor(gy10) * (1.0 / 6.0);
+  gx10 = fract(gx10) - 0.5;
+  gy10 = fract(gy10) - 0.5;
+  gz10 = fract(gz10) - 0.5;
+  vec4 gw10 = vec4(0.75) - abs(gx10) - abs(gy10) - abs(gz10);
+  vec4 sw10 = step(gw10, vec4(0.0));
+  gx10 -= sw10 * (step(0.0, gx10) - 0.5);
+  gy10 -= sw10 * (step(0.0, gy10) - 0.5);
+
+  vec4 gx11 = ixy11 * (1.0 / 7.0);
+  vec4 gy11 = floor(gx11) * (1.0 / 7.0);
+  vec4 gz11 = floor(gy11) * (1.0 / 6.0);
+  gx11 = fract(gx11) - 0.5;
+  gy11 = fract(gy11) - 0.5;
+  gz11 = fract(gz11) - 0.5;
+  vec4 gw11 = vec4(0.75) - abs(gx11) - abs(gy11) - abs(gz11);
+  vec4 sw11 = step(gw11, vec4(0.0));
+  gx11 -= sw11 * (step(0.0, gx11) - 0.5);
+  gy11 -= sw11 * (step(0.0, gy11) - 0.5);
+
+  vec4 g0000 = vec4(gx00.x,gy00.x,gz00.x,gw00.x);
+  vec4 g1000 = vec4(gx00.y,gy00.y,gz00.y,gw00.y);
+  vec4 g0100 = vec4(gx00.z,gy00.z,gz00.z,gw00.z);
+  vec4 g1100 = vec4(gx00.w,gy00.w,gz00.w,gw00.w);
+  vec4 g0010 = vec4(gx10.x,gy10.x,gz10.x,gw10.x);
+  vec4 g1010 = vec4(gx10.y,gy10.y,gz10.y,gw10.y);
+  vec4 g0110 = vec4(gx10.z,gy10.z,gz10.z,gw10.z);
+  vec4 g1110 = vec4(gx10.w,gy10.w,gz10.w,gw10.w);
+  vec4 g0001 = vec4(gx01.x,gy01.x,gz01.x,gw01.x);
+  vec4 g1001 = vec4(gx01.y,gy01.y,gz01.y,gw01.y);
+  vec4 g0101 = vec4(gx01.z,gy01.z,gz01.z,gw01.z);
+  vec4 g1101 = vec4(gx01.w,gy01.w,gz01.w,gw01.w);
+  vec4 g0011 = vec4(gx11.x,gy11.x,gz11.x,gw11.x);
+  vec4 g1011 = vec4(gx11.y,gy11.y,gz11.y,gw11.y);
+  vec4 g0111 = vec4(gx11.z,gy11.z,gz11.z,gw11.z);
+  vec4 g1111 = vec4(gx11.w,gy11.w,gz11.w,gw11.w);
+
+  vec4 norm00 = taylorInvSqrt(vec4(dot(g0000, g0000), dot(g0100, g0100), dot(g1000, g1000), dot(g1100, g1100)));
+  vec4 norm01 = taylorInvSqrt(vec4(dot(g0001, g0001), dot(g0101, g0101), dot(g1001, g1001), dot(g1101, g1101)));
+  vec4 norm10 = taylorInvSqrt(vec4(dot(g0010, g0010), dot(g0110, g0110), dot(g1010, g1010), dot(g1110, g1110)));
+  vec4 norm11 = taylorInvSqrt(vec4(dot(g0011, g0011), dot(g0111, g0111), dot(g1011, g1011), dot(g1111, g1111)));
+
+  float n0000 = norm00.x * dot(g0000, Pf0);
+  float n0100 = norm00.y * dot(g0100, vec4(Pf0.x, Pf1.y, Pf0.zw));
+  float n1000 = norm00.z * dot(g1000, vec4(Pf1.x, Pf0.yzw));
+  float n1100 = norm00.w * dot(g1100, vec4(Pf1.xy, Pf0.zw));
+  float n0010 = norm10.x * dot(g0010, vec4(Pf0.xy, Pf1.z, Pf0.w));
+  float n0110 = norm10.y * dot(g0110, vec4(Pf0.x, Pf1.yz, Pf0.w));
+  float n1010 = norm10.z * dot(g1010, vec4(Pf1.x, Pf0.y, Pf1.z, Pf0.w));
+  float n1110 = norm10.w * dot(g1110, vec4(Pf1.xyz, Pf0.w));
+  float n0001 = norm01.x * dot(g0001, vec4(Pf0.xyz, Pf1.w));
+  float n0101 = norm01.y * dot(g0101, vec4(Pf0.x, Pf1.y, Pf0.z, Pf1.w));
+  float n1001 = norm01.z * dot(g1001, vec4(Pf1.x, Pf0.yz, Pf1.w));
+  float n1101 = norm01.w * dot(g1101, vec4(Pf1.xy, Pf0.z, Pf1.w));
+  float n0011 = norm11.x * dot(g0011, vec4(Pf0.xy, Pf1.zw));
+  float n0111 = norm11.y * dot(g0111, vec4(Pf0.x, Pf1.yzw));
+  float n1011 = norm11.z * dot(g1011, vec4(Pf1.x, Pf0.y, Pf1.zw));
+  float n1111 = norm11.w * dot(g1111, Pf1);
+
+  vec4 fade_xyzw = fade(Pf0);
+  vec4 n_00 = vec4(n0000, n1000, n0100, n1100);
+  vec4 n_01 = vec4(n0001, n1001, n0101, n1101);
+  vec4 n_10 = vec4(n0010, n1010, n0110, n1110);
+  vec4 n_11 = vec4(n0011, n1011, n0111, n1111);
+  vec4 n_0w = mix(n_00, n_01, fade_xyzw.w);
+  vec4 n_1w = mix(n_10, n_11, fade_xyzw.w);
+  vec4 n_zw = mix(n_0w, n_1w, fade_xyzw.z);
+  vec2 n_yzw = mix(n_zw.xy, n_zw.zw, fade_xyzw.y);
+  float n_xyzw = mix(n_yzw.x, n_yzw.y, fade_xyzw.x);
+
+  // The gradient is the blend of the corner gradients, with the same
+  // weights as the values n0000 .. n1111, plus the derivative of the
+  // fade curve times the difference across the cell along each axis
+  vec2 fade_x = vec2(1.0 - fade_xyzw.x, fade_xyzw.x);
+  vec4 w_xy = fade_x.xyxy * vec4(1.0 - fade_xyzw.yy, fade_xyzw.yy);
+  vec2 fade_z = vec2(1.0 - fade_xyzw.z, fade_xyzw.z);
+  vec2 fade_w = vec2(1.0 - fade_xyzw.w, fade_xyzw.w);
+  vec4 w00 = w_xy * (fade_z.x * fade_w.x) * norm00.xzyw;
+  vec4 w01 = w_xy * (fade_z.x * fade_w.y) * norm01.xzyw;
+  vec4 w10 = w_xy * (fade_z.y * fade_w.x) * norm10.xzyw;
+  vec4 w11 = w_xy * (fade_z.y * fade_w.y) * norm11.xzyw;
+  vec2 dn_y = n_zw.zw - n_zw.xy;
+  gradient = vec4(dot(w00, gx00) + dot(w01, gx01) + dot(w10, gx10) + dot(w11, gx11),
+                  dot(w00, gy00) + dot(w01, gy01) + dot(w10, gy10) + dot(w11, gy11),
+                  dot(w00, gz00) + dot(w01, gz01) + dot(w10, gz10) + dot(w11, gz11),
+                  dot(w00, gw00) + dot(w01, gw01) + dot(w10, gw10) + dot(w11, gw11))
+           + fade_d(Pf0) * vec4(n_yzw.y - n_yzw.x,
+                                mix(dn_y.x, dn_y.y, fade_xyzw.x),
+                                dot(w_xy, n_1w - n_0w),
+                                dot(w_xy, mix(n_01 - n_00, n_11 - n_10, fade_xyzw.z)));
+  gradient *= 2.2;
+  return 2.2 * n_xyzw;
+}
+
+// Classic Perlin noise, with its gradient
+float cnoise_d(vec4 P, out vec4 gradient)
+{
+  vec4 Pi0 = floor(P); // Integer part for indexing
+  vec4 Pi1 = Pi0 + 1.0; // Integer part + 1
+  return classic_d(Pi0, Pi1, fract(P), gradient);
+}
+
+// Classic Perlin noise, periodic version, with its gradient
+float pnoise_d(vec4 P, vec4 rep, out vec4 gradient)
+{
+  vec4 Pi0 = mod(floor(P), rep); // Integer part modulo rep
+  vec4 Pi1 = mod(Pi0 + 1.0, rep); // Integer part + 1 mod rep
+  return classic_d(Pi0, Pi1, fract(P), gradient);
+}
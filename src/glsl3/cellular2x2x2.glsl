@@ -0,0 +1,95 @@
+// Cellular noise ("Worley noise") in 3D in GLSL, with an integer hash.
+// Copyright (c) Stefan Gustavson 2011-04-19. All rights reserved.
+// This code is released under the conditions of the MIT license.
+// See LICENSE file for details.
+// https://github.com/stegu/webgl-noise
+
+// GLSL 1.30 and up, and GLSL ES 3.00: cellular2x2x2() of
+// ../cellular2x2x2.glsl, with an integer hash of the lattice coordinates
+// in place of the permutation polynomial. The hash has no period of 289,
+// and it picks each of the 7x7x6 feature point positions equally often.
+
+// 32-bit integer hash of the lattice points (x, y, z), one point per
+// component, from their whole-number coordinates: the coordinates times
+// odd constants are combined, and mixed by the finaliser of a
+// multiplicative hash. highp, as mediump integers in GLSL ES may have
+// only 16 bits.
+highp uvec4 ihash(vec4 x, vec4 y, vec4 z)
+{
+  highp uvec4 h = (uvec4(ivec4(x)) * 0x8da6b343u) ^ (uvec4(ivec4(y)) * 0xd8163841u)
+                ^ (uvec4(ivec4(z)) * 0xcb1ab31fu);
+  h ^= h >> 16u;
+  h *= 0x7feb352du;
+  h ^= h >> 15u;
+  h *= 0x846ca68bu;
+  h ^= h >> 16u;
+  return h;
+}
+
+// The top 16 bits of the hash h, scaled to a whole number 0 .. n-1
+vec4 hashindex(highp uvec4 h, uint n)
+{
+  return vec4(((h >> 16u) * n) >> 16u);
+}
+
+// Modulo 7 without a division
+vec4 mod7(vec4 x) {
+  return x - floor(x * (1.0 / 7.0)) * 7.0;
+}
+
+// Cellular noise, returning F1 and F2 in a vec2.
+// Speeded up by using 2x2x2 search window instead of 3x3x3,
+// at the expense of some pattern artifacts.
+// F2 is often wrong and has sharp discontinuities.
+// If you need a good F2, use the slower 3x3x3 version.
+vec2 cellular2x2x2(vec3 P) {
+#define K 0.142857142857 // 1/7
+#define Ko 0.428571428571 // 1/2-K/2
+#define K2 0.020408163265306 // 1/(7*7)
+#define Kz 0.166666666667 // 1/6
+#define Kzo 0.416666666667 // 1/2-1/6*2
+#define jitter 0.8 // smaller jitter gives less errors in F2
+	vec3 Pi = floor(P);
+ 	vec3 Pf = fract(P);
+	vec4 Pfx = Pf.x + vec4(0.0, -1.0, 0.0, -1.0);
+	vec4 Pfy = Pf.y + vec4(0.0, 0.0, -1.0, -1.0);
+	vec4 ix = Pi.x + vec4(0.0, 1.0, 0.0, 1.0);
+	vec4 iy = Pi.y + vec4(0.0, 0.0, 1.0, 1.0);
+	vec4 p1 = hashindex(ihash(ix, iy, vec4(Pi.z)), 294u); // z+0
+	vec4 p2 = hashindex(ihash(ix, iy, vec4(Pi.z + 1.0)), 294u); // z+1
+	vec4 ox1 = fract(p1*K) - Ko;
+	vec4 oy1 = mod7(floor(p1*K))*K - Ko;
+	vec4 oz1 = floor(p1*K2)*Kz - Kzo; // p1 < 294 guaranteed
+	vec4 ox2 = fract(p2*K) - Ko;
+	vec4 oy2 = mod7(floor(p2*K))*K - Ko;
+	vec4 oz2 = floor(p2*K2)*Kz - Kzo;
+	vec4 dx1 = Pfx + jitter*ox1;
+	vec4 dy1 = Pfy + jitter*oy1;
+	vec4 dz1 = Pf.z + jitter*oz1;
+	vec4 dx2 = Pfx + jitter*ox2;
+	vec4 dy2 = Pfy + jitter*oy2;
+	vec4 dz2 = Pf.z - 1.0 + jitter*oz2;
+	vec4 d1 = dx1 * dx1 + dy1 * dy1 + dz1 * dz1; // z+0
+	vec4 d2 = dx2 * dx2 + dy2 * dy2 + dz2 * dz2; // z+1
+
+	// Sort out the two smallest distances (F1, F2)
+#if 0
+	// Cheat and sort out only F1
+	d1 = min(d1, d2);
+	d1.xy = min(d1.xy, d1.wz);
+	d1.x = min(d1.x, d1.y);
+	return vec2(sqrt(d1.x));
+#else
+	// Do it right and sort out both F1 and F2
+	vec4 d = min(d1,d2); // F1 is now in d
+	d2 = max(d1,d2); // Make sure we keep all candidates for F2
+	d.xy = (d.x < d.y) ? d.xy : d.yx; // Swap smallest to d.x
+	d.xz = (d.x < d.z) ? d.xz : d.zx;
+	d.xw = (d.x < d.w) ? d.xw : d.wx; // F1 is now in d.x
+	d.yzw = min(d.yzw, d2.yzw); // F2 now not in d2.yzw
+	d.y = min(d.y, d.z); // nor in d.z
+	d.y = min(d.y, d.w); // nor in d.w
+	d.y = min(d.y, d2.x); // F2 is now in d.y
+	return sqrt(d.xy); // F1 and F2
+#endif
+}
@@ -0,0 +1,187 @@
+//
+// GLSL textureless classic 2D noise "cnoise",
+// with an RSL-style periodic variant "pnoise",
+// and variants "cnoise_d" and "pnoise_d" that also return the gradient.
+// Author:  Stefan Gustavson (stefan.gustavson@liu.se)
+// Version: 2024-11-07
+//
+// Many thanks to Ian McEwan of Ashima Arts for the
+// ideas for permutation and gradient selection.
+//
+// Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+// Distributed under the MIT license. See LICENSE file.
+// https://github.com/stegu/webgl-noise
+//
+// GLSL 1.30 and up, and GLSL ES 3.00: the same functions as in
+// ../classicnoise2D.glsl, with an integer hash of the lattice coordinates
+// in place of the permutation polynomial. The hash has no period of 289,
+// and it picks each of the 41 gradients equally often.
+//
+
+// 32-bit integer hash of the lattice points (x, y), one point per
+// component, from their whole-number coordinates: the coordinates times
+// odd constants are combined, and mixed by the finaliser of a
+// multiplicative hash. highp, as mediump integers in GLSL ES may have
+// only 16 bits.
+highp uvec4 ihash(vec4 x, vec4 y)
+{
+  highp uvec4 h = (uvec4(ivec4(x)) * 0x8da6b343u) ^ (uvec4(ivec4(y)) * 0xd8163841u);
+  h ^= h >> 16u;
+  h *= 0x7feb352du;
+  h ^= h >> 15u;
+  h *= 0x846ca68bu;
+  h ^= h >> 16u;
+  return h;
+}
+
+// The top 16 bits of the hash h, scaled to a whole number 0 .. n-1
+vec4 hashindex(highp uvec4 h, uint n)
+{
+  return vec4(((h >> 16u) * n) >> 16u);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+vec2 fade(vec2 t) {
+  return t*t*t*(t*(t*6.0-15.0)+10.0);
+}
+
+// Derivative of fade()
+vec2 fade_d(vec2 t) {
+  return t*t*(t*(t*30.0-60.0)+30.0);
+}
+
+// Classic Perlin noise
+float cnoise(vec2 P)
+{
+  vec4 Pi = floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 ix = Pi.xzxz;
+  vec4 iy = Pi.yyww;
+  vec4 fx = Pf.xzxz;
+  vec4 fy = Pf.yyww;
+
+  vec4 i = hashindex(ihash(ix, iy), 41u);
+
+  vec4 gx = fract(i * (1.0 / 41.0)) * 2.0 - 1.0 ;
+  vec4 gy = abs(gx) - 0.5 ;
+  vec4 tx = floor(gx + 0.5);
+  gx = gx - tx;
+
+  vec2 g00 = vec2(gx.x,gy.x);
+  vec2 g10 = vec2(gx.y,gy.y);
+  vec2 g01 = vec2(gx.z,gy.z);
+  vec2 g11 = vec2(gx.w,gy.w);
+
+  vec4 norm = taylorInvSqrt(vec4(dot(g00, g00), dot(g01, g01), dot(g10, g10), dot(g11, g11)));
+
+  float n00 = norm.x * dot(g00, vec2(fx.x, fy.x));
+  float n10 = norm.y * dot(g10, vec2(fx.y, fy.y));
+  float n01 = norm.z * dot(g01, vec2(fx.z, fy.z));
+  float n11 = norm.w * dot(g11, vec2(fx.w, fy.w));
+
+  vec2 fade_xy = fade(Pf.xy);
+  vec2 n_x = mix(vec2(n00, n01), vec2(n10, n11), fade_xy.x);
+  float n_xy = mix(n_x.x, n_x.y, fade_xy.y);
+  return 2.3 * n_xy;
+}
+
+// Classic Perlin noise, periodic variant
+float pnoise(vec2 P, vec2 rep)
+{
+  vec4 Pi = floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+  Pi = mod(Pi, rep.xyxy); // To create noise with explicit period
+  vec4 ix = Pi.xzxz;
+  vec4 iy = Pi.yyww;
+  vec4 fx = Pf.xzxz;
+  vec4 fy = Pf.yyww;
+
+  vec4 i = hashindex(ihash(ix, iy), 41u);
+
+  vec4 gx = fract(i * (1.0 / 41.0)) * 2.0 - 1.0 ;
+  vec4 gy = abs(gx) - 0.5 ;
+  vec4 tx = floor(gx + 0.5);
+  gx = gx - tx;
+
+  vec2 g00 = vec2(gx.x,gy.x);
+  vec2 g10 = vec2(gx.y,gy.y);
+  vec2 g01 = vec2(gx.z,gy.z);
+  vec2 g11 = vec2(gx.w,gy.w);
+
+  vec4 norm = taylorInvSqrt(vec4(dot(g00, g00), dot(g01, g01), dot(g10, g10), dot(g11, g11)));
+
+  float n00 = norm.x * dot(g00, vec2(fx.x, fy.x));
+  float n10 = norm.y * dot(g10, vec2(fx.y, fy.y));
+  float n01 = norm.z * dot(g01, vec2(fx.z, fy.z));
+  float n11 = norm.w * dot(g11, vec2(fx.w, fy.w));
+
+  vec2 fade_xy = fade(Pf.xy);
+  vec2 n_x = mix(vec2(n00, n01), vec2(n10, n11), fade_xy.x);
+  float n_xy = mix(n_x.x, n_x.y, fade_xy.y);
+  return 2.3 * n_xy;
+}
+
+// Classic Perlin noise and its gradient, from the integer corners Pi
+// (already wrapped to the period for pnoise_d) and the fractional parts Pf
+float classic_d(vec4 Pi, vec4 Pf, out vec2 gradient)
+{
+  vec4 ix = Pi.xzxz;
+  vec4 iy = Pi.yyww;
+  vec4 fx = Pf.xzxz;
+  vec4 fy = Pf.yyww;
+
+  vec4 i = hashindex(ihash(ix, iy), 41u);
+
+  vec4 gx = fract(i * (1.0 / 41.0)) * 2.0 - 1.0 ;
+  vec4 gy = abs(gx) - 0.5 ;
+  vec4 tx = floor(gx + 0.5);
+  gx = gx - tx;
+
+  vec2 g00 = vec2(gx.x,gy.x);
+  vec2 g10 = vec2(gx.y,gy.y);
+  vec2 g01 = vec2(gx.z,gy.z);
+  vec2 g11 = vec2(gx.w,gy.w);
+
+  vec4 norm = taylorInvSqrt(vec4(dot(g00, g00), dot(g01, g01), dot(g10, g10), dot(g11, g11)));
+
+  float n00 = norm.x * dot(g00, vec2(fx.x, fy.x));
+  float n10 = norm.y * dot(g10, vec2(fx.y, fy.y));
+  float n01 = norm.z * dot(g01, vec2(fx.z, fy.z));
+  float n11 = norm.w * dot(g11, vec2(fx.w, fy.w));
+
+  vec2 fade_xy = fade(Pf.xy);
+  vec2 n_x = mix(vec2(n00, n01), vec2(n10, n11), fade_xy.x);
+  float n_xy = mix(n_x.x, n_x.y, fade_xy.y);
+
+  // The gradient is the blend of the corner gradients, with the same
+  // weights as the values n00 .. n11, plus the derivative of the fade
+  // curve times the difference across the cell along each axis
+  vec2 fade_x = vec2(1.0 - fade_xy.x, fade_xy.x);
+  vec4 w = fade_x.xyxy * vec4(1.0 - fade_xy.yy, fade_xy.yy) * norm;
+  gradient = vec2(dot(w, gx), dot(w, gy))
+           + fade_d(Pf.xy) * vec2(mix(n10 - n00, n11 - n01, fade_xy.y),
+                                  n_x.y - n_x.x);
+  gradient *= 2.3;
+  return 2.3 * n_xy;
+}
+
+// Classic Perlin noise, with its gradient
+float cnoise_d(vec2 P, out vec2 gradient)
+{
+  vec4 Pi = floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+  return classic_d(Pi, Pf, gradient);
+}
+
+// Classic Perlin noise, periodic variant, with its gradient
+float pnoise_d(vec2 P, vec2 rep, out vec2 gradient)
+{
+  vec4 Pi = floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+  Pi = mod(Pi, rep.xyxy); // To create noise with explicit period
+  return classic_d(Pi, Pf, gradient);
+}
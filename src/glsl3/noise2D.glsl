@@ -0,0 +1,154 @@
+//
+// Description : Array and textureless GLSL 2D simplex noise function,
+//               with an integer lattice hash.
+//      Author : Ian McEwan, Ashima Arts.
+//  Maintainer : stegu
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// GLSL 1.30 and up, and GLSL ES 3.00: the same functions as in
+// ../noise2D.glsl, with an integer hash of the lattice coordinates in
+// place of the permutation polynomial. The hash has no period of 289,
+// and it picks each of the 41 gradients equally often.
+//
+// float snoise(vec2 v)
+// "v" is the input (x,y) coordinate
+//
+// vec4 snoise4x(vec4 xs, vec4 ys)
+// The same noise at the four points (xs.x, ys.x) .. (xs.w, ys.w)
+//
+
+// 32-bit integer hash of the lattice points (x, y), one point per
+// component, from their whole-number coordinates: the coordinates times
+// odd constants are combined, and mixed by the finaliser of a
+// multiplicative hash. highp, as mediump integers in GLSL ES may have
+// only 16 bits.
+highp uvec3 ihash(vec3 x, vec3 y)
+{
+  highp uvec3 h = (uvec3(ivec3(x)) * 0x8da6b343u) ^ (uvec3(ivec3(y)) * 0xd8163841u);
+  h ^= h >> 16u;
+  h *= 0x7feb352du;
+  h ^= h >> 15u;
+  h *= 0x846ca68bu;
+  h ^= h >> 16u;
+  return h;
+}
+
+highp uvec4 ihash(vec4 x, vec4 y)
+{
+  highp uvec4 h = (uvec4(ivec4(x)) * 0x8da6b343u) ^ (uvec4(ivec4(y)) * 0xd8163841u);
+  h ^= h >> 16u;
+  h *= 0x7feb352du;
+  h ^= h >> 15u;
+  h *= 0x846ca68bu;
+  h ^= h >> 16u;
+  return h;
+}
+
+// The top 16 bits of the hash h, scaled to a whole number 0 .. n-1
+vec3 hashindex(highp uvec3 h, uint n)
+{
+  return vec3(((h >> 16u) * n) >> 16u);
+}
+
+vec4 hashindex(highp uvec4 h, uint n)
+{
+  return vec4(((h >> 16u) * n) >> 16u);
+}
+
+float snoise(vec2 v)
+  {
+  const vec4 C = vec4(0.211324865405187,  // (3.0-sqrt(3.0))/6.0
+                      0.366025403784439,  // 0.5*(sqrt(3.0)-1.0)
+                     -0.577350269189626,  // -1.0 + 2.0 * C.x
+                      0.024390243902439); // 1.0 / 41.0
+// First corner
+  vec2 i  = floor(v + dot(v, C.yy) );
+  vec2 x0 = v -   i + dot(i, C.xx);
+
+// Other corners
+  vec2 i1;
+  i1 = (x0.x > x0.y) ? vec2(1.0, 0.0) : vec2(0.0, 1.0);
+  // x0 = x0 - 0.0 + 0.0 * C.xx ;
+  // x1 = x0 - i1 + 1.0 * C.xx ;
+  // x2 = x0 - 1.0 + 2.0 * C.xx ;
+  vec4 x12 = x0.xyxy + C.xxzz;
+  x12.xy -= i1;
+
+// Hashes of the three corners, one of the 41 gradients each
+  vec3 p = hashindex(ihash(i.x + vec3(0.0, i1.x, 1.0),
+                           i.y + vec3(0.0, i1.y, 1.0)), 41u);
+
+  vec3 m = max(0.5 - vec3(dot(x0,x0), dot(x12.xy,x12.xy), dot(x12.zw,x12.zw)), 0.0);
+  m = m*m ;
+  m = m*m ;
+
+// Gradients: 41 points uniformly over a line, mapped onto a diamond.
+  vec3 x = 2.0 * fract(p * C.www) - 1.0;
+  vec3 h = abs(x) - 0.5;
+  vec3 ox = floor(x + 0.5);
+  vec3 a0 = x - ox;
+
+// Normalise gradients implicitly by scaling m
+// Approximation of: m *= inversesqrt( a0*a0 + h*h );
+  m *= 1.79284291400159 - 0.85373472095314 * ( a0*a0 + h*h );
+
+// Compute final noise value at P
+  vec3 g;
+  g.x  = a0.x  * x0.x  + h.x  * x0.y;
+  g.yz = a0.yz * x12.xz + h.yz * x12.yw;
+  return 130.0 * dot(m, g);
+}
+
+// Contribution of one simplex corner to the noise at four points, from
+// the gradient indices p of the corner and the vectors (x, y) from it to
+// the points
+vec4 scorner4x(vec4 p, vec4 x, vec4 y)
+{
+  vec4 m = max(0.5 - (x*x + y*y), 0.0);
+  m = m*m ;
+  m = m*m ;
+
+// Gradients: 41 points uniformly over a line, mapped onto a diamond
+  vec4 gx = 2.0 * fract(p * 0.024390243902439) - 1.0;
+  vec4 h = abs(gx) - 0.5;
+  vec4 a0 = gx - floor(gx + 0.5);
+
+// Normalise gradients implicitly by scaling m
+  m *= 1.79284291400159 - 0.85373472095314 * ( a0*a0 + h*h );
+  return m * (a0*x + h*y);
+}
+
+vec4 snoise4x(vec4 xs, vec4 ys)
+  {
+  const vec4 C = vec4(0.211324865405187,  // (3.0-sqrt(3.0))/6.0
+                      0.366025403784439,  // 0.5*(sqrt(3.0)-1.0)
+                     -0.577350269189626,  // -1.0 + 2.0 * C.x
+                      0.024390243902439); // 1.0 / 41.0
+// First corners
+  vec4 s = xs * C.y + ys * C.y;
+  vec4 ix = floor(xs + s);
+  vec4 iy = floor(ys + s);
+  vec4 t = ix * C.x + iy * C.x;
+  vec4 x0 = xs - ix + t;
+  vec4 y0 = ys - iy + t;
+
+// Other corners
+  vec4 i1x = vec4(greaterThan(x0, y0)); // x0 > y0 ? 1.0 : 0.0
+  vec4 i1y = 1.0 - i1x;
+  vec4 x1 = x0 + C.x - i1x;
+  vec4 y1 = y0 + C.x - i1y;
+  vec4 x2 = x0 + C.z;
+  vec4 y2 = y0 + C.z;
+
+// Hashes of the corners, one of the 41 gradients each
+  vec4 p0 = hashindex(ihash(ix, iy), 41u);
+  vec4 p1 = hashindex(ihash(ix + i1x, iy + i1y), 41u);
+  vec4 p2 = hashindex(ihash(ix + 1.0, iy + 1.0), 41u);
+
+// Compute final noise values at the four points
+  return 130.0 * (scorner4x(p0, x0, y0) + scorner4x(p1, x1, y1)
+                  + scorner4x(p2, x2, y2));
+}
@@ -0,0 +1,97 @@
+//
+// GLSL textureless classic 2D noise "cnoise",
+// with a lattice hash that is exact with mediump floats.
+// Author:  Stefan Gustavson (stefan.gustavson@liu.se)
+//
+// Many thanks to Ian McEwan of Ashima Arts for the
+// ideas for permutation and gradient selection.
+//
+// Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+// Distributed under the MIT license. See LICENSE file.
+// https://github.com/stegu/webgl-noise
+//
+// The same noise as cnoise() of ../classicnoise2D.glsl, for shaders that
+// run with mediump floats: no whole number in the hash exceeds 650 (2048
+// for mod289() of the lattice coordinates), so half floats pick the same
+// gradients as highp floats. See README.
+//
+
+// x mod 289 for whole numbers -2048 <= x <= 2048. The quotient may come
+// out one too small or too large, which the steps correct.
+vec4 mod289(vec4 x)
+{
+  x -= floor(x * (1.0 / 289.0)) * 289.0;
+  x += 289.0 * (1.0 - step(0.0, x));
+  return x - 289.0 * step(289.0, x);
+}
+
+// x mod 17 and x mod 41 for whole numbers -80 <= x < 360. The offset of
+// 0.5 keeps the quotient clear of whole numbers by more than its
+// rounding error.
+vec4 mod17(vec4 x)
+{
+  return x - floor((x + 0.5) * (1.0 / 17.0)) * 17.0;
+}
+
+vec4 mod41(vec4 x)
+{
+  return x - floor((x + 0.5) * (1.0 / 41.0)) * 41.0;
+}
+
+// (34x^2 + 10x) mod 289, as permute() of ../classicnoise2D.glsl, for whole
+// numbers -80 <= x < 642, up to a multiple of 289: the result is between
+// -80 and 352, which the next permute() takes as it is, and mod289()
+// reduces once the hash is complete. With x = 17a + b, -8 <= b <= 8,
+// (34x^2 + 10x) mod 289 = (10b + 17 ((2b^2 + 10a) mod 17)) mod 289.
+vec4 permute(vec4 x)
+{
+  x -= 289.0 * step(289.0, x);
+  vec4 a = floor((x + 8.5) * (1.0 / 17.0));
+  vec4 b = x - 17.0 * a;
+  return 10.0 * b + 17.0 * mod17(2.0 * b * b + 10.0 * a);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+vec2 fade(vec2 t) {
+  return t*t*t*(t*(t*6.0-15.0)+10.0);
+}
+
+// Classic Perlin noise
+float cnoise(vec2 P)
+{
+  vec4 Pi = floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0);
+  vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+  Pi = mod289(Pi); // To avoid truncation effects in permutation
+  vec4 ix = Pi.xzxz;
+  vec4 iy = Pi.yyww;
+  vec4 fx = Pf.xzxz;
+  vec4 fy = Pf.yyww;
+
+  vec4 i = mod289(permute(permute(ix) + iy));
+
+  vec4 gx = mod41(i) * (2.0 / 41.0) - 1.0 ; // fract(i / 41.0) * 2.0 - 1.0
+  vec4 gy = abs(gx) - 0.5 ;
+  vec4 tx = floor(gx + 0.5);
+  gx = gx - tx;
+
+  vec2 g00 = vec2(gx.x,gy.x);
+  vec2 g10 = vec2(gx.y,gy.y);
+  vec2 g01 = vec2(gx.z,gy.z);
+  vec2 g11 = vec2(gx.w,gy.w);
+
+  vec4 norm = taylorInvSqrt(vec4(dot(g00, g00), dot(g01, g01), dot(g10, g10), dot(g11, g11)));
+
+  float n00 = norm.x * dot(g00, vec2(fx.x, fy.x));
+  float n10 = norm.y * dot(g10, vec2(fx.y, fy.y));
+  float n01 = norm.z * dot(g01, vec2(fx.z, fy.z));
+  float n11 = norm.w * dot(g11, vec2(fx.w, fy.w));
+
+  vec2 fade_xy = fade(Pf.xy);
+  vec2 n_x = mix(vec2(n00, n01), vec2(n10, n11), fade_xy.x);
+  float n_xy = mix(n_x.x, n_x.y, fade_xy.y);
+  return 2.3 * n_xy;
+}
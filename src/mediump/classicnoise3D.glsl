@@ -0,0 +1,139 @@
+//
+// GLSL textureless classic 3D noise "cnoise",
+// with a lattice hash that is exact with mediump floats.
+// Author:  Stefan Gustavson (stefan.gustavson@liu.se)
+//
+// Many thanks to Ian McEwan of Ashima Arts for the
+// ideas for permutation and gradient selection.
+//
+// Copyright (c) 2011 Stefan Gustavson. All rights reserved.
+// Distributed under the MIT license. See LICENSE file.
+// https://github.com/stegu/webgl-noise
+//
+// The same noise as cnoise() of ../classicnoise3D.glsl, for shaders that
+// run with mediump floats: no whole number in the hash exceeds 650 (2048
+// for mod289() of the lattice coordinates), so half floats pick the same
+// gradients as highp floats. See README.
+//
+
+// x mod 289 for whole numbers -2048 <= x <= 2048. The quotient may come
+// out one too small or too large, which the steps correct.
+vec3 mod289(vec3 x)
+{
+  x -= floor(x * (1.0 / 289.0)) * 289.0;
+  x += 289.0 * (1.0 - step(0.0, x));
+  return x - 289.0 * step(289.0, x);
+}
+
+vec4 mod289(vec4 x)
+{
+  x -= floor(x * (1.0 / 289.0)) * 289.0;
+  x += 289.0 * (1.0 - step(0.0, x));
+  return x - 289.0 * step(289.0, x);
+}
+
+// x mod 17 and x mod 7 for whole numbers -80 <= x < 360. The offset of
+// 0.5 keeps the quotient clear of whole numbers by more than its
+// rounding error.
+vec4 mod17(vec4 x)
+{
+  return x - floor((x + 0.5) * (1.0 / 17.0)) * 17.0;
+}
+
+vec4 mod7(vec4 x)
+{
+  return x - floor((x + 0.5) * (1.0 / 7.0)) * 7.0;
+}
+
+// (34x^2 + 10x) mod 289, as permute() of ../classicnoise3D.glsl, for whole
+// numbers -80 <= x < 642, up to a multiple of 289: the result is between
+// -80 and 352, which the next permute() takes as it is, and mod289()
+// reduces once the hash is complete. With x = 17a + b, -8 <= b <= 8,
+// (34x^2 + 10x) mod 289 = (10b + 17 ((2b^2 + 10a) mod 17)) mod 289.
+vec4 permute(vec4 x)
+{
+  x -= 289.0 * step(289.0, x);
+  vec4 a = floor((x + 8.5) * (1.0 / 17.0));
+  vec4 b = x - 17.0 * a;
+  return 10.0 * b + 17.0 * mod17(2.0 * b * b + 10.0 * a);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+vec3 fade(vec3 t) {
+  return t*t*t*(t*(t*6.0-15.0)+10.0);
+}
+
+// Gradients for the hashes i of four corners, as in cnoise() of
+// ../classicnoise3D.glsl: x = fract(i / 7) and y = fract(floor(i / 7) / 7)
+// - 0.5, folded over where z = 0.5 - |x| - |y| <= 0. Worked out in units
+// of 1/14, where they are whole numbers, so that the fold does not depend
+// on rounding. z is exactly 0 for 42 of the 289 hashes, and the highp
+// code folds all of them but i = 147, by its rounding errors. So does
+// this.
+void cgrad(vec4 i, out vec4 gx, out vec4 gy, out vec4 gz)
+{
+  vec4 q = floor((i + 0.5) * (1.0 / 7.0));
+  gx = 2.0 * (i - 7.0 * q);
+  gy = 2.0 * mod7(q) - 7.0;
+  gz = 7.0 - abs(gx) - abs(gy);
+  vec4 sz = step(gz, vec4(0.0)) - step(abs(i - 147.0), vec4(0.0));
+  gx -= sz * (step(0.0, gx) * 14.0 - 7.0);
+  gy -= sz * (step(0.0, gy) * 14.0 - 7.0);
+  gx *= 1.0 / 14.0;
+  gy *= 1.0 / 14.0;
+  gz *= 1.0 / 14.0;
+}
+
+// Classic Perlin noise
+float cnoise(vec3 P)
+{
+  vec3 Pi0 = floor(P); // Integer part for indexing
+  vec3 Pi1 = Pi0 + vec3(1.0); // Integer part + 1
+  Pi0 = mod289(Pi0);
+  Pi1 = mod289(Pi1);
+  vec3 Pf0 = fract(P); // Fractional part for interpolation
+  vec3 Pf1 = Pf0 - vec3(1.0); // Fractional part - 1.0
+  vec4 ix = vec4(Pi0.x, Pi1.x, Pi0.x, Pi1.x);
+  vec4 iy = vec4(Pi0.yy, Pi1.yy);
+  vec4 iz0 = Pi0.zzzz;
+  vec4 iz1 = Pi1.zzzz;
+
+  vec4 ixy = permute(permute(ix) + iy);
+  vec4 ixy0 = mod289(permute(ixy + iz0));
+  vec4 ixy1 = mod289(permute(ixy + iz1));
+
+  vec4 gx0, gy0, gz0, gx1, gy1, gz1;
+  cgrad(ixy0, gx0, gy0, gz0);
+  cgrad(ixy1, gx1, gy1, gz1);
+
+  vec3 g000 = vec3(gx0.x,gy0.x,gz0.x);
+  vec3 g100 = vec3(gx0.y,gy0.y,gz0.y);
+  vec3 g010 = vec3(gx0.z,gy0.z,gz0.z);
+  vec3 g110 = vec3(gx0.w,gy0.w,gz0.w);
+  vec3 g001 = vec3(gx1.x,gy1.x,gz1.x);
+  vec3 g101 = vec3(gx1.y,gy1.y,gz1.y);
+  vec3 g011 = vec3(gx1.z,gy1.z,gz1.z);
+  vec3 g111 = vec3(gx1.w,gy1.w,gz1.w);
+
+  vec4 norm0 = taylorInvSqrt(vec4(dot(g000, g000), dot(g010, g010), dot(g100, g100), dot(g110, g110)));
+  vec4 norm1 = taylorInvSqrt(vec4(dot(g001, g001), dot(g011, g011), dot(g101, g101), dot(g111, g111)));
+
+  float n000 = norm0.x * dot(g000, Pf0);
+  float n010 = norm0.y * dot(g010, vec3(Pf0.x, Pf1.y, Pf0.z));
+  float n100 = norm0.z * dot(g100, vec3(Pf1.x, Pf0.yz));
+  float n110 = norm0.w * dot(g110, vec3(Pf1.xy, Pf0.z));
+  float n001 = norm1.x * dot(g001, vec3(Pf0.xy, Pf1.z));
+  float n011 = norm1.y * dot(g011, vec3(Pf0.x, Pf1.yz));
+  float n101 = norm1.z * dot(g101, vec3(Pf1.x, Pf0.y, Pf1.z));
+  float n111 = norm1.w * dot(g111, Pf1);
+
+  vec3 fade_xyz = fade(Pf0);
+  vec4 n_z = mix(vec4(n000, n100, n010, n110), vec4(n001, n101, n011, n111), fade_xyz.z);
+  vec2 n_yz = mix(n_z.xy, n_z.zw, fade_xyz.y);
+  float n_xyz = mix(n_yz.x, n_yz.y, fade_xyz.x);
+  return 2.2 * n_xyz;
+}
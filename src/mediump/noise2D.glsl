@@ -0,0 +1,96 @@
+//
+// Description : Array and textureless GLSL 2D simplex noise function,
+//               with a lattice hash that is exact with mediump floats.
+//      Author : Ian McEwan, Ashima Arts.
+//  Maintainer : stegu
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// float snoise(vec2 v)
+// The same noise as snoise() of ../noise2D.glsl, for shaders that run
+// with mediump floats: no whole number in the hash exceeds 650 (2048 for
+// mod289() of the lattice coordinates), so half floats pick the same
+// gradients as highp floats. See README.
+//
+
+// x mod 289 for whole numbers -2048 <= x <= 2048. The quotient may come
+// out one too small or too large, which the steps correct.
+vec3 mod289(vec3 x) {
+  x -= floor(x * (1.0 / 289.0)) * 289.0;
+  x += 289.0 * (1.0 - step(0.0, x));
+  return x - 289.0 * step(289.0, x);
+}
+
+vec2 mod289(vec2 x) {
+  x -= floor(x * (1.0 / 289.0)) * 289.0;
+  x += 289.0 * (1.0 - step(0.0, x));
+  return x - 289.0 * step(289.0, x);
+}
+
+// x mod 17 and x mod 41 for whole numbers -80 <= x < 360. The offset of
+// 0.5 keeps the quotient clear of whole numbers by more than its
+// rounding error.
+vec3 mod17(vec3 x) {
+  return x - floor((x + 0.5) * (1.0 / 17.0)) * 17.0;
+}
+
+vec3 mod41(vec3 x) {
+  return x - floor((x + 0.5) * (1.0 / 41.0)) * 41.0;
+}
+
+// (34x^2 + 10x) mod 289, as permute() of ../noise2D.glsl, for whole
+// numbers -80 <= x < 642, up to a multiple of 289: the result is between
+// -80 and 352, which the next permute() takes as it is, and mod289()
+// reduces once the hash is complete. With x = 17a + b, -8 <= b <= 8,
+// (34x^2 + 10x) mod 289 = (10b + 17 ((2b^2 + 10a) mod 17)) mod 289.
+vec3 permute(vec3 x) {
+  x -= 289.0 * step(289.0, x);
+  vec3 a = floor((x + 8.5) * (1.0 / 17.0));
+  vec3 b = x - 17.0 * a;
+  return 10.0 * b + 17.0 * mod17(2.0 * b * b + 10.0 * a);
+}
+
+float snoise(vec2 v)
+  {
+  const vec4 C = vec4(0.211324865405187,  // (3.0-sqrt(3.0))/6.0
+                      0.366025403784439,  // 0.5*(sqrt(3.0)-1.0)
+                     -0.577350269189626,  // -1.0 + 2.0 * C.x
+                      0.048780487804878); // 2.0 / 41.0
+// First corner
+  vec2 i  = floor(v + dot(v, C.yy) );
+  vec2 x0 = v -   i + dot(i, C.xx);
+
+// Other corners
+  vec2 i1 = (x0.x > x0.y) ? vec2(1.0, 0.0) : vec2(0.0, 1.0);
+  vec4 x12 = x0.xyxy + C.xxzz;
+  x12.xy -= i1;
+
+// Permutations
+  i = mod289(i);
+  vec3 p = mod289( permute( permute( i.y + vec3(0.0, i1.y, 1.0 ))
+		+ i.x + vec3(0.0, i1.x, 1.0 )));
+
+  vec3 m = max(0.5 - vec3(dot(x0,x0), dot(x12.xy,x12.xy), dot(x12.zw,x12.zw)), 0.0);
+  m = m*m ;
+  m = m*m ;
+
+// Gradients: 41 points uniformly over a line, mapped onto a diamond,
+// 2.0 * fract(p / 41.0) - 1.0 of ../noise2D.glsl
+
+  vec3 x = mod41(p) * C.www - 1.0;
+  vec3 h = abs(x) - 0.5;
+  vec3 ox = floor(x + 0.5);
+  vec3 a0 = x - ox;
+
+// Normalise gradients implicitly by scaling m
+// Approximation of: m *= inversesqrt( a0*a0 + h*h );
+  m *= 1.79284291400159 - 0.85373472095314 * ( a0*a0 + h*h );
+
+// Compute final noise value at P
+  vec3 g;
+  g.x  = a0.x  * x0.x  + h.x  * x0.y;
+  g.yz = a0.yz * x12.xz + h.yz * x12.yw;
+  return 130.0 * dot(m, g);
+}
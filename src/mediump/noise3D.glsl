@@ -0,0 +1,124 @@
+//
+// Description : Array and textureless GLSL 3D simplex noise function,
+//               with a lattice hash that is exact with mediump floats.
+//      Author : Ian McEwan, Ashima Arts.
+//  Maintainer : stegu
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// float snoise(vec3 v)
+// The same noise as snoise() of ../noise3D.glsl, for shaders that run
+// with mediump floats: no whole number in the hash exceeds 650 (2048 for
+// mod289() of the lattice coordinates), so half floats pick the same
+// gradients as highp floats. See README.
+//
+
+// x mod 289 for whole numbers -2048 <= x <= 2048. The quotient may come
+// out one too small or too large, which the steps correct.
+vec3 mod289(vec3 x) {
+  x -= floor(x * (1.0 / 289.0)) * 289.0;
+  x += 289.0 * (1.0 - step(0.0, x));
+  return x - 289.0 * step(289.0, x);
+}
+
+vec4 mod289(vec4 x) {
+  x -= floor(x * (1.0 / 289.0)) * 289.0;
+  x += 289.0 * (1.0 - step(0.0, x));
+  return x - 289.0 * step(289.0, x);
+}
+
+// x mod 17 and x mod 49 for whole numbers -80 <= x < 360. The offset of
+// 0.5 keeps the quotient clear of whole numbers by more than its
+// rounding error.
+vec4 mod17(vec4 x) {
+  return x - floor((x + 0.5) * (1.0 / 17.0)) * 17.0;
+}
+
+vec4 mod49(vec4 x) {
+  return x - floor((x + 0.5) * (1.0 / 49.0)) * 49.0;
+}
+
+// (34x^2 + 10x) mod 289, as permute() of ../noise3D.glsl, for whole
+// numbers -80 <= x < 642, up to a multiple of 289: the result is between
+// -80 and 352, which the next permute() takes as it is, and mod289()
+// reduces once the hash is complete. With x = 17a + b, -8 <= b <= 8,
+// (34x^2 + 10x) mod 289 = (10b + 17 ((2b^2 + 10a) mod 17)) mod 289.
+vec4 permute(vec4 x) {
+  x -= 289.0 * step(289.0, x);
+  vec4 a = floor((x + 8.5) * (1.0 / 17.0));
+  vec4 b = x - 17.0 * a;
+  return 10.0 * b + 17.0 * mod17(2.0 * b * b + 10.0 * a);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+float snoise(vec3 v)
+  {
+  const vec2  C = vec2(1.0/6.0, 1.0/3.0) ;
+  const vec4  D = vec4(0.0, 0.5, 1.0, 2.0);
+
+// First corner
+  vec3 i  = floor(v + dot(v, C.yyy) );
+  vec3 x0 =   v - i + dot(i, C.xxx) ;
+
+// Other corners
+  vec3 g = step(x0.yzx, x0.xyz);
+  vec3 l = 1.0 - g;
+  vec3 i1 = min( g.xyz, l.zxy );
+  vec3 i2 = max( g.xyz, l.zxy );
+
+  vec3 x1 = x0 - i1 + C.xxx;
+  vec3 x2 = x0 - i2 + C.yyy; // 2.0*C.x = 1/3 = C.y
+  vec3 x3 = x0 - D.yyy;      // -1.0+3.0*C.x = -0.5 = -D.y
+
+// Permutations
+  i = mod289(i);
+  vec4 p = mod289( permute( permute( permute(
+             i.z + vec4(0.0, i1.z, i2.z, 1.0 ))
+           + i.y + vec4(0.0, i1.y, i2.y, 1.0 ))
+           + i.x + vec4(0.0, i1.x, i2.x, 1.0 )));
+
+// Gradients: 7x7 points over a square, mapped onto an octahedron.
+// j = p mod 49 is split into x_ = floor(j / 7) and y_ = j mod 7, with
+// the same offset of 0.5 as in mod49().
+  vec4 j = mod49(p);
+
+  vec4 x_ = floor((j + 0.5) * (1.0 / 7.0));
+  vec4 y_ = j - 7.0 * x_;
+
+// The gradients of ../noise3D.glsl in units of 1/14, where they are
+// whole numbers: x = (2 x_ + 0.5) / 7 - 1, and so on. The octahedron is
+// folded over where h <= 0. h is exactly 0 for 7 of the 49 gradients,
+// where the highp code folds by the sign of its rounding error: for
+// x > 0, and not for x < 0. This does the same.
+  vec4 x = 4.0 * x_ - 13.0;
+  vec4 y = 4.0 * y_ - 13.0;
+  vec4 h = 14.0 - abs(x) - abs(y);
+  vec4 sh = -14.0 * step(h, step(0.0, x) - 1.0);
+  x = (x + (step(0.0, x) * 2.0 - 1.0) * sh) * (1.0 / 14.0);
+  y = (y + (step(0.0, y) * 2.0 - 1.0) * sh) * (1.0 / 14.0);
+  h *= 1.0 / 14.0;
+
+  vec3 p0 = vec3(x.x, y.x, h.x);
+  vec3 p1 = vec3(x.y, y.y, h.y);
+  vec3 p2 = vec3(x.z, y.z, h.z);
+  vec3 p3 = vec3(x.w, y.w, h.w);
+
+//Normalise gradients
+  vec4 norm = taylorInvSqrt(vec4(dot(p0,p0), dot(p1,p1), dot(p2, p2), dot(p3,p3)));
+  p0 *= norm.x;
+  p1 *= norm.y;
+  p2 *= norm.z;
+  p3 *= norm.w;
+
+// Mix final noise value
+  vec4 m = max(0.5 - vec4(dot(x0,x0), dot(x1,x1), dot(x2,x2), dot(x3,x3)), 0.0);
+  m = m * m;
+  return 105.0 * dot( m*m, vec4( dot(p0,x0), dot(p1,x1),
+                                dot(p2,x2), dot(p3,x3) ) );
+  }
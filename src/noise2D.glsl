@@ -8,6 +8,17 @@
 //               https://github.com/ashima/webgl-noise
 //               https://github.com/stegu/webgl-noise
 // 
+// float snoise(vec2 v)
+// "v" is the input (x,y) coordinate
+//
+// vec4 snoise4x(vec4 xs, vec4 ys)
+// The same noise at the four points (xs.x, ys.x) .. (xs.w, ys.w), for
+// multi-tap effects like finite differences or supersampling.
+//
+
+vec4 mod289(vec4 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
 
 vec3 mod289(vec3 x) {
   return x - floor(x * (1.0 / 289.0)) * 289.0;
@@ -17,6 +28,10 @@ vec2 mod289(vec2 x) {
   return x - floor(x * (1.0 / 289.0)) * 289.0;
 }
 
+vec4 permute(vec4 x) {
+  return mod289(((x*34.0)+10.0)*x);
+}
+
 vec3 permute(vec3 x) {
   return mod289(((x*34.0)+10.0)*x);
 }
@@ -69,3 +84,61 @@ float snoise(vec2 v)
   g.yz = a0.yz * x12.xz + h.yz * x12.yw;
   return 130.0 * dot(m, g);
 }
+
+// snoise4x() keeps one point per vector component, where snoise() packs
+// the three corners of one point into vec3s and its coordinates into
+// vec2s. So all the arithmetic is on full vec4s, which suits GPUs and
+// software renderers that execute vec4 operations at the cost of one,
+// and they give the same noise as snoise().
+
+// Contribution of one simplex corner to the noise at four points, from
+// the hashes p of the corner and the vectors (x, y) from it to the points
+vec4 scorner4x(vec4 p, vec4 x, vec4 y)
+{
+  vec4 m = max(0.5 - (x*x + y*y), 0.0);
+  m = m*m ;
+  m = m*m ;
+
+// Gradients: 41 points uniformly over a line, mapped onto a diamond
+  vec4 gx = 2.0 * fract(p * 0.024390243902439) - 1.0;
+  vec4 h = abs(gx) - 0.5;
+  vec4 a0 = gx - floor(gx + 0.5);
+
+// Normalise gradients implicitly by scaling m
+  m *= 1.79284291400159 - 0.85373472095314 * ( a0*a0 + h*h );
+  return m * (a0*x + h*y);
+}
+
+vec4 snoise4x(vec4 xs, vec4 ys)
+  {
+  const vec4 C = vec4(0.211324865405187,  // (3.0-sqrt(3.0))/6.0
+                      0.366025403784439,  // 0.5*(sqrt(3.0)-1.0)
+                     -0.577350269189626,  // -1.0 + 2.0 * C.x
+                      0.024390243902439); // 1.0 / 41.0
+// First corners
+  vec4 s = xs * C.y + ys * C.y;
+  vec4 ix = floor(xs + s);
+  vec4 iy = floor(ys + s);
+  vec4 t = ix * C.x + iy * C.x;
+  vec4 x0 = xs - ix + t;
+  vec4 y0 = ys - iy + t;
+
+// Other corners
+  vec4 i1x = vec4(greaterThan(x0, y0)); // x0 > y0 ? 1.0 : 0.0
+  vec4 i1y = 1.0 - i1x;
+  vec4 x1 = x0 + C.x - i1x;
+  vec4 y1 = y0 + C.x - i1y;
+  vec4 x2 = x0 + C.z;
+  vec4 y2 = y0 + C.z;
+
+// Permutations
+  ix = mod289(ix); // Avoid truncation effects in permutation
+  iy = mod289(iy);
+  vec4 p0 = permute( permute( iy ) + ix );
+  vec4 p1 = permute( permute( iy + i1y ) + ix + i1x );
+  vec4 p2 = permute( permute( iy + 1.0 ) + ix + 1.0 );
+
+// Compute final noise values at the four points
+  return 130.0 * (scorner4x(p0, x0, y0) + scorner4x(p1, x1, y1)
+                  + scorner4x(p2, x2, y2));
+}
@@ -0,0 +1,118 @@
+//
+// Description : Periodic (tiling) 3D simplex noise in GLSL.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// float psnoise(vec3 P, vec3 rep)
+// "P" is the input (x,y,z) coordinate
+// "rep" is the x, y and z period, each a positive integer
+// The return value is the noise value, with the same range and look as
+// snoise(vec3) in noise3D.glsl.
+//
+// The lattice of snoise(vec3) does not repeat under whole-number shifts
+// of P, so it cannot tile. Here, the lattice coordinates are uvw = M*P,
+// with M the matrix with zeros on the diagonal and ones elsewhere. Its
+// corners (a body-centred cubic lattice in P) have simplices of the same
+// size and shape as those of snoise(vec3), but they repeat under any
+// whole-number shift. As in psrdnoise2D.glsl, each simplex corner is
+// wrapped to the period in (x,y,z) and mapped back to uvw before it is
+// hashed.
+//
+
+vec4 mod289(vec4 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
+
+vec4 permute(vec4 x) {
+     return mod289(((x*34.0)+10.0)*x);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+float psnoise(vec3 P, vec3 rep)
+  {
+  const vec4  D = vec4(0.0, 0.5, 1.0, 2.0);
+  // uvw = M * P, and P = Mi * uvw
+  const mat3 M = mat3(0.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0);
+  const mat3 Mi = mat3(-0.5, 0.5, 0.5, 0.5, -0.5, 0.5, 0.5, 0.5, -0.5);
+
+// First corner
+  vec3 uvw = M * P;
+  vec3 i0 = floor(uvw);
+  vec3 f0 = fract(uvw);
+
+// Other corners, stepping first along the largest component of f0
+  vec3 g_ = step(f0.xyx, f0.yzz);
+  vec3 l_ = 1.0 - g_;
+  vec3 g = vec3(l_.z, g_.xy);
+  vec3 l = vec3(l_.xy, g_.z);
+  vec3 o1 = min( g, l );
+  vec3 o2 = max( g, l );
+
+  // The corners in (x,y,z), and the vectors from them to P
+  vec3 v0 = Mi * i0;
+  vec3 v1 = Mi * (i0 + o1);
+  vec3 v2 = Mi * (i0 + o2);
+  vec3 v3 = Mi * (i0 + 1.0);
+  vec3 x0 = P - v0;
+  vec3 x1 = P - v1;
+  vec3 x2 = P - v2;
+  vec3 x3 = P - v3;
+
+// Wrap the corners to the period in (x,y,z), map them back to uvw
+// (u = y + z, v = x + z, w = x + y) and hash them
+  vec4 vx = mod(vec4(v0.x, v1.x, v2.x, v3.x), rep.x);
+  vec4 vy = mod(vec4(v0.y, v1.y, v2.y, v3.y), rep.y);
+  vec4 vz = mod(vec4(v0.z, v1.z, v2.z, v3.z), rep.z);
+  vec4 iu = mod289(floor(vy + vz + 0.5));
+  vec4 iv = mod289(floor(vx + vz + 0.5));
+  vec4 iw = mod289(floor(vx + vy + 0.5));
+  vec4 p = permute( permute( permute( iw ) + iv ) + iu );
+
+// Gradients: 7x7 points over a square, mapped onto an octahedron,
+// as in noise3D.glsl
+  float n_ = 0.142857142857; // 1.0/7.0
+  vec3  ns = n_ * D.wyz - D.xzx;
+
+  vec4 j = p - 49.0 * floor(p * ns.z * ns.z);  //  mod(p,7*7)
+
+  vec4 x_ = floor(j * ns.z);
+  vec4 y_ = floor(j - 7.0 * x_ );    // mod(j,N)
+
+  vec4 x = x_ *ns.x + ns.yyyy;
+  vec4 y = y_ *ns.x + ns.yyyy;
+  vec4 h = 1.0 - abs(x) - abs(y);
+
+  vec4 b0 = vec4( x.xy, y.xy );
+  vec4 b1 = vec4( x.zw, y.zw );
+
+  vec4 s0 = floor(b0)*2.0 + 1.0;
+  vec4 s1 = floor(b1)*2.0 + 1.0;
+  vec4 sh = -step(h, vec4(0.0));
+
+  vec4 a0 = b0.xzyw + s0.xzyw*sh.xxyy ;
+  vec4 a1 = b1.xzyw + s1.xzyw*sh.zzww ;
+
+  vec3 p0 = vec3(a0.xy,h.x);
+  vec3 p1 = vec3(a0.zw,h.y);
+  vec3 p2 = vec3(a1.xy,h.z);
+  vec3 p3 = vec3(a1.zw,h.w);
+
+//Normalise gradients
+  vec4 norm = taylorInvSqrt(vec4(dot(p0,p0), dot(p1,p1), dot(p2, p2), dot(p3,p3)));
+  p0 *= norm.x;
+  p1 *= norm.y;
+  p2 *= norm.z;
+  p3 *= norm.w;
+
+// Mix final noise value
+  vec4 m = max(0.5 - vec4(dot(x0,x0), dot(x1,x1), dot(x2,x2), dot(x3,x3)), 0.0);
+  m = m * m;
+  return 105.0 * dot( m*m, vec4( dot(p0,x0), dot(p1,x1),
+                                dot(p2,x2), dot(p3,x3) ) );
+  }
@@ -0,0 +1,146 @@
+//
+// Description : Periodic (tiling) 4D simplex noise in GLSL.
+//     License : Copyright (C) 2011 Ashima Arts. All rights reserved.
+//               Distributed under the MIT License. See LICENSE file.
+//               https://github.com/ashima/webgl-noise
+//               https://github.com/stegu/webgl-noise
+//
+// float psnoise(vec4 P, vec4 rep)
+// "P" is the input (x,y,z,w) coordinate
+// "rep" is the period along each axis, each a positive multiple of 4
+// The return value is the noise value, with much the same range and look
+// as snoise(vec4) in noise4D.glsl.
+//
+// The skew factor (sqrt(5) - 1)/4 of snoise(vec4) is irrational, so its
+// lattice never repeats under whole-number shifts of P. Here it is
+// rounded to 1/4, and the unskew factor to 1/8, which makes simplices of
+// nearly the same shape. This lattice repeats under shifts by multiples
+// of 4 along each axis. As in psrdnoise2D.glsl, each simplex corner is
+// wrapped to the period in (x,y,z,w) and mapped back to the lattice
+// before it is hashed. Other whole-number periods give a noise that
+// repeats after the least common multiple of "rep" and 4.
+//
+// For a looping animation of a tiling 2D pattern, use x and y for the
+// pattern and w for time: psnoise(vec4(p, 0.0, t), vec4(rep, 4.0, 8.0))
+// tiles in p and repeats every 8 units of t.
+//
+
+vec4 mod289(vec4 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0; }
+
+float mod289(float x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0; }
+
+vec4 permute(vec4 x) {
+     return mod289(((x*34.0)+10.0)*x);
+}
+
+float permute(float x) {
+     return mod289(((x*34.0)+10.0)*x);
+}
+
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+float taylorInvSqrt(float r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+vec4 grad4(float j, vec4 ip)
+  {
+  const vec4 ones = vec4(1.0, 1.0, 1.0, -1.0);
+  vec4 p,s;
+
+  p.xyz = floor( fract (vec3(j) * ip.xyz) * 7.0) * ip.z - 1.0;
+  p.w = 1.5 - dot(abs(p.xyz), ones.xyz);
+  s = vec4(lessThan(p, vec4(0.0)));
+  p.xyz = p.xyz + (s.xyz*2.0 - 1.0) * s.www;
+
+  return p;
+  }
+
+// The lattice point of the simplex corner at v, wrapped to the period
+vec4 pwrap4(vec4 v, vec4 rep) {
+  v = mod(v, rep);
+  return mod289(floor(v + dot(v, vec4(0.25)) + 0.5));
+}
+
+float psnoise(vec4 v, vec4 rep)
+  {
+  const vec4  C = vec4( 0.125,  // G4, rounded from (5 - sqrt(5))/20
+                        0.25,   // 2 * G4
+                        0.375,  // 3 * G4
+                       -0.5);   // -1 + 4 * G4
+
+// First corner
+  vec4 i  = floor(v + dot(v, vec4(0.25)) ); // F4, rounded from (sqrt(5) - 1)/4
+  vec4 x0 = v -   i + dot(i, C.xxxx);
+
+// Other corners
+
+// Rank sorting originally contributed by Bill Licea-Kane, AMD (formerly ATI)
+  vec4 i0;
+  vec3 isX = step( x0.yzw, x0.xxx );
+  vec3 isYZ = step( x0.zww, x0.yyz );
+  i0.x = isX.x + isX.y + isX.z;
+  i0.yzw = 1.0 - isX;
+  i0.y += isYZ.x + isYZ.y;
+  i0.zw += 1.0 - isYZ.xy;
+  i0.z += isYZ.z;
+  i0.w += 1.0 - isYZ.z;
+
+  // i0 now contains the unique values 0,1,2,3 in each channel
+  vec4 i3 = clamp( i0, 0.0, 1.0 );
+  vec4 i2 = clamp( i0-1.0, 0.0, 1.0 );
+  vec4 i1 = clamp( i0-2.0, 0.0, 1.0 );
+
+  vec4 x1 = x0 - i1 + C.xxxx;
+  vec4 x2 = x0 - i2 + C.yyyy;
+  vec4 x3 = x0 - i3 + C.zzzz;
+  vec4 x4 = x0 + C.wwww;
+
+// Wrap the corners to the period and hash them. The corners are exact,
+// as G4 is a power of two.
+  vec4 v0 = i - dot(i, C.xxxx);
+  vec4 k0 = pwrap4(v0, rep);
+  vec4 k1 = pwrap4(v0 + i1 - C.xxxx, rep);
+  vec4 k2 = pwrap4(v0 + i2 - C.yyyy, rep);
+  vec4 k3 = pwrap4(v0 + i3 - C.zzzz, rep);
+  vec4 k4 = pwrap4(v0 - C.wwww, rep);
+  float j0 = permute( permute( permute( permute(k0.w) + k0.z) + k0.y) + k0.x);
+  vec4 j1 = permute( permute( permute( permute (
+             vec4(k1.w, k2.w, k3.w, k4.w))
+           + vec4(k1.z, k2.z, k3.z, k4.z))
+           + vec4(k1.y, k2.y, k3.y, k4.y))
+           + vec4(k1.x, k2.x, k3.x, k4.x));
+
+// Gradients: 7x7x6 points over a cube, mapped onto a 4-cross polytope
+// 7*7*6 = 294, which is close to the ring size 17*17 = 289.
+  vec4 ip = vec4(1.0/294.0, 1.0/49.0, 1.0/7.0, 0.0) ;
+
+  vec4 p0 = grad4(j0,   ip);
+  vec4 p1 = grad4(j1.x, ip);
+  vec4 p2 = grad4(j1.y, ip);
+  vec4 p3 = grad4(j1.z, ip);
+  vec4 p4 = grad4(j1.w, ip);
+
+// Normalise gradients
+  vec4 norm = taylorInvSqrt(vec4(dot(p0,p0), dot(p1,p1), dot(p2, p2), dot(p3,p3)));
+  p0 *= norm.x;
+  p1 *= norm.y;
+  p2 *= norm.z;
+  p3 *= norm.w;
+  p4 *= taylorInvSqrt(dot(p4,p4));
+
+// Mix contributions from the five corners
+  vec3 m0 = max(0.6 - vec3(dot(x0,x0), dot(x1,x1), dot(x2,x2)), 0.0);
+  vec2 m1 = max(0.6 - vec2(dot(x3,x3), dot(x4,x4)            ), 0.0);
+  m0 = m0 * m0;
+  m1 = m1 * m1;
+  return 49.0 * ( dot(m0*m0, vec3( dot( p0, x0 ), dot( p1, x1 ), dot( p2, x2 )))
+               + dot(m1*m1, vec2( dot( p3, x3 ), dot( p4, x4 ) ) ) ) ;
+
+  }
@@ -72,11 +72,19 @@ vec3 mod289(vec3 x) {
   return x - floor(x * (1.0 / 289.0)) * 289.0;
 }
 
+float mod289(float x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
+
 // Permutation polynomial (ring size 289 = 17*17)
 vec3 permute(vec3 x) {
   return mod289(((x*34.0)+10.0)*x);
 }
 
+float permute(float x) {
+  return mod289(((x*34.0)+10.0)*x);
+}
+
 // Hashed 2-D gradients with an extra rotation.
 // (The constant 0.0243902439 is 1/41)
 vec2 rgrad2(vec2 p, float rot) {
@@ -0,0 +1,352 @@
+//
+// vec4  psrdnoise(vec3 pos, vec3 per, float rot)
+// vec4  psdnoise(vec3 pos, vec3 per)
+// float psrnoise(vec3 pos, vec3 per, float rot)
+// float psnoise(vec3 pos, vec3 per)
+// vec4  srdnoise(vec3 pos, float rot)
+// vec4  sdnoise(vec3 pos)
+// float srnoise(vec3 pos, float rot)
+// float snoise(vec3 pos)
+//
+// Periodic (tiling) 3-D simplex noise with rotating gradients and
+// analytic derivatives, the 3-D counterpart of psrdnoise2D.glsl.
+// Variants also without the derivative (no "d" in the name), without
+// the tiling property (no "p" in the name) and without the rotating
+// gradients (no "r" in the name).
+//
+// The simplex grid is that of psnoise3D.glsl: the lattice coordinates
+// are M * pos, with M the matrix with zeros on the diagonal and ones
+// elsewhere, so that the grid repeats under any whole-number shift.
+// The noise can be made to tile seamlessly to any integer period along
+// each axis. A period of 0.0 leaves that axis without tiling.
+//
+// The gradients are points on a Fibonacci spiral on the unit sphere,
+// picked by the hash of the corner. Each is rotated around an axis of
+// its own, perpendicular to it, picked by the same hash. The rotating
+// gradients give the appearance of a swirling motion, and together with
+// the analytic derivatives they can make "flow noise" effects, as in
+// psrdnoise2D.glsl, but in a volume.
+//
+// psnoise(vec3 pos, vec3 per) is the exception: it is psnoise() from
+// psnoise3D.glsl, with the same code, so that the two files can be used
+// in one shader (see ../tools/README). It has the octahedral gradients
+// of noise3D.glsl instead, and all its periods must be positive. For
+// the spiral gradients without rotation, use psrnoise(pos, per, 0.0).
+//
+// vec4 {p}s{r}dnoise(vec3 pos {, vec3 per} {, float rot})
+// "pos" is the input (x,y,z) coordinate
+// "per" is the x, y and z period, where each component is a positive
+//    integer, or 0.0 for no tiling along that axis
+// "rot" is the angle to rotate the gradients (any float value,
+//    where 0.0 is no rotation and 1.0 is one full turn)
+// The first component of the 4-element return vector is the noise value.
+// The second to fourth components are the x, y and z partial derivatives.
+//
+// float {p}s{r}noise(vec3 pos {, vec3 per} {, float rot})
+// The same arguments. The return value is the noise value.
+// Partial derivatives are not computed, making these functions faster.
+//
+// After "Tiling simplex noise and flow noise in two and three dimensions"
+// by Stefan Gustavson and Ian McEwan, JCGT vol. 11, no. 1, 2022.
+//
+// Copyright (c) 2022 Stefan Gustavson and Ian McEwan. All rights reserved.
+// Distributed under the MIT license. See LICENSE file.
+// https://github.com/stegu/webgl-noise
+//
+
+// Modulo 289, optimizes to code without divisions
+vec4 mod289(vec4 x) {
+  return x - floor(x * (1.0 / 289.0)) * 289.0;
+}
+
+// Permutation polynomial (ring size 289 = 17*17)
+vec4 permute(vec4 x) {
+  return mod289(((x*34.0)+10.0)*x);
+}
+
+// Normalisation of the gradients of psnoise(), as in psnoise3D.glsl
+vec4 taylorInvSqrt(vec4 r)
+{
+  return 1.79284291400159 - 0.85373472095314 * r;
+}
+
+// The simplex of pos: the vectors x0 .. x3 from its corners to pos,
+// and the hash of each corner, with the corners wrapped to the period
+// "per" along the axes where it is not 0.0.
+vec4 psrd3_simplex(vec3 pos, vec3 per,
+                   out vec3 x0, out vec3 x1, out vec3 x2, out vec3 x3) {
+  const mat3 M = mat3(0.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0);
+  const mat3 Mi = mat3(-0.5, 0.5, 0.5, 0.5, -0.5, 0.5, 0.5, 0.5, -0.5);
+
+  // Transform to simplex space (tetrahedral grid)
+  vec3 uvw = M * pos;
+
+  // Determine which simplex we're in, i0 is the "base corner"
+  vec3 i0 = floor(uvw);
+  vec3 f0 = fract(uvw);
+
+  // Traversal order: step along the components of f0 from the largest
+  vec3 g_ = step(f0.xyx, f0.yzz);
+  vec3 l_ = 1.0 - g_;
+  vec3 g = vec3(l_.z, g_.xy);
+  vec3 l = vec3(l_.xy, g_.z);
+  vec3 o1 = min(g, l);
+  vec3 o2 = max(g, l);
+
+  // The corners in (x,y,z) space, and the vectors from them to pos
+  vec3 v0 = Mi * i0;
+  vec3 v1 = Mi * (i0 + o1);
+  vec3 v2 = Mi * (i0 + o2);
+  vec3 v3 = Mi * (i0 + 1.0);
+  x0 = pos - v0;
+  x1 = pos - v1;
+  x2 = pos - v2;
+  x3 = pos - v3;
+
+  // Wrap the corners to the period in (x,y,z), where there is one, and
+  // map them back to simplex space (u = y + z, v = x + z, w = x + y)
+  vec4 vx = vec4(v0.x, v1.x, v2.x, v3.x);
+  vec4 vy = vec4(v0.y, v1.y, v2.y, v3.y);
+  vec4 vz = vec4(v0.z, v1.z, v2.z, v3.z);
+  if (per.x > 0.0) vx = mod(vx, per.x);
+  if (per.y > 0.0) vy = mod(vy, per.y);
+  if (per.z > 0.0) vz = mod(vz, per.z);
+  // Avoid truncation errors in the wrapped coordinates, and precision
+  // issues in the permutation
+  vec4 iu = mod289(floor(vy + vz + 0.5));
+  vec4 iv = mod289(floor(vx + vz + 0.5));
+  vec4 iw = mod289(floor(vx + vy + 0.5));
+
+  return permute(permute(permute(iw) + iv) + iu);
+}
+
+// Hashed 3-D gradients with an extra rotation: points on a Fibonacci
+// spiral on the unit sphere, rotated by the angle rot (in turns) around
+// a pseudo-random axis perpendicular to them.
+void rgrad3(vec4 hash, float rot, out vec4 gx, out vec4 gy, out vec4 gz) {
+  vec4 theta = hash * 3.883222077;  // 2*pi/golden ratio
+  vec4 sz    = hash * -0.006920415 + 0.996539792; // 1-(hash+0.5)*2/289
+  vec4 psi   = hash * 0.108705628; // 10*pi/289, chosen to avoid correlation
+
+  vec4 Ct = cos(theta);
+  vec4 St = sin(theta);
+  vec4 sz_prime = sqrt(1.0 - sz*sz); // s is a point on a unit fib-sphere
+
+  if (rot != 0.0) {
+    vec4 Sp = sin(psi); // q' from psi on the equator
+    vec4 Cp = cos(psi);
+
+    vec4 px = Ct * sz_prime; // p = s
+    vec4 py = St * sz_prime;
+    vec4 pz = sz;
+
+    vec4 Ctp = St*Sp - Ct*Cp; // q = rotate(cross(s,n), dot(s,n))(q')
+    vec4 qx = mix( Ctp*St, Sp, sz);
+    vec4 qy = mix(-Ctp*Ct, Cp, sz);
+    vec4 qz = -(py*Cp + px*Sp);
+
+    float alpha = rot * 6.28318530718; // 2*pi
+    vec4 Sa = vec4(sin(alpha));
+    vec4 Ca = vec4(cos(alpha));
+
+    gx = Ca*px + Sa*qx;
+    gy = Ca*py + Sa*qy;
+    gz = Ca*pz + Sa*qz;
+  } else {
+    gx = Ct * sz_prime; // No rotation, use s directly as the gradient
+    gy = St * sz_prime;
+    gz = sz;
+  }
+}
+
+//
+// 3-D tiling simplex noise with rotating gradients and analytical derivative.
+// The first component of the 4-element return vector is the noise value,
+// and the second to fourth components are the x, y and z partial derivatives.
+//
+vec4 psrdnoise(vec3 pos, vec3 per, float rot) {
+  vec3 x0, x1, x2, x3;
+  vec4 hash = psrd3_simplex(pos, per, x0, x1, x2, x3);
+
+  vec4 gx, gy, gz;
+  rgrad3(hash, rot, gx, gy, gz);
+  vec3 g0 = vec3(gx.x, gy.x, gz.x);
+  vec3 g1 = vec3(gx.y, gy.y, gz.y);
+  vec3 g2 = vec3(gx.z, gy.z, gz.z);
+  vec3 g3 = vec3(gx.w, gy.w, gz.w);
+
+  // Radial decay with distance from each simplex corner
+  // 0.5 is the square of 1/sqrt(2), the distance from a corner
+  // to the nearest simplex boundary that does not contain it
+  vec4 w = 0.5 - vec4(dot(x0,x0), dot(x1,x1), dot(x2,x2), dot(x3,x3));
+  w = max(w, 0.0);
+  vec4 w2 = w * w;
+  vec4 w3 = w2 * w;
+
+  // The value of the linear ramp from each of the corners
+  vec4 gdotx = vec4(dot(g0,x0), dot(g1,x1), dot(g2,x2), dot(g3,x3));
+
+  // Multiply by the radial decay and sum up the noise value
+  float n = dot(w3, gdotx);
+
+  // Compute the first order partial derivatives
+  vec4 dw = -6.0 * w2 * gdotx;
+  vec3 dn0 = w3.x * g0 + dw.x * x0;
+  vec3 dn1 = w3.y * g1 + dw.y * x1;
+  vec3 dn2 = w3.z * g2 + dw.z * x2;
+  vec3 dn3 = w3.w * g3 + dw.w * x3;
+
+  // Scale the return value to fit nicely into the range [-1,1]
+  return 39.5 * vec4(n, dn0 + dn1 + dn2 + dn3);
+}
+
+//
+// 3-D tiling simplex noise with fixed gradients
+// and analytical derivative.
+//
+vec4 psdnoise(vec3 pos, vec3 per) {
+  return psrdnoise(pos, per, 0.0);
+}
+
+//
+// 3-D tiling simplex noise with rotating gradients,
+// but without the analytical derivative.
+//
+float psrnoise(vec3 pos, vec3 per, float rot) {
+  vec3 x0, x1, x2, x3;
+  vec4 hash = psrd3_simplex(pos, per, x0, x1, x2, x3);
+
+  vec4 gx, gy, gz;
+  rgrad3(hash, rot, gx, gy, gz);
+
+  vec4 w = 0.5 - vec4(dot(x0,x0), dot(x1,x1), dot(x2,x2), dot(x3,x3));
+  w = max(w, 0.0);
+  vec4 w3 = w * w * w;
+
+  vec4 gdotx = gx * vec4(x0.x, x1.x, x2.x, x3.x)
+             + gy * vec4(x0.y, x1.y, x2.y, x3.y)
+             + gz * vec4(x0.z, x1.z, x2.z, x3.z);
+
+  // Rescale to cover the range [-1,1] reasonably well
+  return 39.5 * dot(w3, gdotx);
+}
+
+//
+// 3-D tiling simplex noise with fixed gradients, without the analytical
+// derivative: psnoise() from psnoise3D.glsl, with the same code.
+//
+float psnoise(vec3 P, vec3 rep)
+  {
+  const vec4  D = vec4(0.0, 0.5, 1.0, 2.0);
+  // uvw = M * P, and P = Mi * uvw
+  const mat3 M = mat3(0.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0);
+  const mat3 Mi = mat3(-0.5, 0.5, 0.5, 0.5, -0.5, 0.5, 0.5, 0.5, -0.5);
+
+// First corner
+  vec3 uvw = M * P;
+  vec3 i0 = floor(uvw);
+  vec3 f0 = fract(uvw);
+
+// Other corners, stepping first along the largest component of f0
+  vec3 g_ = step(f0.xyx, f0.yzz);
+  vec3 l_ = 1.0 - g_;
+  vec3 g = vec3(l_.z, g_.xy);
+  vec3 l = vec3(l_.xy, g_.z);
+  vec3 o1 = min( g, l );
+  vec3 o2 = max( g, l );
+
+  // The corners in (x,y,z), and the vectors from them to P
+  vec3 v0 = Mi * i0;
+  vec3 v1 = Mi * (i0 + o1);
+  vec3 v2 = Mi * (i0 + o2);
+  vec3 v3 = Mi * (i0 + 1.0);
+  vec3 x0 = P - v0;
+  vec3 x1 = P - v1;
+  vec3 x2 = P - v2;
+  vec3 x3 = P - v3;
+
+// Wrap the corners to the period in (x,y,z), map them back to uvw
+// (u = y + z, v = x + z, w = x + y) and hash them
+  vec4 vx = mod(vec4(v0.x, v1.x, v2.x, v3.x), rep.x);
+  vec4 vy = mod(vec4(v0.y, v1.y, v2.y, v3.y), rep.y);
+  vec4 vz = mod(vec4(v0.z, v1.z, v2.z, v3.z), rep.z);
+  vec4 iu = mod289(floor(vy + vz + 0.5));
+  vec4 iv = mod289(floor(vx + vz + 0.5));
+  vec4 iw = mod289(floor(vx + vy + 0.5));
+  vec4 p = permute( permute( permute( iw ) + iv ) + iu );
+
+// Gradients: 7x7 points over a square, mapped onto an octahedron,
+// as in noise3D.glsl
+  float n_ = 0.142857142857; // 1.0/7.0
+  vec3  ns = n_ * D.wyz - D.xzx;
+
+  vec4 j = p - 49.0 * floor(p * ns.z * ns.z);  //  mod(p,7*7)
+
+  vec4 x_ = floor(j * ns.z);
+  vec4 y_ = floor(j - 7.0 * x_ );    // mod(j,N)
+
+  vec4 x = x_ *ns.x + ns.yyyy;
+  vec4 y = y_ *ns.x + ns.yyyy;
+  vec4 h = 1.0 - abs(x) - abs(y);
+
+  vec4 b0 = vec4( x.xy, y.xy );
+  vec4 b1 = vec4( x.zw, y.zw );
+
+  vec4 s0 = floor(b0)*2.0 + 1.0;
+  vec4 s1 = floor(b1)*2.0 + 1.0;
+  vec4 sh = -step(h, vec4(0.0));
+
+  vec4 a0 = b0.xzyw + s0.xzyw*sh.xxyy ;
+  vec4 a1 = b1.xzyw + s1.xzyw*sh.zzww ;
+
+  vec3 p0 = vec3(a0.xy,h.x);
+  vec3 p1 = vec3(a0.zw,h.y);
+  vec3 p2 = vec3(a1.xy,h.z);
+  vec3 p3 = vec3(a1.zw,h.w);
+
+//Normalise gradients
+  vec4 norm = taylorInvSqrt(vec4(dot(p0,p0), dot(p1,p1), dot(p2, p2), dot(p3,p3)));
+  p0 *= norm.x;
+  p1 *= norm.y;
+  p2 *= norm.z;
+  p3 *= norm.w;
+
+// Mix final noise value
+  vec4 m = max(0.5 - vec4(dot(x0,x0), dot(x1,x1), dot(x2,x2), dot(x3,x3)), 0.0);
+  m = m * m;
+  return 105.0 * dot( m*m, vec4( dot(p0,x0), dot(p1,x1),
+                                dot(p2,x2), dot(p3,x3) ) );
+  }
+
+//
+// 3-D non-tiling simplex noise with rotating gradients and analytical
+// derivative. A period of 0.0 turns off the wrapping.
+//
+vec4 srdnoise(vec3 pos, float rot) {
+  return psrdnoise(pos, vec3(0.0), rot);
+}
+
+//
+// 3-D non-tiling simplex noise with fixed gradients and analytical derivative.
+//
+vec4 sdnoise(vec3 pos) {
+  return psrdnoise(pos, vec3(0.0), 0.0);
+}
+
+//
+// 3-D non-tiling simplex noise with rotating gradients,
+// without the analytical derivative.
+//
+float srnoise(vec3 pos, float rot) {
+  return psrnoise(pos, vec3(0.0), rot);
+}
+
+//
+// 3-D non-tiling simplex noise with fixed gradients,
+// without the analytical derivative.
+// Note: if this kind of noise is all you want, snoise() in noise3D.glsl
+// is faster.
+//
+float snoise(vec3 pos) {
+  return psrnoise(pos, vec3(0.0), 0.0);
+}
@@ -0,0 +1,977 @@
+//
+// Composer of the GLSL noise functions: writes one shader source with
+// the noise functions asked for from several of the files in ../src,
+// and the helper functions they need, like mod289() and permute(),
+// defined only once.
+//
+// Usage: glslcompose [-o output] [-g guard] [-I dir]... file[:name,...]...
+//
+// Each file is read from the current directory or one of the -I
+// directories. The names after the colon are the entry points taken
+// from that file, with all their overloads; without them, every function
+// of the file is. The output has what the entry points call, directly
+// or through other functions, and nothing else: the calls are matched
+// to the overloads by the types of their arguments, and where a type
+// cannot be worked out, all overloads with the right number of arguments
+// count as called. A function that several files define in the same way
+// is written once. If two files define the same function differently,
+// like snoise(vec3) in noise3D.glsl and psrdnoise3D.glsl, that is an
+// error. The output is wrapped in an include guard, named after the
+// output file unless -g gives the name, so "cpp -P" and #include can
+// take it more than once. The "#version" lines are dropped. The
+// "#define"s of a file are written before its functions and undefined
+// after them, as some files define the same names to different values,
+// and the comment at the start of each file that is used is kept.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+enum TokenKind { IDENT, NUMBER, PUNCT, COMMENT, DIRECTIVE };
+
+struct Token {
+    TokenKind kind;
+    std::string text;
+    size_t begin, end; // Offsets in the source text
+    int line;
+};
+
+static void fail(const char *format, const char *a = "", const char *b = "",
+                 const char *c = "") {
+    fprintf(stderr, "glslcompose: ");
+    fprintf(stderr, format, a, b, c);
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+// GLSL tokens, with comments and preprocessor lines as tokens of their own
+static std::vector<Token> lex(const std::string &s) {
+    static const char *ops[] = {
+        "<<=", ">>=", "++", "--", "<=", ">=", "==", "!=", "&&", "||", "^^",
+        "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<", ">>"
+    };
+    std::vector<Token> tokens;
+    size_t i = 0;
+    int line = 1;
+    bool lineStart = true;
+    while (i < s.size()) {
+        char ch = s[i];
+        if (ch == '\n') {
+            line++;
+            lineStart = true;
+            i++;
+            continue;
+        }
+        if (isspace((unsigned char)ch)) {
+            i++;
+            continue;
+        }
+        Token t;
+        t.begin = i;
+        t.line = line;
+        if (ch == '#' && lineStart) {
+            // To the end of the line, with continuation lines
+            t.kind = DIRECTIVE;
+            while (i < s.size() && s[i] != '\n') {
+                if (s[i] == '\\' && i + 1 < s.size() && s[i + 1] == '\n') {
+                    i++;
+                    line++;
+                }
+                i++;
+            }
+        } else if (s.compare(i, 2, "//") == 0) {
+            t.kind = COMMENT;
+            while (i < s.size() && s[i] != '\n')
+                i++;
+        } else if (s.compare(i, 2, "/*") == 0) {
+            t.kind = COMMENT;
+            size_t e = s.find("*/", i + 2);
+            e = e == std::string::npos ? s.size() : e + 2;
+            for (; i < e; i++)
+                line += s[i] == '\n';
+        } else if (isalpha((unsigned char)ch) || ch == '_') {
+            t.kind = IDENT;
+            while (i < s.size() && (isalnum((unsigned char)s[i]) || s[i] == '_'))
+                i++;
+        } else if (isdigit((unsigned char)ch) ||
+                   (ch == '.' && i + 1 < s.size() && isdigit((unsigned char)s[i + 1]))) {
+            t.kind = NUMBER;
+            bool hex = s.compare(i, 2, "0x") == 0 || s.compare(i, 2, "0X") == 0;
+            while (i < s.size() && (isalnum((unsigned char)s[i]) || s[i] == '.')) {
+                if (!hex && (s[i] == 'e' || s[i] == 'E') && i + 1 < s.size() &&
+                    (s[i + 1] == '+' || s[i + 1] == '-'))
+                    i++;
+                i++;
+            }
+        } else {
+            t.kind = PUNCT;
+            size_t n = 1;
+            for (const char *op : ops)
+                if (s.compare(i, strlen(op), op) == 0) {
+                    n = strlen(op);
+                    break;
+                }
+            i += n;
+        }
+        t.end = i;
+        t.text = s.substr(t.begin, t.end - t.begin);
+        if (t.kind != COMMENT)
+            lineStart = false;
+        tokens.push_back(t);
+    }
+    return tokens;
+}
+
+static bool isTypeName(const std::string &s) {
+    static const std::set<std::string> types = {
+        "void", "float", "int", "uint", "bool",
+        "vec2", "vec3", "vec4", "ivec2", "ivec3", "ivec4",
+        "uvec2", "uvec3", "uvec4", "bvec2", "bvec3", "bvec4",
+        "mat2", "mat3", "mat4", "mat2x2", "mat2x3", "mat2x4",
+        "mat3x2", "mat3x3", "mat3x4", "mat4x2", "mat4x3", "mat4x4"
+    };
+    return types.count(s) != 0;
+}
+
+static bool isQualifier(const std::string &s) {
+    static const std::set<std::string> qualifiers = {
+        "const", "in", "out", "inout", "highp", "mediump", "lowp",
+        "uniform", "flat", "smooth", "invariant", "precise"
+    };
+    return qualifiers.count(s) != 0;
+}
+
+// Scalar type of a vector type, and its number of components
+static std::string scalarOf(const std::string &t) {
+    if (t.compare(0, 3, "vec") == 0 || t.compare(0, 3, "mat") == 0)
+        return "float";
+    if (t.compare(0, 4, "ivec") == 0)
+        return "int";
+    if (t.compare(0, 4, "uvec") == 0)
+        return "uint";
+    if (t.compare(0, 4, "bvec") == 0)
+        return "bool";
+    return t;
+}
+
+static int sizeOf(const std::string &t) {
+    if (t.size() > 3 && t.compare(t.size() - 4, 3, "vec") == 0)
+        return t.back() - '0';
+    return t.compare(0, 3, "mat") == 0 ? 0 : 1;
+}
+
+static std::string vectorOf(const std::string &scalar, int n) {
+    if (n == 1)
+        return scalar;
+    const char *prefix = scalar == "int" ? "ivec" : scalar == "uint" ? "uvec" :
+        scalar == "bool" ? "bvec" : "vec";
+    return prefix + std::to_string(n);
+}
+
+struct Function {
+    std::string name, returnType;
+    std::vector<std::string> params;     // Types with their qualifiers
+    std::vector<std::string> paramTypes; // Types only
+    std::vector<std::string> paramNames;
+    size_t first, body, last; // Indices into File::code
+    size_t textBegin, textEnd; // With the comment before the function
+    std::set<size_t> calls;
+    std::set<std::string> identifiers;
+    std::string normal; // The definition without comments and layout
+};
+
+struct Global {
+    std::set<std::string> names;
+    std::string type, normal;
+    size_t first, textBegin, textEnd;
+};
+
+struct Macro {
+    std::string name, text, value;
+    std::set<std::string> identifiers;
+    std::string type;
+    size_t begin;
+};
+
+struct File {
+    std::string path, text, header;
+    std::vector<Token> code; // Without comments and directives
+    std::vector<Function> functions;
+    std::vector<Global> globals;
+    std::vector<Macro> macros;
+    std::vector<std::string> entries;
+};
+
+// Normal form of some tokens, for comparing definitions
+static std::string joined(const std::vector<Token> &t, size_t a, size_t b) {
+    std::string s;
+    for (size_t k = a; k < b; k++)
+        s += (k > a ? " " : "") + t[k].text;
+    return s;
+}
+
+static bool isBlank(const std::string &s) {
+    for (char ch : s)
+        if (!isspace((unsigned char)ch))
+            return false;
+    return true;
+}
+
+// Splits a file into functions, global declarations and #defines
+static void parse(File &f) {
+    // The header is the first comment of the file, up to a blank line
+    std::vector<Token> all = lex(f.text);
+    size_t previous = 0; // End of the last top level item in the text
+    size_t headerBegin = std::string::npos, headerEnd = 0;
+    int headerLine = 0, depth = 0;
+    bool headerDone = false, seenCode = false;
+    for (size_t k = 0; k < all.size(); k++) {
+        const Token &t = all[k];
+        if (t.kind == COMMENT) {
+            if (!seenCode && !headerDone) {
+                if (headerBegin == std::string::npos)
+                    headerBegin = t.begin;
+                else if (t.line > headerLine + 1)
+                    headerDone = true;
+                if (!headerDone) {
+                    headerEnd = previous = t.end;
+                    headerLine = t.line + (int)std::count(t.text.begin(), t.text.end(), '\n');
+                }
+            }
+            continue;
+        }
+        if (t.kind == DIRECTIVE) {
+            std::vector<Token> d = lex(t.text.substr(1));
+            std::string what = d.empty() ? "" : d[0].text;
+            if (what == "define" && d.size() > 1) {
+                Macro m;
+                m.name = d[1].text;
+                m.text = t.text;
+                m.begin = t.begin;
+                for (size_t v = 2; v < d.size(); v++)
+                    if (d[v].kind != COMMENT) {
+                        m.value += (m.value.empty() ? "" : " ") + d[v].text;
+                        if (d[v].kind == IDENT)
+                            m.identifiers.insert(d[v].text);
+                    }
+                f.macros.push_back(m);
+            } else if (what != "version" && depth == 0) {
+                char line[16];
+                snprintf(line, sizeof(line), "%d", t.line);
+                fail("%s:%s: unsupported directive outside functions: %s",
+                     f.path.c_str(), line, t.text.c_str());
+            }
+            if (!seenCode) {
+                previous = t.end;
+                headerDone = headerBegin != std::string::npos;
+            }
+            continue;
+        }
+        depth += t.text == "{";
+        depth -= t.text == "}";
+        seenCode = true;
+        f.code.push_back(t);
+    }
+    if (headerBegin != std::string::npos)
+        f.header = f.text.substr(headerBegin, headerEnd - headerBegin);
+
+    // Top level items of the code. The comments right before an item are
+    // written out with it.
+    std::vector<Token> &c = f.code;
+    size_t textEnd = previous;
+    for (size_t k = 0; k < c.size();) {
+        size_t first = k;
+        depth = 0;
+        for (; k < c.size(); k++) {
+            if (c[k].text == "(" || c[k].text == "[")
+                depth++;
+            else if (c[k].text == ")" || c[k].text == "]")
+                depth--;
+            else if (depth == 0 && (c[k].text == ";" || c[k].text == "{"))
+                break;
+        }
+        if (k == c.size())
+            fail("%s: unexpected end of file", f.path.c_str());
+        size_t textBegin = textEnd;
+        while (textBegin < c[first].begin && isspace((unsigned char)f.text[textBegin]))
+            textBegin++;
+        std::string before = f.text.substr(textBegin, c[first].begin - textBegin);
+        if (isBlank(before) || before.find("#") != std::string::npos)
+            textBegin = c[first].begin;
+        if (c[k].text == "{" && c[first].text != "struct") {
+            Function fn;
+            fn.first = first;
+            fn.body = k;
+            size_t paren = first;
+            while (paren < k && c[paren].text != "(")
+                paren++;
+            if (paren == first || paren == k) {
+                char line[16];
+                snprintf(line, sizeof(line), "%d", c[first].line);
+                fail("%s:%s: expected a function definition", f.path.c_str(), line);
+            }
+            fn.name = c[paren - 1].text;
+            for (size_t q = first; q + 1 < paren; q++)
+                if (!isQualifier(c[q].text))
+                    fn.returnType += (fn.returnType.empty() ? "" : " ") + c[q].text;
+            size_t a = paren + 1;
+            for (size_t q = paren + 1; q < k; q++) {
+                if (c[q].text != "," && c[q].text != ")")
+                    continue;
+                std::string param, type, name;
+                for (size_t r = a; r < q; r++) {
+                    if (c[r].kind == IDENT && !isQualifier(c[r].text) && !type.empty())
+                        name = c[r].text;
+                    else if (c[r].kind == IDENT && !isQualifier(c[r].text))
+                        type = c[r].text;
+                    if (c[r].kind == IDENT && c[r].text != name)
+                        param += (param.empty() ? "" : " ") + c[r].text;
+                }
+                if (!type.empty() && type != "void") {
+                    fn.params.push_back(param);
+                    fn.paramTypes.push_back(type);
+                    fn.paramNames.push_back(name);
+                }
+                a = q + 1;
+            }
+            depth = 0;
+            for (; k < c.size(); k++) {
+                depth += c[k].text == "{";
+                depth -= c[k].text == "}";
+                if (depth == 0)
+                    break;
+            }
+            if (k == c.size())
+                fail("%s: unbalanced braces in %s()", f.path.c_str(), fn.name.c_str());
+            fn.last = k;
+            fn.textBegin = textBegin;
+            fn.textEnd = textEnd = c[k].end;
+            fn.normal = joined(c, first, k + 1);
+            f.functions.push_back(fn);
+            k++;
+        } else {
+            // A declaration, maybe of a struct: up to its ";"
+            for (depth = 0; k < c.size(); k++) {
+                depth += c[k].text == "{";
+                depth -= c[k].text == "}";
+                if (depth == 0 && c[k].text == ";")
+                    break;
+            }
+            if (k == c.size())
+                fail("%s: unexpected end of file", f.path.c_str());
+            Global g;
+            g.first = first;
+            g.textBegin = textBegin;
+            g.textEnd = textEnd = c[k].end;
+            g.normal = joined(c, first, k + 1);
+            for (size_t q = first; q < k; q++) {
+                if (c[q].kind != IDENT || isQualifier(c[q].text))
+                    continue;
+                if (c[q].text == "struct" && q + 1 < k) {
+                    g.names.insert(c[q + 1].text);
+                    break;
+                }
+                if (isTypeName(c[q].text) && g.type.empty())
+                    g.type = c[q].text;
+                else if (q + 1 < k && q > first &&
+                         (isTypeName(c[q - 1].text) || c[q - 1].text == ",") &&
+                         (c[q + 1].text == "=" || c[q + 1].text == "," ||
+                          c[q + 1].text == "["))
+                    g.names.insert(c[q].text);
+                else if (q + 1 == k && q > first && isTypeName(c[q - 1].text))
+                    g.names.insert(c[q].text);
+            }
+            if (g.names.empty()) {
+                char line[16];
+                snprintf(line, sizeof(line), "%d", c[first].line);
+                fail("%s:%s: unsupported declaration: %s", f.path.c_str(), line,
+                     g.normal.c_str());
+            }
+            f.globals.push_back(g);
+            k++;
+        }
+    }
+}
+
+// Types of GLSL expressions, as far as they are needed to pick the
+// overloads of the functions that are called. An empty string is a type
+// that is not known.
+struct Typer {
+    File &f;
+    std::map<std::string, std::string> &locals;
+    Function *caller;
+    const std::vector<Token> &t;
+    size_t pos, end;
+
+    Typer(File &file, std::map<std::string, std::string> &l, Function *fn,
+          const std::vector<Token> &tokens, size_t a, size_t b)
+        : f(file), locals(l), caller(fn), t(tokens), pos(a), end(b) {}
+
+    bool at(const char *s) const { return pos < end && t[pos].text == s; }
+
+    // Skips to the ")" or "]" that closes the one at pos - 1
+    size_t closing(size_t k) const {
+        int depth = 1;
+        for (; k < end; k++) {
+            if (t[k].text == "(" || t[k].text == "[")
+                depth++;
+            else if (t[k].text == ")" || t[k].text == "]")
+                if (--depth == 0)
+                    break;
+        }
+        return k;
+    }
+
+    std::string sub(size_t a, size_t b) {
+        Typer typer(f, locals, caller, t, a, b);
+        return typer.expression();
+    }
+
+    std::string expression() {
+        if (pos >= end)
+            return "";
+        std::string l = binary(1);
+        if (at("?")) {
+            pos++;
+            std::string a = expression();
+            if (at(":"))
+                pos++;
+            std::string b = expression();
+            return a == b ? a : "";
+        }
+        static const std::set<std::string> assign = {
+            "=", "+=", "-=", "*=", "/=", "%=", "<<=", ">>=", "&=", "|=", "^="
+        };
+        if (pos < end && assign.count(t[pos].text)) {
+            pos++;
+            expression();
+        }
+        return l;
+    }
+
+    static int precedence(const std::string &op) {
+        static const std::map<std::string, int> p = {
+            { "||", 1 }, { "^^", 2 }, { "&&", 3 }, { "|", 4 }, { "^", 5 },
+            { "&", 6 }, { "==", 7 }, { "!=", 7 }, { "<", 8 }, { ">", 8 },
+            { "<=", 8 }, { ">=", 8 }, { "<<", 9 }, { ">>", 9 }, { "+", 10 },
+            { "-", 10 }, { "*", 11 }, { "/", 11 }, { "%", 11 }
+        };
+        auto i = p.find(op);
+        return i == p.end() ? 0 : i->second;
+    }
+
+    // Type of a + b, a * b and so on
+    static std::string combined(const std::string &a, const std::string &b) {
+        if (a.empty() || b.empty())
+            return "";
+        if (a == b)
+            return a;
+        if (sizeOf(a) == 1)
+            return b;
+        if (sizeOf(b) == 1)
+            return a;
+        if (a.compare(0, 3, "mat") == 0 && b.compare(0, 3, "vec") == 0)
+            return b;
+        if (a.compare(0, 3, "vec") == 0 && b.compare(0, 3, "mat") == 0)
+            return a;
+        return "";
+    }
+
+    std::string binary(int minimum) {
+        std::string l = unary();
+        while (pos < end) {
+            int p = precedence(t[pos].text);
+            if (p < minimum || p == 0)
+                break;
+            std::string op = t[pos++].text;
+            std::string r = binary(p + 1);
+            l = p <= 3 || p == 7 || p == 8 ? "bool" : p == 9 ? l : combined(l, r);
+        }
+        return l;
+    }
+
+    std::string unary() {
+        if (at("-") || at("+") || at("~") || at("++") || at("--")) {
+            pos++;
+            return unary();
+        }
+        if (at("!")) {
+            pos++;
+            unary();
+            return "bool";
+        }
+        return postfix(primary());
+    }
+
+    std::string postfix(std::string type) {
+        while (pos < end) {
+            if (at(".") && pos + 1 < end) {
+                const std::string &field = t[pos + 1].text;
+                pos += 2;
+                if (at("(")) { // .length()
+                    pos = closing(pos + 1) + 1;
+                    type = "int";
+                } else if (!type.empty() && field.size() <= 4 && sizeOf(type) > 1)
+                    type = vectorOf(scalarOf(type), (int)field.size());
+                else
+                    type = "";
+            } else if (at("[")) {
+                size_t close = closing(pos + 1);
+                sub(pos + 1, close);
+                pos = close + 1;
+                if (type.size() > 2 && type.compare(type.size() - 2, 2, "[]") == 0)
+                    type.resize(type.size() - 2);
+                else if (type.compare(0, 3, "mat") == 0)
+                    type = "vec" + type.substr(3, 1);
+                else
+                    type = sizeOf(type) > 1 ? scalarOf(type) : "";
+            } else if (at("++") || at("--"))
+                pos++;
+            else
+                break;
+        }
+        return type;
+    }
+
+    std::string primary() {
+        if (pos >= end)
+            return "";
+        const Token &tok = t[pos++];
+        if (tok.text == "(") {
+            size_t close = closing(pos);
+            std::string type = sub(pos, close);
+            pos = close + 1;
+            return type;
+        }
+        if (tok.kind == NUMBER) {
+            const std::string &n = tok.text;
+            bool hex = n.size() > 1 && (n[1] == 'x' || n[1] == 'X');
+            if (n.back() == 'u' || n.back() == 'U')
+                return "uint";
+            if (!hex && n.find_first_of(".eE") != std::string::npos)
+                return "float";
+            return n.back() == 'f' || n.back() == 'F' ? "float" : "int";
+        }
+        if (tok.kind != IDENT)
+            return "";
+        if (tok.text == "true" || tok.text == "false")
+            return "bool";
+        if (at("(")) {
+            size_t close = closing(pos + 1);
+            std::vector<std::string> args;
+            size_t a = pos + 1;
+            int depth = 0;
+            for (size_t k = a; k <= close; k++) {
+                if (t[k].text == "(" || t[k].text == "[")
+                    depth++;
+                else if ((t[k].text == ")" || t[k].text == "]") && k < close)
+                    depth--;
+                else if ((t[k].text == "," && depth == 0) || k == close) {
+                    if (k > a)
+                        args.push_back(sub(a, k));
+                    a = k + 1;
+                }
+            }
+            pos = close + 1;
+            return call(tok.text, args);
+        }
+        auto local = locals.find(tok.text);
+        if (local != locals.end())
+            return local->second;
+        for (const Global &g : f.globals)
+            if (g.names.count(tok.text))
+                return g.type;
+        for (const Macro &m : f.macros)
+            if (m.name == tok.text)
+                return m.type;
+        return "";
+    }
+
+    // Type of a call, with the overloads that it may call added to the
+    // caller's calls
+    std::string call(const std::string &name, const std::vector<std::string> &args) {
+        if (isTypeName(name))
+            return name;
+        std::vector<size_t> candidates, matching;
+        for (size_t k = 0; k < f.functions.size(); k++)
+            if (f.functions[k].name == name && f.functions[k].params.size() == args.size())
+                candidates.push_back(k);
+        if (candidates.empty())
+            for (size_t k = 0; k < f.functions.size(); k++)
+                if (f.functions[k].name == name)
+                    candidates.push_back(k);
+        if (!candidates.empty()) {
+            for (size_t k : candidates) {
+                const Function &fn = f.functions[k];
+                bool match = fn.params.size() == args.size();
+                for (size_t a = 0; match && a < args.size(); a++)
+                    match = args[a].empty() || args[a] == fn.paramTypes[a];
+                if (match)
+                    matching.push_back(k);
+            }
+            if (matching.empty())
+                matching = candidates;
+            std::string type = f.functions[matching[0]].returnType;
+            for (size_t k : matching) {
+                if (caller)
+                    caller->calls.insert(k);
+                if (f.functions[k].returnType != type)
+                    type = "";
+            }
+            return type;
+        }
+        return builtin(name, args);
+    }
+
+    static std::string builtin(const std::string &name, const std::vector<std::string> &args) {
+        static const std::set<std::string> scalar = {
+            "length", "distance", "dot", "determinant"
+        };
+        static const std::set<std::string> same = {
+            "radians", "degrees", "sin", "cos", "tan", "asin", "acos", "atan",
+            "sinh", "cosh", "tanh", "pow", "exp", "log", "exp2", "log2", "sqrt",
+            "inversesqrt", "abs", "sign", "floor", "ceil", "trunc", "round",
+            "roundEven", "fract", "mod", "min", "max", "clamp", "mix", "step",
+            "smoothstep", "normalize", "faceforward", "reflect", "refract",
+            "fma", "dFdx", "dFdy", "fwidth", "transpose", "inverse"
+        };
+        static const std::set<std::string> compare = {
+            "lessThan", "lessThanEqual", "greaterThan", "greaterThanEqual",
+            "equal", "notEqual", "isnan", "isinf"
+        };
+        if (args.empty())
+            return "";
+        if (scalar.count(name))
+            return args[0].empty() ? "" : scalarOf(args[0]);
+        if (name == "cross")
+            return "vec3";
+        if (name == "any" || name == "all")
+            return "bool";
+        if (name == "not")
+            return args[0];
+        if (name.compare(0, 7, "texture") == 0)
+            return "vec4";
+        if (compare.count(name))
+            return args[0].empty() ? "" : vectorOf("bool", sizeOf(args[0]));
+        if (name == "floatBitsToUint" || name == "floatBitsToInt" ||
+            name == "uintBitsToFloat" || name == "intBitsToFloat") {
+            if (args[0].empty())
+                return "";
+            const char *s = name == "floatBitsToUint" ? "uint" :
+                name == "floatBitsToInt" ? "int" : "float";
+            return vectorOf(s, sizeOf(args[0]));
+        }
+        if (same.count(name)) {
+            // The widest argument: step(float, vec3) is a vec3
+            std::string type = args[0];
+            for (const std::string &a : args)
+                type = combined(type, a);
+            return type;
+        }
+        return "";
+    }
+};
+
+// Types of the local variables of a function. A name declared twice
+// with different types gets no type.
+static void declarations(const std::vector<Token> &c, size_t a, size_t b,
+                         std::map<std::string, std::string> &locals) {
+    auto declare = [&](const std::string &name, const std::string &type) {
+        auto i = locals.find(name);
+        if (i == locals.end())
+            locals[name] = type;
+        else if (i->second != type)
+            i->second = "";
+    };
+    for (size_t k = a; k + 1 < b; k++) {
+        if (!isTypeName(c[k].text) || c[k + 1].kind != IDENT)
+            continue;
+        std::string type = c[k].text;
+        if (k + 2 < b && c[k + 2].text == "[")
+            declare(c[k + 1].text, type + "[]");
+        else
+            declare(c[k + 1].text, type);
+        // More names after commas, up to the end of the declaration
+        int depth = 0;
+        for (size_t q = k + 2; q + 1 < b; q++) {
+            if (c[q].text == "(" || c[q].text == "[" || c[q].text == "{")
+                depth++;
+            else if (c[q].text == ")" || c[q].text == "]" || c[q].text == "}")
+                depth--;
+            if (depth < 0 || (depth == 0 && c[q].text == ";"))
+                break;
+            if (depth == 0 && c[q].text == "," && c[q + 1].kind == IDENT &&
+                !isTypeName(c[q + 1].text) && q + 2 < b &&
+                (c[q + 2].text == "=" || c[q + 2].text == "," ||
+                 c[q + 2].text == ";" || c[q + 2].text == "["))
+                declare(c[q + 1].text, type);
+        }
+    }
+}
+
+// Finds the calls and the identifiers of each function
+static void analyse(File &f) {
+    std::map<std::string, std::string> none;
+    for (Macro &m : f.macros) {
+        std::vector<Token> v = lex(m.value);
+        Typer typer(f, none, 0, v, 0, v.size());
+        m.type = typer.expression();
+    }
+    for (Function &fn : f.functions) {
+        std::map<std::string, std::string> locals;
+        for (size_t k = 0; k < fn.params.size(); k++)
+            if (!fn.paramNames[k].empty())
+                locals[fn.paramNames[k]] = fn.paramTypes[k];
+        declarations(f.code, fn.body, fn.last, locals);
+        for (size_t k = fn.body + 1; k < fn.last; k++) {
+            const Token &t = f.code[k];
+            if (t.kind != IDENT)
+                continue;
+            fn.identifiers.insert(t.text);
+            if (f.code[k + 1].text == "(" && (k == 0 || f.code[k - 1].text != ".")) {
+                // The whole call, from the name to its ")"
+                Typer typer(f, locals, &fn, f.code, k, fn.last);
+                typer.primary();
+            }
+        }
+    }
+}
+
+// The macros that a function uses, with the ones that those use
+static std::vector<size_t> macrosUsed(const File &f, const std::set<std::string> &identifiers) {
+    std::set<std::string> names = identifiers;
+    std::vector<size_t> used;
+    for (bool more = true; more;) {
+        more = false;
+        for (size_t k = 0; k < f.macros.size(); k++)
+            if (names.count(f.macros[k].name) &&
+                std::find(used.begin(), used.end(), k) == used.end()) {
+                used.push_back(k);
+                names.insert(f.macros[k].identifiers.begin(), f.macros[k].identifiers.end());
+                more = true;
+            }
+    }
+    std::sort(used.begin(), used.end());
+    return used;
+}
+
+static std::string signature(const Function &fn) {
+    std::string s = fn.name + "(";
+    for (size_t k = 0; k < fn.params.size(); k++)
+        s += (k ? ", " : "") + fn.params[k];
+    return s + ")";
+}
+
+static std::string location(const File &f, size_t token) {
+    return f.path + ":" + std::to_string(f.code[token].line);
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> dirs;
+    std::string output, guard;
+    std::vector<File> files;
+    for (int a = 1; a < argc; a++) {
+        std::string arg = argv[a];
+        if (arg == "-o" && a + 1 < argc) {
+            output = argv[++a];
+        } else if (arg == "-g" && a + 1 < argc) {
+            guard = argv[++a];
+        } else if (arg == "-I" && a + 1 < argc) {
+            dirs.push_back(argv[++a]);
+        } else if (arg.compare(0, 2, "-I") == 0 && arg.size() > 2) {
+            dirs.push_back(arg.substr(2));
+        } else if (arg[0] == '-') {
+            fail("usage: glslcompose [-o output] [-g guard] [-I dir]... file[:name,...]...");
+        } else {
+            File f;
+            size_t colon = arg.find(':');
+            f.path = arg.substr(0, colon);
+            for (size_t k = colon; k != std::string::npos && k < arg.size();) {
+                size_t comma = arg.find(',', k + 1);
+                f.entries.push_back(arg.substr(k + 1, comma == std::string::npos ?
+                                                          std::string::npos : comma - k - 1));
+                k = comma;
+            }
+            files.push_back(f);
+        }
+    }
+    if (files.empty())
+        fail("usage: glslcompose [-o output] [-g guard] [-I dir]... file[:name,...]...");
+
+    for (File &f : files) {
+        FILE *in = fopen(f.path.c_str(), "rb");
+        for (size_t d = 0; !in && d < dirs.size(); d++)
+            in = fopen((dirs[d] + "/" + f.path).c_str(), "rb");
+        if (!in)
+            fail("cannot open %s", f.path.c_str());
+        char buffer[4096];
+        for (size_t n; (n = fread(buffer, 1, sizeof(buffer), in)) > 0;)
+            f.text.append(buffer, n);
+        fclose(in);
+        f.text.erase(std::remove(f.text.begin(), f.text.end(), '\r'), f.text.end());
+        parse(f);
+        analyse(f);
+    }
+
+    // The functions and declarations that the entry points need, by file.
+    // The first definition of each function is the one that is written.
+    struct Definition { size_t file, index; std::string normal; };
+    std::map<std::string, Definition> functions, globals;
+    std::vector<std::vector<bool>> writeFunction(files.size()), writeGlobal(files.size());
+    for (size_t i = 0; i < files.size(); i++) {
+        File &f = files[i];
+        std::vector<bool> needed(f.functions.size(), false);
+        std::vector<size_t> stack;
+        for (size_t k = 0; k < f.functions.size(); k++) {
+            bool entry = f.entries.empty();
+            for (const std::string &e : f.entries)
+                entry = entry || f.functions[k].name == e;
+            if (entry)
+                stack.push_back(k);
+        }
+        for (const std::string &e : f.entries) {
+            bool found = false;
+            for (const Function &fn : f.functions)
+                found = found || fn.name == e;
+            if (!found)
+                fail("%s has no function %s()", f.path.c_str(), e.c_str());
+        }
+        while (!stack.empty()) {
+            size_t k = stack.back();
+            stack.pop_back();
+            if (needed[k])
+                continue;
+            needed[k] = true;
+            stack.insert(stack.end(), f.functions[k].calls.begin(), f.functions[k].calls.end());
+        }
+
+        writeFunction[i].assign(f.functions.size(), false);
+        writeGlobal[i].assign(f.globals.size(), false);
+        for (size_t k = 0; k < f.functions.size(); k++) {
+            if (!needed[k])
+                continue;
+            const Function &fn = f.functions[k];
+            // Two definitions are the same if their code is, and the
+            // macros that they use are defined the same
+            std::string normal = fn.normal;
+            for (size_t m : macrosUsed(f, fn.identifiers))
+                normal += "\n#define " + f.macros[m].name + " " + f.macros[m].value;
+            auto d = functions.find(signature(fn));
+            if (d == functions.end()) {
+                functions[signature(fn)] = { i, k, normal };
+                writeFunction[i][k] = true;
+            } else if (d->second.normal != normal) {
+                const File &other = files[d->second.file];
+                fail("%s is defined differently in %s and %s", signature(fn).c_str(),
+                     location(other, other.functions[d->second.index].first).c_str(),
+                     location(f, fn.first).c_str());
+            }
+            for (size_t g = 0; g < f.globals.size(); g++)
+                for (const std::string &name : f.globals[g].names)
+                    if (fn.identifiers.count(name)) {
+                        auto e = globals.find(name);
+                        if (e == globals.end()) {
+                            globals[name] = { i, g, f.globals[g].normal };
+                            writeGlobal[i][g] = true;
+                        } else if (e->second.normal != f.globals[g].normal) {
+                            const File &other = files[e->second.file];
+                            fail("%s is declared differently in %s and %s", name.c_str(),
+                                 location(other, other.globals[e->second.index].first).c_str(),
+                                 location(f, f.globals[g].first).c_str());
+                        }
+                    }
+        }
+    }
+
+    if (guard.empty()) {
+        std::string base = output.substr(output.find_last_of("/\\") + 1);
+        guard = base.empty() ? "COMPOSED_NOISE_GLSL" : base;
+        for (char &ch : guard)
+            ch = isalnum((unsigned char)ch) ? toupper((unsigned char)ch) : '_';
+        if (isdigit((unsigned char)guard[0]))
+            guard = "_" + guard;
+    }
+
+    FILE *out = output.empty() ? stdout : fopen(output.c_str(), "wb");
+    if (!out)
+        fail("cannot write %s", output.c_str());
+    fprintf(out, "//\n// Composed by glslcompose from");
+    for (const File &f : files) {
+        std::string names;
+        for (const std::string &e : f.entries)
+            names += (names.empty() ? "" : ", ") + e + "()";
+        fprintf(out, "%s %s%s%s%s", &f == &files[0] ? "" : ",", f.path.c_str(),
+                names.empty() ? "" : " (", names.c_str(), names.empty() ? "" : ")");
+    }
+    fprintf(out, "\n//\n\n#ifndef %s\n#define %s\n", guard.c_str(), guard.c_str());
+
+    for (size_t i = 0; i < files.size(); i++) {
+        const File &f = files[i];
+        std::set<std::string> identifiers;
+        bool any = false;
+        for (size_t k = 0; k < f.functions.size(); k++)
+            if (writeFunction[i][k]) {
+                identifiers.insert(f.functions[k].identifiers.begin(),
+                                   f.functions[k].identifiers.end());
+                any = true;
+            }
+        if (!any)
+            continue;
+        if (!f.header.empty())
+            fprintf(out, "\n%s\n", f.header.c_str());
+        // The macros are defined here, unless a function that is written
+        // defines them, and undefined after the functions
+        auto written = [&](const Macro &m) {
+            for (size_t k = 0; k < f.functions.size(); k++)
+                if (writeFunction[i][k] && m.begin > f.functions[k].textBegin &&
+                    m.begin < f.functions[k].textEnd)
+                    return true;
+            return false;
+        };
+        std::vector<std::string> undefine;
+        for (size_t m : macrosUsed(f, identifiers))
+            if (!written(f.macros[m])) {
+                if (undefine.empty())
+                    fprintf(out, "\n");
+                fprintf(out, "%s\n", f.macros[m].text.c_str());
+                undefine.push_back(f.macros[m].name);
+            }
+        for (const Macro &m : f.macros)
+            if (written(m) && std::find(undefine.begin(), undefine.end(), m.name) == undefine.end())
+                undefine.push_back(m.name);
+        // Functions and declarations in the order of the file, which has
+        // everything declared before it is used
+        size_t k = 0, g = 0;
+        while (k < f.functions.size() || g < f.globals.size()) {
+            bool function = g == f.globals.size() ||
+                (k < f.functions.size() && f.functions[k].first < f.globals[g].first);
+            size_t begin, end;
+            bool write;
+            if (function) {
+                begin = f.functions[k].textBegin;
+                end = f.functions[k].textEnd;
+                write = writeFunction[i][k++];
+            } else {
+                begin = f.globals[g].textBegin;
+                end = f.globals[g].textEnd;
+                write = writeGlobal[i][g++];
+            }
+            if (write)
+                fprintf(out, "\n%s\n", f.text.substr(begin, end - begin).c_str());
+        }
+        if (!undefine.empty())
+            fprintf(out, "\n");
+        for (const std::string &name : undefine)
+            fprintf(out, "#undef %s\n", name.c_str());
+    }
+    fprintf(out, "\n#endif\n");
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}